@@ -0,0 +1,269 @@
+/**
+ * @file half_embedding_bench.c
+ * @brief float16 포즈 임베딩 저장의 탐색 속도와 거리 오차 벤치마크
+ * @author Exercise Segment API Team
+ *
+ * 10k / 100k / 1M 개의 합성 임베딩 라이브러리에 대해
+ * 1. float32 선형 탐색(pose_embedding_scan())과 float16 선형 탐색
+ *    (pose_embedding_scan_half()) 시간. 두 탐색은 같은 SIMD 거리 루프를
+ *    쓰므로 차이는 저장 형식(임베딩당 144 / 72바이트)에서만 생깁니다.
+ * 2. 모든 질의/임베딩 쌍의 거리 차이와 pose_embedding_half_error_bound() 비교
+ * 3. float32/float16 VP-tree 인덱스의 1-NN 일치율, 검색 시간, 메모리
+ *    (float32 인덱스는 스칼라 거리를 쓰므로 검색 시간은 참고용)
+ * 를 비교합니다.
+ */
+
+#include "../include/calibration.h"
+#include "../include/pose_index.h"
+#include "../include/segment_api.h"
+#include "../include/segment_memory.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define QUERY_COUNT 32
+#define INDEX_QUERY_COUNT 200
+#define MAX_INDEX_SIZE 100000 // 인덱스 비교는 빌드 시간 때문에 이 크기까지만
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static float random_range(float min, float max) {
+  return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+// 부모 관절을 기준으로 자식 관절을 xy 평면에서 회전
+static void rotate_joint(PoseData *pose, PoseLandmarkType parent,
+                         PoseLandmarkType child, float angle) {
+  Point3D *p = &pose->landmarks[parent].position;
+  Point3D *c = &pose->landmarks[child].position;
+  float dx = c->x - p->x;
+  float dy = c->y - p->y;
+  c->x = p->x + dx * cosf(angle) - dy * sinf(angle);
+  c->y = p->y + dx * sinf(angle) + dy * cosf(angle);
+}
+
+/**
+ * @brief 이상적 기본 포즈에서 팔/다리 각도를 바꿔 합성 키포즈 생성
+ */
+static void make_synthetic_pose(PoseData *pose) {
+  *pose = g_ideal_base_pose;
+
+  rotate_joint(pose, POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_ELBOW,
+               random_range(-2.5f, 0.3f));
+  rotate_joint(pose, POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_WRIST,
+               random_range(-2.5f, 0.3f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_ELBOW,
+               random_range(-0.3f, 2.5f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_WRIST,
+               random_range(-0.3f, 2.5f));
+  rotate_joint(pose, POSE_LANDMARK_LEFT_KNEE, POSE_LANDMARK_LEFT_ANKLE,
+               random_range(-1.2f, 0.0f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_KNEE, POSE_LANDMARK_RIGHT_ANKLE,
+               random_range(0.0f, 1.2f));
+
+  float scale = random_range(0.7f, 1.3f);
+  float offset_x = random_range(-200.0f, 200.0f);
+  float offset_y = random_range(-200.0f, 200.0f);
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    Point3D *p = &pose->landmarks[i].position;
+    p->x = p->x * scale + offset_x;
+    p->y = p->y * scale + offset_y;
+    p->z *= scale;
+  }
+}
+
+static void add_noise(PoseData *pose, float amount) {
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    pose->landmarks[i].position.x += random_range(-amount, amount);
+    pose->landmarks[i].position.y += random_range(-amount, amount);
+  }
+}
+
+static size_t index_live_bytes(void) {
+  SegmentMemoryStats stats;
+  segment_get_memory_stats(SEGMENT_MEMORY_INDEX, &stats);
+  return stats.live_bytes;
+}
+
+// float32/float16 인덱스의 1-NN 일치율, 검색 시간, 메모리 비교
+static void compare_indexes(const float *library, int count,
+                            const PoseData *queries) {
+  PoseIndex *indexes[2] = {NULL, NULL};
+  size_t bytes[2] = {0, 0};
+  double knn_ms[2] = {0.0, 0.0};
+  int ids[2][INDEX_QUERY_COUNT];
+  float distances[2][INDEX_QUERY_COUNT];
+  PoseIndexPrecision precisions[2] = {POSE_INDEX_FLOAT32, POSE_INDEX_FLOAT16};
+
+  for (int p = 0; p < 2; p++) {
+    size_t before = index_live_bytes();
+    if (pose_index_build_from_embeddings_ex(library, count, precisions[p],
+                                            &indexes[p]) != SEGMENT_OK) {
+      printf("❌ 인덱스 생성 실패\n");
+      pose_index_destroy(indexes[0]);
+      return;
+    }
+    bytes[p] = index_live_bytes() - before;
+
+    double start = now_ms();
+    for (int q = 0; q < INDEX_QUERY_COUNT; q++) {
+      PoseIndexMatch match;
+      int match_count = 0;
+      pose_index_knn(indexes[p], &queries[q], 1, &match, &match_count);
+      ids[p][q] = match_count == 1 ? match.pose_id : -1;
+      distances[p][q] = match_count == 1 ? match.distance : 0.0f;
+    }
+    knn_ms[p] = (now_ms() - start) / INDEX_QUERY_COUNT;
+  }
+
+  // 최근접이 다르면 두 거리 차이가 오차 상한 안에 있어야 함 (동률 근처)
+  float bound = pose_index_distance_error_bound(indexes[1]);
+  int agree = 0;
+  int outside_bound = 0;
+  for (int q = 0; q < INDEX_QUERY_COUNT; q++) {
+    agree += ids[0][q] == ids[1][q];
+    outside_bound += fabsf(distances[0][q] - distances[1][q]) > bound;
+  }
+
+  printf("  인덱스: float32 %zu B → float16 %zu B, 1-NN %.4f → %.4f ms/q, "
+         "일치 %.1f%%, 상한 %.2e 초과 %d\n",
+         bytes[0], bytes[1], knn_ms[0], knn_ms[1],
+         100.0 * agree / INDEX_QUERY_COUNT, bound, outside_bound);
+
+  pose_index_destroy(indexes[0]);
+  pose_index_destroy(indexes[1]);
+}
+
+static void run_benchmark(int library_size) {
+  size_t value_count = (size_t)library_size * POSE_EMBEDDING_DIMENSION;
+  float *library = malloc(value_count * sizeof(float));
+  uint16_t *half_library = malloc(value_count * sizeof(uint16_t));
+  float *bounds = malloc((size_t)library_size * sizeof(float));
+  float *float_distances = malloc((size_t)library_size * sizeof(float));
+  float *half_distances = malloc((size_t)library_size * sizeof(float));
+  PoseData *queries = malloc(INDEX_QUERY_COUNT * sizeof(PoseData));
+  float(*query_embeddings)[POSE_EMBEDDING_DIMENSION] =
+      malloc(INDEX_QUERY_COUNT * sizeof(*query_embeddings));
+  if (!library || !half_library || !bounds || !float_distances ||
+      !half_distances || !queries || !query_embeddings) {
+    printf("❌ 메모리 할당 실패\n");
+    goto cleanup;
+  }
+
+  // 포즈를 하나씩 만들어 임베딩만 보관 (1M 포즈 배열은 500MB 이상)
+  for (int i = 0; i < library_size; i++) {
+    PoseData pose;
+    make_synthetic_pose(&pose);
+    pose_embedding_compute(&pose,
+                           &library[(size_t)i * POSE_EMBEDDING_DIMENSION],
+                           NULL);
+    if (i < INDEX_QUERY_COUNT) {
+      queries[i] = pose;
+    }
+  }
+  for (int q = 0; q < INDEX_QUERY_COUNT; q++) {
+    add_noise(&queries[q], 5.0f);
+    pose_embedding_compute(&queries[q], query_embeddings[q], NULL);
+  }
+
+  pose_embedding_to_half(library, half_library, (int)value_count);
+  for (int i = 0; i < library_size; i++) {
+    bounds[i] = pose_embedding_half_error_bound(
+        &half_library[(size_t)i * POSE_EMBEDDING_DIMENSION]);
+  }
+
+  // 1. 선형 탐색 시간
+  int float_best[QUERY_COUNT];
+  int half_best[QUERY_COUNT];
+  double float_start = now_ms();
+  for (int q = 0; q < QUERY_COUNT; q++) {
+    float_best[q] =
+        pose_embedding_scan(library, library_size, query_embeddings[q], NULL);
+  }
+  double float_ms = (now_ms() - float_start) / QUERY_COUNT;
+
+  double half_start = now_ms();
+  for (int q = 0; q < QUERY_COUNT; q++) {
+    half_best[q] = pose_embedding_scan_half(half_library, library_size,
+                                            query_embeddings[q], NULL);
+  }
+  double half_ms = (now_ms() - half_start) / QUERY_COUNT;
+
+  // 2. 모든 쌍의 거리 오차와 상한 비교
+  float max_error = 0.0f;
+  float max_bound = 0.0f;
+  float max_ratio = 0.0f;
+  long long violations = 0;
+  int best_mismatch = 0;
+  for (int q = 0; q < QUERY_COUNT; q++) {
+    pose_embedding_scan(library, library_size, query_embeddings[q],
+                        float_distances);
+    pose_embedding_scan_half(half_library, library_size, query_embeddings[q],
+                             half_distances);
+    for (int i = 0; i < library_size; i++) {
+      float error = fabsf(float_distances[i] - half_distances[i]);
+      max_error = fmaxf(max_error, error);
+      max_bound = fmaxf(max_bound, bounds[i]);
+      max_ratio = fmaxf(max_ratio, error / bounds[i]);
+      // float 연산 반올림 여유 (거리의 몇 ulp)
+      violations += error > bounds[i] + 4e-7f * float_distances[i];
+    }
+    best_mismatch += float_best[q] != half_best[q];
+  }
+
+  printf("%8d | %6.1f → %5.1f MB | %8.3f | %8.3f (x%4.2f) | %.2e | %.2e | "
+         "%4.2f | %lld | %d/%d\n",
+         library_size, value_count * sizeof(float) / 1e6,
+         value_count * sizeof(uint16_t) / 1e6, float_ms, half_ms,
+         float_ms / half_ms, max_error, max_bound, max_ratio, violations,
+         best_mismatch, QUERY_COUNT);
+
+  if (library_size <= MAX_INDEX_SIZE) {
+    compare_indexes(library, library_size, queries);
+  }
+
+cleanup:
+  free(library);
+  free(half_library);
+  free(bounds);
+  free(float_distances);
+  free(half_distances);
+  free(queries);
+  free(query_embeddings);
+}
+
+int main(void) {
+  printf("🧮 float16 포즈 임베딩 벤치마크\n");
+  printf("===============================================\n");
+
+  if (segment_api_init() != SEGMENT_OK) {
+    printf("❌ API 초기화 실패\n");
+    return 1;
+  }
+  srand(42);
+
+  printf("임베딩 수 | 크기 f32 → f16     | f32(ms/q) | f16(ms/q)         | "
+         "최대오차 | 최대상한 | 비율 | 초과 | 최근접 불일치\n");
+  printf("--------------------------------------------------------------------"
+         "----------------------------------------\n");
+
+  int sizes[] = {10000, 100000, 1000000};
+  for (int i = 0; i < 3; i++) {
+    run_benchmark(sizes[i]);
+  }
+
+  printf("\n💡 최대오차: |float32 거리 - float16 거리| 의 최댓값, "
+         "비율: 오차 / 항목별 상한의 최댓값 (1 이하)\n");
+  printf("   최근접 불일치는 거리 차이가 상한 이하인 동률 근처에서만 "
+         "생깁니다\n");
+  printf("   선형 탐색은 같은 SIMD 거리 루프라 속도 차이는 읽는 바이트 "
+         "차이이고, 라이브러리가 캐시보다 클 때만 나타납니다\n");
+
+  segment_api_cleanup();
+  return 0;
+}
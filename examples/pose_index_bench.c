@@ -0,0 +1,189 @@
+/**
+ * @file pose_index_bench.c
+ * @brief 최근접 포즈 인덱스와 선형 탐색 성능 비교 벤치마크
+ * @author Exercise Segment API Team
+ *
+ * 1k / 10k / 100k 개의 합성 키포즈 라이브러리에 대해
+ * segment_calculate_similarity() 선형 탐색과 VP-tree 검색 시간을 비교합니다.
+ */
+
+#include "../include/calibration.h"
+#include "../include/math_utils.h"
+#include "../include/segment_api.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define QUERY_COUNT 200
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static float random_range(float min, float max) {
+  return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+// 부모 관절을 기준으로 자식 관절을 xy 평면에서 회전
+static void rotate_joint(PoseData *pose, PoseLandmarkType parent,
+                         PoseLandmarkType child, float angle) {
+  Point3D *p = &pose->landmarks[parent].position;
+  Point3D *c = &pose->landmarks[child].position;
+  float dx = c->x - p->x;
+  float dy = c->y - p->y;
+  c->x = p->x + dx * cosf(angle) - dy * sinf(angle);
+  c->y = p->y + dx * sinf(angle) + dy * cosf(angle);
+}
+
+/**
+ * @brief 이상적 기본 포즈에서 팔/다리 각도를 바꿔 합성 키포즈 생성
+ */
+static void make_synthetic_pose(PoseData *pose) {
+  *pose = g_ideal_base_pose;
+
+  rotate_joint(pose, POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_ELBOW,
+               random_range(-2.5f, 0.3f));
+  rotate_joint(pose, POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_WRIST,
+               random_range(-2.5f, 0.3f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_ELBOW,
+               random_range(-0.3f, 2.5f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_WRIST,
+               random_range(-0.3f, 2.5f));
+  rotate_joint(pose, POSE_LANDMARK_LEFT_KNEE, POSE_LANDMARK_LEFT_ANKLE,
+               random_range(-1.2f, 0.0f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_KNEE, POSE_LANDMARK_RIGHT_ANKLE,
+               random_range(0.0f, 1.2f));
+
+  float scale = random_range(0.7f, 1.3f);
+  float offset_x = random_range(-200.0f, 200.0f);
+  float offset_y = random_range(-200.0f, 200.0f);
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    Point3D *p = &pose->landmarks[i].position;
+    p->x = p->x * scale + offset_x;
+    p->y = p->y * scale + offset_y;
+    p->z *= scale;
+  }
+}
+
+static void add_noise(PoseData *pose, float amount) {
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    pose->landmarks[i].position.x += random_range(-amount, amount);
+    pose->landmarks[i].position.y += random_range(-amount, amount);
+  }
+}
+
+static void run_benchmark(int library_size) {
+  PoseData *library = malloc((size_t)library_size * sizeof(PoseData));
+  PoseData *queries = malloc(QUERY_COUNT * sizeof(PoseData));
+  if (!library || !queries) {
+    printf("❌ 메모리 할당 실패\n");
+    free(library);
+    free(queries);
+    return;
+  }
+
+  for (int i = 0; i < library_size; i++) {
+    make_synthetic_pose(&library[i]);
+  }
+  for (int i = 0; i < QUERY_COUNT; i++) {
+    queries[i] = library[rand() % library_size];
+    add_noise(&queries[i], 5.0f);
+  }
+
+  double build_start = now_ms();
+  PoseIndex *index = NULL;
+  if (pose_index_build(library, library_size, &index) != SEGMENT_OK) {
+    printf("❌ 인덱스 생성 실패\n");
+    free(library);
+    free(queries);
+    return;
+  }
+  double build_ms = now_ms() - build_start;
+
+  // 1. 기존 방식: segment_calculate_similarity() 선형 탐색
+  int linear_best[QUERY_COUNT];
+  double linear_start = now_ms();
+  for (int q = 0; q < QUERY_COUNT; q++) {
+    float best_similarity = -1.0f;
+    for (int i = 0; i < library_size; i++) {
+      float similarity = segment_calculate_similarity(&queries[q], &library[i]);
+      if (similarity > best_similarity) {
+        best_similarity = similarity;
+        linear_best[q] = i;
+      }
+    }
+  }
+  double linear_ms = (now_ms() - linear_start) / QUERY_COUNT;
+
+  // 2. VP-tree 1-NN / 5-NN
+  PoseIndexMatch matches[5];
+  int match_count = 0;
+  int agree = 0;
+  double knn1_start = now_ms();
+  for (int q = 0; q < QUERY_COUNT; q++) {
+    pose_index_knn(index, &queries[q], 1, matches, &match_count);
+    if (match_count == 1 && matches[0].pose_id == linear_best[q]) {
+      agree++;
+    }
+  }
+  double knn1_ms = (now_ms() - knn1_start) / QUERY_COUNT;
+
+  double knn5_start = now_ms();
+  for (int q = 0; q < QUERY_COUNT; q++) {
+    pose_index_knn(index, &queries[q], 5, matches, &match_count);
+  }
+  double knn5_ms = (now_ms() - knn5_start) / QUERY_COUNT;
+
+  // 3. 저장/로드 왕복
+  const char *index_path = "pose_index_bench.idx";
+  double io_start = now_ms();
+  PoseIndex *loaded = NULL;
+  int io_result = pose_index_save(index, index_path);
+  if (io_result == SEGMENT_OK) {
+    io_result = pose_index_load(index_path, &loaded);
+  }
+  double io_ms = now_ms() - io_start;
+  remove(index_path);
+
+  printf("%8d | %8.1f | %10.3f | %9.4f (x%6.1f) | %9.4f | %5.1f%% | %7.1f %s\n",
+         library_size, build_ms, linear_ms, knn1_ms, linear_ms / knn1_ms,
+         knn5_ms, 100.0f * agree / QUERY_COUNT, io_ms,
+         io_result == SEGMENT_OK ? "" : "(실패)");
+
+  pose_index_destroy(loaded);
+  pose_index_destroy(index);
+  free(library);
+  free(queries);
+}
+
+int main(void) {
+  printf("🔎 최근접 포즈 인덱스 벤치마크\n");
+  printf("===============================================\n");
+
+  if (segment_api_init() != SEGMENT_OK) {
+    printf("❌ API 초기화 실패\n");
+    return 1;
+  }
+  srand(42);
+
+  printf("키포즈 수 | 빌드(ms) | 선형(ms/q) | VP 1-NN(ms/q)      | VP 5-NN   | 일치율 | "
+         "저장+로드(ms)\n");
+  printf("--------------------------------------------------------------------"
+         "------------------\n");
+
+  int sizes[] = {1000, 10000, 100000};
+  for (int i = 0; i < 3; i++) {
+    run_benchmark(sizes[i]);
+  }
+
+  printf("\n💡 일치율: VP-tree 1-NN 결과가 유사도 선형 탐색의 최고 포즈와 같은 "
+         "비율\n");
+  printf("   (인덱스는 몸통 길이로 정규화한 임베딩을 사용하므로 크기가 다른 "
+         "포즈에서 차이가 날 수 있음)\n");
+
+  segment_api_cleanup();
+  return 0;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file quantize_report.c
+ * @brief 키포즈 양자화 저장의 메모리 절감과 정확도 차이 보고
+ * @author Exercise Segment API Team
+ *
+ * 워크아웃마다 float32 캐시와 양자화 캐시(KEYPOSE_STORAGE_QUANTIZED)로
+ * 1. 세그먼트 캐시 메모리 (SEGMENT_MEMORY_SEGMENTS 현재 사용량)
+ * 2. 모든 인접 세그먼트에서 진행도/유사도/완료 여부/목표 포즈 차이
+ * 3. segment_score_against_all() 점수 차이와 최고 인덱스 일치, 처리 시간
+ * 을 비교합니다.
+ *
+ * 사용법: quantize_report [세그먼트 JSON 경로...]
+ *         (기본값 examples/mid.json examples/top.json)
+ */
+
+#include "../include/calibration.h"
+#include "../include/segment_api.h"
+#include "../include/segment_memory.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAME_COUNT 256        // 세그먼트마다 비교하는 합성 프레임 수
+#define SCORE_REPEAT 20000     // segment_score_against_all() 시간 측정 반복
+#define MAX_KEYPOSES 64        // 보고할 워크아웃의 최대 키포즈 수
+#define ANALYSIS_OUTPUTS                                                       \
+  (SEGMENT_OUTPUT_PROGRESS | SEGMENT_OUTPUT_SIMILARITY |                       \
+   SEGMENT_OUTPUT_COMPLETION | SEGMENT_OUTPUT_TARGET_POSE)
+
+// 프레임 하나의 분석 결과
+typedef struct {
+  float progress;
+  float similarity;
+  bool is_complete;
+  PoseData target_pose;
+} FrameResult;
+
+// 저장 방식 하나로 측정한 결과
+typedef struct {
+  size_t cache_bytes;
+  FrameResult *frames;      // (세그먼트 수) x FRAME_COUNT
+  float *scores;            // FRAME_COUNT x 키포즈 수
+  int best_index[FRAME_COUNT];
+  double score_ns;          // segment_score_against_all() 1회 시간
+} StorageRun;
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static float random_range(float min, float max) {
+  return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+// 이상적 기본 포즈를 흔들고 이동한 합성 프레임
+static void make_frame(PoseData *pose) {
+  *pose = g_ideal_base_pose;
+  float offset_x = random_range(-80.0f, 80.0f);
+  float offset_y = random_range(-40.0f, 40.0f);
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    pose->landmarks[i].position.x += offset_x + random_range(-40.0f, 40.0f);
+    pose->landmarks[i].position.y += offset_y + random_range(-40.0f, 40.0f);
+  }
+}
+
+// 현재 저장 방식으로 모든 인접 세그먼트와 전체 키포즈 점수를 측정
+static int measure(const PoseData *frames, int keypose_count,
+                   StorageRun *run) {
+  SegmentMemoryStats stats;
+  segment_get_memory_stats(SEGMENT_MEMORY_SEGMENTS, &stats);
+  run->cache_bytes = stats.live_bytes;
+
+  for (int s = 0; s + 1 < keypose_count; s++) {
+    if (segment_set_current_segment(s, s + 1) != SEGMENT_OK) {
+      return 1;
+    }
+    for (int f = 0; f < FRAME_COUNT; f++) {
+      FrameResult *r = &run->frames[s * FRAME_COUNT + f];
+      segment_analyze_smart_ex(&frames[f], SCALE_MODE_EXERCISE, 1080.0f,
+                               1920.0f, ANALYSIS_OUTPUTS, &r->progress,
+                               &r->similarity, &r->is_complete, NULL,
+                               &r->target_pose);
+    }
+  }
+
+  for (int f = 0; f < FRAME_COUNT; f++) {
+    run->best_index[f] = segment_score_against_all(
+        &frames[f], &run->scores[f * keypose_count]);
+  }
+
+  double start = now_ms();
+  for (int i = 0; i < SCORE_REPEAT; i++) {
+    segment_score_against_all(&frames[i % FRAME_COUNT], NULL);
+  }
+  run->score_ns = (now_ms() - start) * 1e6 / SCORE_REPEAT;
+  return 0;
+}
+
+static void report(const char *json_file, int keypose_count,
+                   const StorageRun *full, const StorageRun *quant) {
+  int segment_count = keypose_count - 1;
+  float max_progress = 0.0f;
+  float max_similarity = 0.0f;
+  float max_target = 0.0f;
+  int completion_mismatch = 0;
+  for (int i = 0; i < segment_count * FRAME_COUNT; i++) {
+    const FrameResult *a = &full->frames[i];
+    const FrameResult *b = &quant->frames[i];
+    max_progress = fmaxf(max_progress, fabsf(a->progress - b->progress));
+    max_similarity =
+        fmaxf(max_similarity, fabsf(a->similarity - b->similarity));
+    completion_mismatch += a->is_complete != b->is_complete;
+    for (int l = 0; l < POSE_LANDMARK_COUNT; l++) {
+      const Point3D *p = &a->target_pose.landmarks[l].position;
+      const Point3D *q = &b->target_pose.landmarks[l].position;
+      max_target = fmaxf(max_target, fabsf(p->x - q->x));
+      max_target = fmaxf(max_target, fabsf(p->y - q->y));
+    }
+  }
+
+  float max_score = 0.0f;
+  int best_mismatch = 0;
+  for (int f = 0; f < FRAME_COUNT; f++) {
+    for (int k = 0; k < keypose_count; k++) {
+      int i = f * keypose_count + k;
+      max_score = fmaxf(max_score, fabsf(full->scores[i] - quant->scores[i]));
+    }
+    best_mismatch += full->best_index[f] != quant->best_index[f];
+  }
+
+  printf("\n📊 %s (키포즈 %d개, 세그먼트 %d개 x 프레임 %d개)\n", json_file,
+         keypose_count, segment_count, FRAME_COUNT);
+  printf("세그먼트 캐시: float32 %zu B → 양자화 %zu B (%.1f%% 절감, "
+         "키포즈당 %.0f B → %.0f B)\n",
+         full->cache_bytes, quant->cache_bytes,
+         100.0 * (1.0 - (double)quant->cache_bytes / full->cache_bytes),
+         (double)full->cache_bytes / keypose_count,
+         (double)quant->cache_bytes / keypose_count);
+  printf("진행도 최대 차이:      %.2e\n", max_progress);
+  printf("유사도 최대 차이:      %.2e\n", max_similarity);
+  printf("완료 여부 불일치:      %d\n", completion_mismatch);
+  printf("목표 포즈 최대 차이:   %.4f px\n", max_target);
+  printf("전체 점수 최대 차이:   %.2e (최고 인덱스 불일치 %d)\n", max_score,
+         best_mismatch);
+  printf("segment_score_against_all(): float32 %.1f ns, 양자화 %.1f ns\n",
+         full->score_ns, quant->score_ns);
+}
+
+static int run_workout(const char *json_file, const PoseData *frames) {
+  if (segment_set_keypose_storage(KEYPOSE_STORAGE_FLOAT32) != SEGMENT_OK ||
+      segment_load_all_segments(json_file) != SEGMENT_OK) {
+    printf("❌ 세그먼트 로드 실패: %s\n", json_file);
+    return 1;
+  }
+
+  int keypose_count = 0;
+  segment_get_segment_info(&keypose_count);
+  if (keypose_count < 2 || keypose_count > MAX_KEYPOSES) {
+    printf("❌ 키포즈 수가 보고 범위를 벗어남: %d\n", keypose_count);
+    return 1;
+  }
+
+  StorageRun runs[2];
+  int result = 0;
+  for (int r = 0; r < 2; r++) {
+    runs[r].frames =
+        malloc((size_t)(keypose_count - 1) * FRAME_COUNT * sizeof(FrameResult));
+    runs[r].scores = malloc((size_t)keypose_count * FRAME_COUNT * sizeof(float));
+    if (!runs[r].frames || !runs[r].scores) {
+      result = 1;
+    }
+  }
+
+  // 같은 캐시를 그대로 양자화해 비교 (로드 경로 차이 배제)
+  if (result == 0) {
+    result = measure(frames, keypose_count, &runs[0]);
+  }
+  if (result == 0 &&
+      segment_set_keypose_storage(KEYPOSE_STORAGE_QUANTIZED) != SEGMENT_OK) {
+    result = 1;
+  }
+  if (result == 0) {
+    result = measure(frames, keypose_count, &runs[1]);
+  }
+  if (result == 0) {
+    report(json_file, keypose_count, &runs[0], &runs[1]);
+  } else {
+    printf("❌ 측정 실패: %s\n", json_file);
+  }
+
+  for (int r = 0; r < 2; r++) {
+    free(runs[r].frames);
+    free(runs[r].scores);
+  }
+  return result;
+}
+
+int main(int argc, char **argv) {
+  static const char *default_files[] = {"examples/mid.json",
+                                        "examples/top.json"};
+  const char **files = argc > 1 ? (const char **)(argv + 1) : default_files;
+  int file_count = argc > 1 ? argc - 1 : 2;
+
+  if (segment_api_init() != SEGMENT_OK ||
+      segment_calibrate_user(&g_ideal_base_pose) != SEGMENT_OK) {
+    printf("❌ API 초기화/캘리브레이션 실패\n");
+    return 1;
+  }
+
+  PoseData *frames = malloc(FRAME_COUNT * sizeof(PoseData));
+  if (!frames) {
+    printf("❌ 메모리 할당 실패\n");
+    segment_api_cleanup();
+    return 1;
+  }
+
+  srand(42);
+  for (int i = 0; i < FRAME_COUNT; i++) {
+    make_frame(&frames[i]);
+  }
+
+  int result = 0;
+  for (int i = 0; i < file_count; i++) {
+    result |= run_workout(files[i], frames);
+  }
+
+  printf("\n🎯 키포즈 양자화 저장 보고 완료\n");
+  free(frames);
+  segment_api_cleanup();
+  return result;
+}
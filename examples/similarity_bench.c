@@ -0,0 +1,280 @@
+/**
+ * @file similarity_bench.c
+ * @brief 관절 각도 유사도와 거리 유사도의 정확도/처리량 비교 벤치마크
+ * @author Exercise Segment API Team
+ *
+ * 1. fast_atan2f()의 최대 오차와 속도를 표준 라이브러리와 비교
+ * 2. 각도 유사도를 정확한 atan2 기준과 비교
+ * 3. 거리 척도와 각도 척도의 포즈 쌍 처리량 비교 (세션 분석처럼 목표
+ *    각도를 미리 계산한 경로와 두 포즈를 모두 계산하는 경로)
+ * 4. 같은 자세를 다른 크기/위치로 찍었을 때 두 척도의 유사도 비교
+ */
+
+#include "../include/calibration.h"
+#include "../include/math_utils.h"
+#include "../include/segment_api.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TRIG_SAMPLES 1000000
+#define PAIR_COUNT 100000
+#define POSE_POOL 1024 // 캐시에 들어가는 포즈 풀 (연산 비용만 측정)
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static float random_range(float min, float max) {
+  return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+// 부모 관절을 기준으로 자식 관절을 xy 평면에서 회전
+static void rotate_joint(PoseData *pose, PoseLandmarkType parent,
+                         PoseLandmarkType child, float angle) {
+  Point3D *p = &pose->landmarks[parent].position;
+  Point3D *c = &pose->landmarks[child].position;
+  float dx = c->x - p->x;
+  float dy = c->y - p->y;
+  c->x = p->x + dx * cosf(angle) - dy * sinf(angle);
+  c->y = p->y + dx * sinf(angle) + dy * cosf(angle);
+}
+
+// 포즈 전체를 크기 변경 후 이동
+static void place_pose(PoseData *pose, float scale, float offset_x,
+                       float offset_y) {
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    Point3D *p = &pose->landmarks[i].position;
+    p->x = p->x * scale + offset_x;
+    p->y = p->y * scale + offset_y;
+    p->z *= scale;
+  }
+}
+
+/**
+ * @brief 이상적 기본 포즈에서 팔/다리 각도를 바꿔 합성 포즈 생성
+ */
+static void make_synthetic_pose(PoseData *pose) {
+  *pose = g_ideal_base_pose;
+
+  rotate_joint(pose, POSE_LANDMARK_LEFT_ELBOW, POSE_LANDMARK_LEFT_WRIST,
+               random_range(-2.0f, 0.5f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_ELBOW, POSE_LANDMARK_RIGHT_WRIST,
+               random_range(-0.5f, 2.0f));
+  rotate_joint(pose, POSE_LANDMARK_LEFT_KNEE, POSE_LANDMARK_LEFT_ANKLE,
+               random_range(-1.2f, 0.0f));
+  rotate_joint(pose, POSE_LANDMARK_RIGHT_KNEE, POSE_LANDMARK_RIGHT_ANKLE,
+               random_range(0.0f, 1.2f));
+}
+
+// 정확한 atan2f로 계산한 기준 각도 유사도
+static float reference_angle_similarity(const PoseData *a, const PoseData *b) {
+  static const JointType triplets[JOINT_ANGLE_COUNT][3] = {
+      {POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_LEFT_KNEE,
+       POSE_LANDMARK_LEFT_ANKLE},
+      {POSE_LANDMARK_RIGHT_HIP, POSE_LANDMARK_RIGHT_KNEE,
+       POSE_LANDMARK_RIGHT_ANKLE},
+      {POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_HIP,
+       POSE_LANDMARK_LEFT_KNEE},
+      {POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_HIP,
+       POSE_LANDMARK_RIGHT_KNEE},
+      {POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_ELBOW,
+       POSE_LANDMARK_LEFT_WRIST},
+      {POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_ELBOW,
+       POSE_LANDMARK_RIGHT_WRIST},
+      {POSE_LANDMARK_LEFT_ELBOW, POSE_LANDMARK_LEFT_SHOULDER,
+       POSE_LANDMARK_LEFT_HIP},
+      {POSE_LANDMARK_RIGHT_ELBOW, POSE_LANDMARK_RIGHT_SHOULDER,
+       POSE_LANDMARK_RIGHT_HIP}};
+
+  const PoseData *poses[2] = {a, b};
+  float angles[2][JOINT_ANGLE_COUNT];
+  for (int p = 0; p < 2; p++) {
+    for (int i = 0; i < JOINT_ANGLE_COUNT; i++) {
+      const Point3D *pa = &poses[p]->landmarks[triplets[i][0]].position;
+      const Point3D *pv = &poses[p]->landmarks[triplets[i][1]].position;
+      const Point3D *pb = &poses[p]->landmarks[triplets[i][2]].position;
+      double ux = pa->x - pv->x, uy = pa->y - pv->y, uz = pa->z - pv->z;
+      double wx = pb->x - pv->x, wy = pb->y - pv->y, wz = pb->z - pv->z;
+      double cx = uy * wz - uz * wy;
+      double cy = uz * wx - ux * wz;
+      double cz = ux * wy - uy * wx;
+      angles[p][i] = (float)atan2(sqrt(cx * cx + cy * cy + cz * cz),
+                                  ux * wx + uy * wy + uz * wz);
+    }
+  }
+
+  float total = 0.0f;
+  for (int i = 0; i < JOINT_ANGLE_COUNT; i++) {
+    total += fabsf(angles[0][i] - angles[1][i]);
+  }
+  return fmaxf(0.0f, 1.0f - (total / JOINT_ANGLE_COUNT) / 1.57079633f);
+}
+
+static void bench_trig(void) {
+  float *xs = malloc(TRIG_SAMPLES * sizeof(float));
+  float *ys = malloc(TRIG_SAMPLES * sizeof(float));
+  float *out = malloc(TRIG_SAMPLES * sizeof(float));
+  if (!xs || !ys || !out) {
+    printf("❌ 메모리 할당 실패\n");
+    free(xs);
+    free(ys);
+    free(out);
+    return;
+  }
+
+  volatile float sink = 0.0f;
+  double start;
+
+  // atan2: 모든 사분면, 다양한 크기
+  float atan2_error = 0.0f;
+  for (int i = 0; i < TRIG_SAMPLES; i++) {
+    float angle = -3.14159265f + 6.2831853f * (float)i / (TRIG_SAMPLES - 1);
+    float radius = random_range(0.01f, 1000.0f);
+    xs[i] = radius * cosf(angle);
+    ys[i] = radius * sinf(angle);
+    float error = fabsf(fast_atan2f(ys[i], xs[i]) - (float)atan2(ys[i], xs[i]));
+    atan2_error = fmaxf(atan2_error, error);
+  }
+
+  start = now_ms();
+  for (int i = 0; i < TRIG_SAMPLES; i++) {
+    out[i] = atan2f(ys[i], xs[i]);
+  }
+  double libm_atan2_ms = now_ms() - start;
+  sink += out[TRIG_SAMPLES / 2];
+
+  start = now_ms();
+  fast_atan2f_batch(ys, xs, out, TRIG_SAMPLES);
+  double fast_atan2_ms = now_ms() - start;
+  sink += out[TRIG_SAMPLES / 2];
+
+  printf("함수   | 최대 오차(rad) | libm(ns/회) | 근사(ns/회) | 속도\n");
+  printf("-------------------------------------------------------------\n");
+  printf("atan2  | %14.2e | %11.2f | %11.2f | x%.1f (일괄)\n", atan2_error,
+         libm_atan2_ms * 1e6 / TRIG_SAMPLES,
+         fast_atan2_ms * 1e6 / TRIG_SAMPLES, libm_atan2_ms / fast_atan2_ms);
+
+  free(xs);
+  free(ys);
+  free(out);
+}
+
+static void bench_metrics(void) {
+  PoseData *currents = malloc(POSE_POOL * sizeof(PoseData));
+  PoseData *targets = malloc(POSE_POOL * sizeof(PoseData));
+  float(*target_angles)[JOINT_ANGLE_COUNT] =
+      malloc(POSE_POOL * sizeof(*target_angles));
+  if (!currents || !targets || !target_angles) {
+    printf("❌ 메모리 할당 실패\n");
+    free(currents);
+    free(targets);
+    free(target_angles);
+    return;
+  }
+
+  for (int i = 0; i < POSE_POOL; i++) {
+    make_synthetic_pose(&currents[i]);
+    make_synthetic_pose(&targets[i]);
+  }
+
+  volatile float sink = 0.0f;
+  double start = now_ms();
+  for (int i = 0; i < PAIR_COUNT; i++) {
+    int k = i % POSE_POOL;
+    sink += segment_calculate_similarity(&currents[k], &targets[k]);
+  }
+  double distance_ms = now_ms() - start;
+
+  // 세션 분석 경로: 목표 각도는 세그먼트 선택 시 한 번만 계산
+  for (int i = 0; i < POSE_POOL; i++) {
+    calculate_joint_angles(&targets[i], target_angles[i]);
+  }
+  start = now_ms();
+  for (int i = 0; i < PAIR_COUNT; i++) {
+    int k = i % POSE_POOL;
+    sink += segment_calculate_angle_similarity_cached(&currents[k],
+                                                      target_angles[k]);
+  }
+  double cached_ms = now_ms() - start;
+
+  start = now_ms();
+  for (int i = 0; i < PAIR_COUNT; i++) {
+    int k = i % POSE_POOL;
+    sink += segment_calculate_angle_similarity(&currents[k], &targets[k]);
+  }
+  double angle_ms = now_ms() - start;
+
+  start = now_ms();
+  for (int i = 0; i < PAIR_COUNT; i++) {
+    int k = i % POSE_POOL;
+    sink += reference_angle_similarity(&currents[k], &targets[k]);
+  }
+  double reference_ms = now_ms() - start;
+
+  float max_error = 0.0f;
+  for (int i = 0; i < POSE_POOL; i++) {
+    float error = fabsf(
+        segment_calculate_angle_similarity_cached(&currents[i],
+                                                  target_angles[i]) -
+        reference_angle_similarity(&currents[i], &targets[i]));
+    max_error = fmaxf(max_error, error);
+  }
+
+  printf("\n척도                 | ns/쌍   | 기준 대비 최대 유사도 오차\n");
+  printf("-------------------------------------------------------------\n");
+  printf("거리 (500px)         | %7.1f | -\n", distance_ms * 1e6 / PAIR_COUNT);
+  printf("각도 (목표 각도 캐시) | %7.1f | %.2e\n",
+         cached_ms * 1e6 / PAIR_COUNT, max_error);
+  printf("각도 (두 포즈 계산)  | %7.1f | %.2e\n", angle_ms * 1e6 / PAIR_COUNT,
+         max_error);
+  printf("각도 (libm atan2)    | %7.1f | 0\n", reference_ms * 1e6 / PAIR_COUNT);
+
+  free(currents);
+  free(targets);
+  free(target_angles);
+}
+
+static void bench_invariance(void) {
+  printf("\n같은 자세를 다른 크기/위치로 비교 (평균 유사도, 1.0이 이상적)\n");
+  printf("크기 배율 | 거리 척도 | 각도 척도\n");
+  printf("------------------------------------\n");
+
+  float scales[] = {0.6f, 0.8f, 1.0f, 1.25f, 1.5f};
+  for (int s = 0; s < 5; s++) {
+    float distance_total = 0.0f;
+    float angle_total = 0.0f;
+    for (int i = 0; i < 1000; i++) {
+      PoseData target;
+      make_synthetic_pose(&target);
+      PoseData current = target;
+      place_pose(&current, scales[s], random_range(-100.0f, 100.0f),
+                 random_range(-100.0f, 100.0f));
+      distance_total += segment_calculate_similarity(&current, &target);
+      angle_total += segment_calculate_angle_similarity(&current, &target);
+    }
+    printf("%9.2f | %9.3f | %9.3f\n", scales[s], distance_total / 1000.0f,
+           angle_total / 1000.0f);
+  }
+}
+
+int main(void) {
+  printf("📐 관절 각도 유사도 벤치마크\n");
+  printf("===============================================\n");
+
+  if (segment_api_init() != SEGMENT_OK) {
+    printf("❌ API 초기화 실패\n");
+    return 1;
+  }
+  srand(42);
+
+  bench_trig();
+  bench_metrics();
+  bench_invariance();
+
+  segment_api_cleanup();
+  return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file smart_mask_bench.c
+ * @brief segment_analyze_smart_ex() 출력 조합별 처리량 벤치마크
+ * @author Exercise Segment API Team
+ *
+ * 1. 출력 조합별 프레임당 분석 시간을 segment_analyze_smart()와 비교
+ * 2. 각 조합의 결과가 전체 분석 결과와 같은지 확인
+ *
+ * 사용법: smart_mask_bench [세그먼트 JSON 경로] (기본값 examples/mid.json)
+ */
+
+#include "../include/calibration.h"
+#include "../include/segment_api.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAME_COUNT 200000
+#define POSE_POOL 256 // 캐시에 들어가는 포즈 풀 (연산 비용만 측정)
+
+typedef struct {
+  const char *name;
+  unsigned int outputs;
+} OutputCombo;
+
+static const OutputCombo g_combos[] = {
+    {"진행도", SEGMENT_OUTPUT_PROGRESS},
+    {"유사도", SEGMENT_OUTPUT_SIMILARITY},
+    {"완료 여부", SEGMENT_OUTPUT_COMPLETION},
+    {"진행도+유사도", SEGMENT_OUTPUT_PROGRESS | SEGMENT_OUTPUT_SIMILARITY},
+    {"진행도+완료", SEGMENT_OUTPUT_PROGRESS | SEGMENT_OUTPUT_COMPLETION},
+    {"교정 벡터", SEGMENT_OUTPUT_CORRECTIONS},
+    {"목표 포즈", SEGMENT_OUTPUT_TARGET_POSE},
+    {"진행도+목표 포즈", SEGMENT_OUTPUT_PROGRESS | SEGMENT_OUTPUT_TARGET_POSE},
+    {"교정+목표 포즈",
+     SEGMENT_OUTPUT_CORRECTIONS | SEGMENT_OUTPUT_TARGET_POSE},
+    {"전체 (ex)", SEGMENT_OUTPUT_ALL},
+};
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static float random_range(float min, float max) {
+  return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+// 이상적 기본 포즈를 흔들고 이동한 합성 프레임
+static void make_frame(PoseData *pose) {
+  *pose = g_ideal_base_pose;
+  float offset_x = random_range(-80.0f, 80.0f);
+  float offset_y = random_range(-40.0f, 40.0f);
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    pose->landmarks[i].position.x += offset_x + random_range(-15.0f, 15.0f);
+    pose->landmarks[i].position.y += offset_y + random_range(-15.0f, 15.0f);
+  }
+}
+
+static void bench_mode(const PoseData *frames, ScaleMode scale_mode,
+                       const char *mode_name) {
+  float progress, similarity;
+  bool is_complete;
+  Point3D corrections[POSE_LANDMARK_COUNT];
+  PoseData target_pose;
+
+  double start = now_ms();
+  for (int i = 0; i < FRAME_COUNT; i++) {
+    segment_analyze_smart(&frames[i % POSE_POOL], scale_mode, 1080.0f,
+                          1920.0f, &progress, &similarity, &is_complete,
+                          corrections, &target_pose);
+  }
+  double full_ns = (now_ms() - start) * 1e6 / FRAME_COUNT;
+
+  printf("\n[%s] segment_analyze_smart(): %.1f ns/프레임\n", mode_name,
+         full_ns);
+  printf("ns/프레임 | 전체 대비 | 결과 일치   | 출력 조합\n");
+  printf("-------------------------------------------------------------\n");
+
+  int combo_count = (int)(sizeof(g_combos) / sizeof(g_combos[0]));
+  for (int c = 0; c < combo_count; c++) {
+    unsigned int outputs = g_combos[c].outputs;
+    float p, s;
+    bool done;
+    Point3D corr[POSE_LANDMARK_COUNT];
+    PoseData target;
+
+    start = now_ms();
+    for (int i = 0; i < FRAME_COUNT; i++) {
+      segment_analyze_smart_ex(&frames[i % POSE_POOL], scale_mode, 1080.0f,
+                               1920.0f, outputs, &p, &s, &done, corr,
+                               &target);
+    }
+    double ns = (now_ms() - start) * 1e6 / FRAME_COUNT;
+
+    // 요청한 출력이 전체 분석 결과와 같은지 확인
+    float max_error = 0.0f;
+    for (int i = 0; i < POSE_POOL; i++) {
+      segment_analyze_smart(&frames[i], scale_mode, 1080.0f, 1920.0f,
+                            &progress, &similarity, &is_complete, corrections,
+                            &target_pose);
+      segment_analyze_smart_ex(&frames[i], scale_mode, 1080.0f, 1920.0f,
+                               outputs, &p, &s, &done, corr, &target);
+      if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+        max_error = fmaxf(max_error, fabsf(p - progress));
+      }
+      if (outputs & SEGMENT_OUTPUT_SIMILARITY) {
+        max_error = fmaxf(max_error, fabsf(s - similarity));
+      }
+      if ((outputs & SEGMENT_OUTPUT_COMPLETION) && done != is_complete) {
+        max_error = fmaxf(max_error, 1.0f);
+      }
+      if ((outputs & SEGMENT_OUTPUT_CORRECTIONS) &&
+          memcmp(corr, corrections, sizeof(corr)) != 0) {
+        max_error = fmaxf(max_error, 1.0f);
+      }
+      if ((outputs & SEGMENT_OUTPUT_TARGET_POSE) &&
+          memcmp(&target, &target_pose, sizeof(target)) != 0) {
+        max_error = fmaxf(max_error, 1.0f);
+      }
+    }
+
+    printf("%9.1f | %8.2fx | %s %.1e | %s\n", ns, full_ns / ns,
+           max_error < 1e-4f ? "✅" : "❌", max_error, g_combos[c].name);
+  }
+}
+
+int main(int argc, char **argv) {
+  const char *json_file = argc > 1 ? argv[1] : "examples/mid.json";
+
+  printf("🎯 segment_analyze_smart_ex() 출력 조합 벤치마크\n");
+  printf("===============================================\n");
+
+  if (segment_api_init() != SEGMENT_OK ||
+      segment_calibrate_user(&g_ideal_base_pose) != SEGMENT_OK) {
+    printf("❌ API 초기화/캘리브레이션 실패\n");
+    return 1;
+  }
+
+  if (segment_load_all_segments(json_file) != SEGMENT_OK ||
+      segment_set_current_segment(0, 1) != SEGMENT_OK) {
+    printf("❌ 세그먼트 로드 실패: %s\n", json_file);
+    segment_api_cleanup();
+    return 1;
+  }
+
+  PoseData *frames = malloc(POSE_POOL * sizeof(PoseData));
+  if (!frames) {
+    printf("❌ 메모리 할당 실패\n");
+    segment_api_cleanup();
+    return 1;
+  }
+
+  srand(42);
+  for (int i = 0; i < POSE_POOL; i++) {
+    make_frame(&frames[i]);
+  }
+
+  bench_mode(frames, SCALE_MODE_EXERCISE, "운동 모드");
+  bench_mode(frames, SCALE_MODE_MEASUREMENT, "측정 모드");
+
+  free(frames);
+  segment_api_cleanup();
+  return 0;
+}
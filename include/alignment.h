@@ -0,0 +1,90 @@
+/**
+ * @file alignment.h
+ * @brief 닫힌 형식 Procrustes(상사 변환) 포즈 정렬
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 두 점 집합 사이의 가중 최소제곱 상사 변환(회전 + 균일 스케일 + 이동)을
+ * Horn의 단위 쿼터니언 방법으로 구합니다. 4x4 대칭 행렬의 최대 고유벡터는
+ * 반복 횟수가 고정된 Jacobi 회전으로 계산하므로 프레임당 연산량이
+ * 관절 수에 대해 선형이고 상한이 있습니다.
+ */
+
+#ifndef ALIGNMENT_H
+#define ALIGNMENT_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 정렬에 필요한 최소 유효 관절 수 */
+#define ALIGNMENT_MIN_POINTS 3
+
+/* 정렬에 사용하는 관절의 최소 신뢰도 */
+#define ALIGNMENT_MIN_CONFIDENCE 0.5f
+
+/* 포즈 정렬에 사용하는 주요 관절 수 */
+#define ALIGNMENT_JOINT_COUNT 12
+
+/**
+ * @brief 상사 변환 (target ≈ scale * rotation * source + translation)
+ */
+typedef struct {
+  float rotation[3][3]; /* 회전 행렬 (행 우선) */
+  float scale;          /* 균일 스케일 */
+  Point3D translation;  /* 이동 */
+  float rms_error;      /* 정렬 후 가중 RMS 잔차 */
+  int point_count;      /* 사용된 점 수 */
+} SimilarityTransform;
+
+/* 포즈 정렬에 사용하는 주요 관절 (어깨, 팔꿈치, 손목, 골반, 무릎, 발목) */
+extern const JointType g_alignment_joints[ALIGNMENT_JOINT_COUNT];
+
+/**
+ * @brief 가중 점 집합 사이의 상사 변환 계산
+ * @param source 원본 점 배열
+ * @param target 목표 점 배열
+ * @param weights 점별 가중치 (NULL이면 모두 1.0, 0 이하는 제외)
+ * @param count 점 개수
+ * @param out_transform 계산된 변환
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 유효한 점이 ALIGNMENT_MIN_POINTS개 미만이거나 원본이 한 점으로 모여
+ * 있으면 SEGMENT_ERROR_INVALID_POSE를 반환합니다.
+ */
+int alignment_solve(const Point3D *source, const Point3D *target,
+                    const float *weights, int count,
+                    SimilarityTransform *out_transform);
+
+/**
+ * @brief 두 포즈의 신뢰도 높은 주요 관절로 상사 변환 계산
+ * @param source 원본 포즈 (예: 목표 키포즈)
+ * @param target 목표 포즈 (예: 현재 사용자 프레임)
+ * @param out_transform source를 target에 맞추는 변환
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * g_alignment_joints 중 두 포즈 모두 신뢰도가 ALIGNMENT_MIN_CONFIDENCE
+ * 이상인 관절만 사용하며, 가중치는 두 신뢰도 중 작은 값입니다.
+ */
+int alignment_solve_poses(const PoseData *source, const PoseData *target,
+                          SimilarityTransform *out_transform);
+
+/**
+ * @brief 포즈 전체에 상사 변환 적용
+ * @param transform 변환
+ * @param input 입력 포즈
+ * @param output 결과 포즈 (input과 같아도 됨)
+ *
+ * 신뢰도와 타임스탬프는 그대로 유지됩니다.
+ */
+void alignment_apply(const SimilarityTransform *transform,
+                     const PoseData *input, PoseData *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALIGNMENT_H
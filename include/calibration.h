@@ -107,16 +107,61 @@ int segment_calibrate_joint_lengths(const PoseData *base_pose,
  * @brief 관절별 길이 켈리브레이션 적용
  * @param original_pose 원본 포즈
  * @param calibration 켈리브레이션 데이터
- * @param calibrated_pose 켈리브레이션된 포즈
+ * @param calibrated_pose 켈리브레이션된 포즈 (original_pose와 같아도 됨)
  * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 골반 중심을 고정하고 뼈 계층(retarget.h)을 따라 각 뼈의 방향은 유지한 채
+ * 길이만 JointLength::scale_factor로 바꿉니다.
  */
 int apply_joint_length_calibration(const PoseData *original_pose,
                                   const CalibrationData *calibration,
                                   PoseData *calibrated_pose);
 
 /**
- * @brief 관절 연결 관계 초기화
- * @return 관절 연결 개수
+ * @brief 여러 포즈(워크아웃 전체)에 관절별 길이 켈리브레이션 적용
+ * @param original_poses 원본 포즈 배열
+ * @param calibration 켈리브레이션 데이터
+ * @param calibrated_poses 결과 포즈 배열 (original_poses와 겹치면 안 됨)
+ * @param count 포즈 개수
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int apply_joint_length_calibration_batch(const PoseData *original_poses,
+                                         const CalibrationData *calibration,
+                                         PoseData *calibrated_poses,
+                                         int count);
+
+/**
+ * @brief 관절 연결 목록 (시작 관절, 끝 관절, 이름)
+ *
+ * X(from, to, name)을 연결마다 펼칩니다. g_joint_connections와 오버레이
+ * 뼈대 인덱스 버퍼가 모두 이 목록에서 컴파일 시점에 만들어지므로 순서가
+ * 어긋나지 않습니다. 항목 수는 JOINT_CONNECTION_COUNT와 같아야 합니다.
+ */
+#define JOINT_CONNECTION_LIST(X)                                               \
+  X(POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_ELBOW, "좌상완")           \
+  X(POSE_LANDMARK_LEFT_ELBOW, POSE_LANDMARK_LEFT_WRIST, "좌전완")              \
+  X(POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_ELBOW, "우상완")         \
+  X(POSE_LANDMARK_RIGHT_ELBOW, POSE_LANDMARK_RIGHT_WRIST, "우전완")            \
+  X(POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_LEFT_KNEE, "좌대퇴")                 \
+  X(POSE_LANDMARK_LEFT_KNEE, POSE_LANDMARK_LEFT_ANKLE, "좌정강")               \
+  X(POSE_LANDMARK_RIGHT_HIP, POSE_LANDMARK_RIGHT_KNEE, "우대퇴")               \
+  X(POSE_LANDMARK_RIGHT_KNEE, POSE_LANDMARK_RIGHT_ANKLE, "우정강")             \
+  X(POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_HIP, "좌상체")             \
+  X(POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_HIP, "우상체")           \
+  X(POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER, "어깨너비")     \
+  X(POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_RIGHT_HIP, "골반너비")               \
+  X(POSE_LANDMARK_NOSE, POSE_LANDMARK_LEFT_SHOULDER, "목-좌어깨")              \
+  X(POSE_LANDMARK_NOSE, POSE_LANDMARK_RIGHT_SHOULDER, "목-우어깨")             \
+  X(POSE_LANDMARK_LEFT_ANKLE, POSE_LANDMARK_LEFT_HEEL, "좌발길이")             \
+  X(POSE_LANDMARK_RIGHT_ANKLE, POSE_LANDMARK_RIGHT_HEEL, "우발길이")           \
+  X(POSE_LANDMARK_LEFT_WRIST, POSE_LANDMARK_LEFT_INDEX, "좌손길이")            \
+  X(POSE_LANDMARK_RIGHT_WRIST, POSE_LANDMARK_RIGHT_INDEX, "우손길이")          \
+  X(POSE_LANDMARK_LEFT_ANKLE, POSE_LANDMARK_LEFT_FOOT_INDEX, "좌발가락")       \
+  X(POSE_LANDMARK_RIGHT_ANKLE, POSE_LANDMARK_RIGHT_FOOT_INDEX, "우발가락")
+
+/**
+ * @brief 관절 연결 개수 반환 (호환용, 테이블은 상수로 초기화됨)
+ * @return 관절 연결 개수 (JOINT_CONNECTION_COUNT)
  */
 int initialize_joint_connections(void);
 
@@ -126,13 +171,129 @@ int initialize_joint_connections(void);
  */
 void print_joint_lengths(const CalibrationData *calibration);
 
+// MARK: - 다중 프레임 캘리브레이션
+
+/* 캘리브레이션 확정에 필요한 최소 유효 프레임 수 */
+#define CALIBRATION_MIN_FRAMES 5
+
+/* 관절 연결 하나를 확정하는 데 필요한 최소 측정 수 */
+#define CALIBRATION_MIN_BONE_SAMPLES 3
+
+/**
+ * @brief P² 분위수 추정기 (Jain & Chlamtac)
+ *
+ * 5개 마커만 유지하여 O(1) 메모리로 스트리밍 분위수를 추정합니다.
+ * quantile이 0.5이면 1번/3번 마커가 근사 1사분위/3사분위가 됩니다.
+ */
+typedef struct {
+  float quantile;      /* 추정할 분위 (0.0~1.0) */
+  int count;           /* 입력된 관측값 수 */
+  float heights[5];    /* 마커 높이 (추정 분위수 값) */
+  float positions[5];  /* 마커 실제 위치 */
+  float desired[5];    /* 마커 목표 위치 */
+  float increments[5]; /* 관측값마다 목표 위치 증가량 */
+} P2QuantileEstimator;
+
+/**
+ * @brief 다중 프레임 캘리브레이션 누적기
+ *
+ * 어깨 너비, 중심점, g_joint_connections의 모든 관절 길이에 대해
+ * 중앙값을 스트리밍으로 추정합니다. 프레임 수와 무관하게 크기가 고정됩니다.
+ */
+typedef struct {
+  P2QuantileEstimator shoulder_width; /* 어깨 너비 */
+  P2QuantileEstimator center_x;       /* 포즈 중심 x */
+  P2QuantileEstimator center_y;       /* 포즈 중심 y */
+  P2QuantileEstimator bone_lengths[JOINT_CONNECTION_COUNT]; /* 연결 순서 */
+  int frames_seen;     /* 입력된 프레임 수 */
+  int frames_accepted; /* 신뢰도 검사를 통과한 프레임 수 */
+} CalibrationAccumulator;
+
+/**
+ * @brief 캘리브레이션 누적기 초기화
+ * @param accumulator 초기화할 누적기
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int calibration_accumulator_init(CalibrationAccumulator *accumulator);
+
+/**
+ * @brief 프레임 하나를 누적
+ * @param accumulator 누적기
+ * @param pose 기본 자세 프레임
+ * @return SEGMENT_OK 누적됨, SEGMENT_ERROR_CALIBRATION_FAILED 프레임 거부됨,
+ *         기타 음수 에러 코드
+ *
+ * 어깨/골반 신뢰도가 낮거나 어깨 너비가 비정상인 프레임은 거부되며
+ * 품질 점수의 수용률에 반영됩니다. 관절 길이는 양 끝 관절의 신뢰도가
+ * 충분할 때만 누적됩니다.
+ */
+int calibration_accumulator_add(CalibrationAccumulator *accumulator,
+                                const PoseData *pose);
+
+/**
+ * @brief 누적된 측정값으로 캘리브레이션 확정
+ * @param accumulator 누적기
+ * @param out_calibration 결과 캘리브레이션 데이터
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 중앙값으로 스케일/중심 오프셋/관절 길이를 계산하고, 수용률(0.5), 관절
+ * 커버리지(0.25), 사분위 범위 기반 안정도(0.25)의 가중 평균으로
+ * calibration_quality를 계산합니다.
+ * 유효 프레임이 CALIBRATION_MIN_FRAMES 미만이면 실패합니다.
+ */
+int calibration_accumulator_finalize(const CalibrationAccumulator *accumulator,
+                                     CalibrationData *out_calibration);
+
+/**
+ * @brief 단일 프레임 캘리브레이션의 품질 점수 계산
+ * @param base_pose 캘리브레이션에 사용한 포즈
+ * @param calibration 관절 길이까지 계산된 캘리브레이션 데이터
+ * @return 품질 점수 (0.0~1.0)
+ *
+ * 핵심 관절 신뢰도(0.5), 관절 길이 커버리지(0.25), 좌우 관절 길이
+ * 대칭성(0.25)의 가중 평균입니다. 비교할 좌우 쌍이 없으면 대칭성은 1.0으로
+ * 봅니다. 신뢰도가 높으면 일부 관절만 측정돼도
+ * segment_validate_calibration()의 0.5 기준을 넘습니다.
+ */
+float calculate_calibration_quality(const PoseData *base_pose,
+                                    const CalibrationData *calibration);
+
+/**
+ * @brief 외부에서 계산한 B(사용자) 캘리브레이션 적용
+ * @param calibration 적용할 캘리브레이션 (calibration_accumulator_finalize() 결과 등)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 이미 로드된 세그먼트는 segment_retransform_cached_segments()로 자동
+ * 재변환되며, 재변환이 실패하면 이전 캘리브레이션이 유지됩니다.
+ */
+int segment_set_user_calibration(const CalibrationData *calibration);
+
+/**
+ * @brief 외부에서 계산한 A(기록자) 캘리브레이션 적용
+ * @param calibration 적용할 캘리브레이션
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int segment_set_recorder_calibration(const CalibrationData *calibration);
+
+/**
+ * @brief 사용자 캘리브레이션 변경 후 캐시된 세그먼트 재변환 (segment_core.c)
+ * @return SEGMENT_OK 성공 (캐시가 없으면 아무것도 하지 않음), 음수 에러 코드
+ *
+ * segment_load_all_segments()가 유지하는 원본 포즈를 새 워크아웃 블록으로
+ * 변환하고, 파생 테이블까지 모두 준비된 뒤 기존 캐시와 교체합니다. 실패하면
+ * 기존 캐시와 선택된 세그먼트는 그대로 유지되고, segment_calibrate_user()와
+ * segment_set_user_calibration()은 이전 캘리브레이션을 복원합니다.
+ * 캐시에 원본 포즈가 없으면 SEGMENT_ERROR_SEGMENT_NOT_CREATED를 반환합니다.
+ */
+int segment_retransform_cached_segments(void);
+
 // 전역 변수 extern 선언
 extern CalibrationData g_recorder_calibration; // A(기록자) 캘리브레이션 데이터
 extern bool g_recorder_calibrated; // A(기록자) 캘리브레이션 완료 플래그
 extern CalibrationData g_user_calibration; // B(사용자) 캘리브레이션 데이터
 extern bool g_user_calibrated; // B(사용자) 캘리브레이션 완료 플래그
 extern PoseData g_ideal_base_pose; // 이상적 기본 포즈
-extern JointConnection g_joint_connections[20]; // 관절 연결 관계
+extern const JointConnection g_joint_connections[JOINT_CONNECTION_COUNT];
 
 #ifdef __cplusplus
 }
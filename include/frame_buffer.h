@@ -0,0 +1,89 @@
+/**
+ * @file frame_buffer.h
+ * @brief 불규칙하게 도착하는 프레임을 위한 지터 버퍼 및 리샘플링
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * ML Kit 프레임은 도착 간격이 일정하지 않고, 검출을 파이프라인으로 처리하면
+ * 순서가 뒤바뀌기도 합니다. 지터 버퍼는 PoseData.timestamp 기준으로 프레임을
+ * 정렬해 보관하다가 고정된 분석 주기의 프레임을 3D 보간으로 만들어 냅니다.
+ */
+
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 지터 버퍼가 보관하는 최대 프레임 수 */
+#define FRAME_JITTER_BUFFER_CAPACITY 16
+
+/* 이 간격(밀리초)보다 긴 공백은 보간하지 않고 다음 프레임으로 건너뜀 */
+#define FRAME_JITTER_MAX_GAP_MS 500
+
+/**
+ * @brief 지터 버퍼 구조체
+ * 호출자가 메모리를 소유하며, frame_jitter_buffer_init()으로 초기화합니다.
+ */
+typedef struct {
+  PoseData frames[FRAME_JITTER_BUFFER_CAPACITY]; /* timestamp 오름차순 */
+  int count;                      /* 보관 중인 프레임 수 */
+  uint64_t interval_us;           /* 출력 주기 (마이크로초) */
+  uint64_t delay_us;              /* 재정렬 대기 시간 (마이크로초) */
+  uint64_t next_output_us;        /* 다음 출력 시각 (마이크로초) */
+  uint64_t newest_timestamp;      /* 지금까지 받은 가장 최신 타임스탬프 */
+  bool has_output;                /* 출력 시각이 정해졌는지 여부 */
+  bool has_emitted;               /* 한 번이라도 출력했는지 여부 */
+  uint64_t last_output_us;        /* 마지막 출력 시각 (마이크로초) */
+  uint64_t dropped_late_frames;   /* 늦게 도착해 버려진 프레임 수 */
+  uint64_t dropped_overflow_frames; /* 버퍼가 가득 차 버려진 프레임 수 */
+  uint64_t emitted_frames;        /* 출력한 리샘플 프레임 수 */
+} FrameJitterBuffer;
+
+/**
+ * @brief 지터 버퍼 초기화
+ * @param buffer 초기화할 버퍼
+ * @param output_rate_hz 출력(분석) 주기 (Hz, 예: 30.0)
+ * @param delay_ms 재정렬을 위해 기다리는 시간 (밀리초)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int frame_jitter_buffer_init(FrameJitterBuffer *buffer, float output_rate_hz,
+                             uint32_t delay_ms);
+
+/**
+ * @brief 지터 버퍼 비우기 (설정과 통계는 유지)
+ * @param buffer 비울 버퍼
+ */
+void frame_jitter_buffer_reset(FrameJitterBuffer *buffer);
+
+/**
+ * @brief 도착한 프레임을 버퍼에 추가
+ * @param buffer 지터 버퍼
+ * @param pose 도착한 포즈 (timestamp 필수)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 이미 출력한 시각 이전의 프레임이나 같은 타임스탬프의 중복 프레임은
+ * 버려지고 dropped_late_frames가 증가합니다. 이 경우도 SEGMENT_OK를 반환합니다.
+ */
+int frame_jitter_buffer_push(FrameJitterBuffer *buffer, const PoseData *pose);
+
+/**
+ * @brief 다음 리샘플 프레임 꺼내기
+ * @param buffer 지터 버퍼
+ * @param out_pose 출력 주기에 맞춰 보간된 포즈
+ * @return true 프레임 출력, false 아직 출력할 프레임 없음
+ *
+ * 한 번의 push 뒤에 여러 프레임이 준비될 수 있으므로 false가 나올 때까지
+ * 반복 호출합니다. 출력 프레임의 timestamp는 출력 시각(밀리초)입니다.
+ */
+bool frame_jitter_buffer_pop(FrameJitterBuffer *buffer, PoseData *out_pose);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_BUFFER_H
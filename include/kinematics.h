@@ -0,0 +1,95 @@
+/**
+ * @file kinematics.h
+ * @brief 관절별 속도/가속도 및 세그먼트 템포 추적
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 연속된 PoseData를 앱에서 직접 차분하지 않아도 되도록, 세션 단위 추적기가
+ * 골반 중심 기준 관절 속도와 가속도를 프레임당 O(1)로 갱신합니다.
+ * 진행도(0→1)를 함께 넘기면 동작 템포(예: 3초 이센트릭)도 측정합니다.
+ * 모든 상태와 출력은 호출자가 제공한 구조체에 저장되며 동적 할당은 없습니다.
+ */
+
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 템포 측정 기본 임계값: 진행도 ~0 / ~1 판정 */
+#define KINEMATICS_TEMPO_LOW 0.05f
+#define KINEMATICS_TEMPO_HIGH 0.95f
+
+/**
+ * @brief 운동학 추적 결과 구조체
+ */
+typedef struct {
+  Point3D velocity[POSE_LANDMARK_COUNT];     /* 골반 기준 속도 (px/s) */
+  Point3D acceleration[POSE_LANDMARK_COUNT]; /* 골반 기준 가속도 (px/s²) */
+  float speed[POSE_LANDMARK_COUNT];          /* 속력 (px/s) */
+  bool velocity_valid;     /* 속도 유효 여부 (2프레임 이상 입력) */
+  bool acceleration_valid; /* 가속도 유효 여부 (3프레임 이상 입력) */
+  float last_tempo_ms;        /* 최근 진행도 0→1 소요 시간 (없으면 0) */
+  float last_return_tempo_ms; /* 최근 진행도 1→0 소요 시간 (없으면 0) */
+  int completed_reps;         /* 0→1 도달 횟수 */
+  bool tempo_updated;         /* 이번 프레임에 템포가 갱신되었는지 */
+} KinematicsOutput;
+
+/**
+ * @brief 운동학 추적기 상태 구조체 (세션별로 하나)
+ */
+typedef struct {
+  float smoothing;  /* 지수 평활 계수 (0.0~1.0, 1.0이면 평활 없음) */
+  float tempo_low;  /* 진행도 ~0 판정 임계값 */
+  float tempo_high; /* 진행도 ~1 판정 임계값 */
+  Point3D previous_relative[POSE_LANDMARK_COUNT]; /* 직전 골반 기준 좌표 */
+  Point3D velocity[POSE_LANDMARK_COUNT];          /* 평활된 속도 */
+  Point3D acceleration[POSE_LANDMARK_COUNT];      /* 평활된 가속도 */
+  uint64_t previous_timestamp; /* 직전 프레임 타임스탬프 (밀리초) */
+  int frame_count;             /* 입력된 프레임 수 (최대 3까지만 증가) */
+  int tempo_phase;         /* 0: 미정, 1: 시작 자세(~0), 2: 종료 자세(~1) */
+  uint64_t low_timestamp;  /* 마지막으로 진행도 ~0이었던 시각 */
+  uint64_t high_timestamp; /* 마지막으로 진행도 ~1이었던 시각 */
+  float last_tempo_ms;
+  float last_return_tempo_ms;
+  int completed_reps;
+} KinematicsTracker;
+
+/**
+ * @brief 운동학 추적기 초기화
+ * @param tracker 초기화할 추적기
+ * @param smoothing 지수 평활 계수 (0.0 초과 1.0 이하, 예: 0.5)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int kinematics_tracker_init(KinematicsTracker *tracker, float smoothing);
+
+/**
+ * @brief 추적 상태 초기화 (설정은 유지)
+ * @param tracker 추적기
+ */
+void kinematics_tracker_reset(KinematicsTracker *tracker);
+
+/**
+ * @brief 새 프레임으로 속도/가속도/템포 갱신
+ * @param tracker 추적기
+ * @param pose 현재 포즈 (timestamp 필수)
+ * @param progress 현재 세그먼트 진행도 (0.0~1.0, 모르면 음수)
+ * @param out 결과를 저장할 구조체
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 유한 차분으로 속도와 가속도를 구하고 지수 평활을 적용합니다.
+ * 직전 프레임보다 타임스탬프가 크지 않은 프레임은 무시되고 현재 상태만
+ * out에 기록됩니다.
+ */
+int kinematics_tracker_update(KinematicsTracker *tracker, const PoseData *pose,
+                              float progress, KinematicsOutput *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // KINEMATICS_H
@@ -72,16 +72,83 @@ Point2D calculate_center_point_selected(const PoseData *pose,
                                         const JointType *joints,
                                         int joint_count);
 
+/**
+ * @brief 골반 중심점 계산 (좌우 골반의 중점)
+ * @param pose 포즈 데이터
+ * @return 골반 중심점 (3D)
+ */
+Point3D calculate_hip_center(const PoseData *pose);
+
+/* 기준점 랜드마크의 최소 신뢰도 */
+#define ANCHOR_MIN_CONFIDENCE 0.3f
+
+/* 기준점 후보 그룹 최대 개수 */
+#define ANCHOR_MAX_GROUPS 3
+
+/**
+ * @brief 기준점 후보 그룹 (좌우 랜드마크 쌍)
+ */
+typedef struct {
+  PoseLandmarkType left;
+  PoseLandmarkType right;
+} AnchorGroup;
+
+/**
+ * @brief 기준점 후보 순서 (앞 그룹부터 시도)
+ */
+typedef struct {
+  int group_count;
+  AnchorGroup groups[ANCHOR_MAX_GROUPS];
+} AnchorLadder;
+
+/**
+ * @brief 기준점 종류와 스케일 모드에 맞는 후보 순서 조회
+ * @param type 기준점 종류 (ANCHOR_TYPE_AUTO면 스케일 모드 기본값)
+ * @param scale_mode 스케일 모드
+ * @return 후보 순서 (상수 테이블), 잘못된 종류면 NULL
+ */
+const AnchorLadder *anchor_ladder_for(AnchorType type, ScaleMode scale_mode);
+
+/**
+ * @brief 후보 순서에 따라 포즈의 기준점 계산
+ * @param pose 포즈 데이터
+ * @param ladder 후보 순서
+ * @param out_point 기준점
+ * @return 기준점을 찾았으면 true
+ *
+ * 그룹마다 좌우 신뢰도 마스크로 가중치(0 또는 1)를 만들어, 양쪽이 보이면
+ * 중점, 한쪽만 보이면 그쪽 위치를 분기 없이 계산합니다. 두 쪽 모두
+ * ANCHOR_MIN_CONFIDENCE 미만이면 다음 그룹을 시도합니다.
+ */
+bool resolve_anchor_point(const PoseData *pose, const AnchorLadder *ladder,
+                          Point3D *out_point);
+
 /**
  * @brief 두 포즈 간 선형 보간
  * @param start 시작 포즈
  * @param end 종료 포즈
  * @param t 보간 계수 (0.0~1.0)
  * @param result 보간 결과를 저장할 포즈
+ *
+ * 종료 포즈의 타임스탬프가 시작보다 이르면 시작 타임스탬프를 유지합니다.
  */
 void interpolate_pose(const PoseData *start, const PoseData *end, float t,
                       PoseData *result);
 
+/**
+ * @brief 두 포즈 간 3D 선형 보간
+ * @param start 시작 포즈
+ * @param end 종료 포즈
+ * @param t 보간 계수 (0.0~1.0)
+ * @param result 보간 결과를 저장할 포즈
+ *
+ * interpolate_pose()와 달리 신뢰도도 t에 따라 선형 보간합니다.
+ * 타임스탬프 기반 리샘플링에 사용합니다. 타임스탬프 처리는
+ * interpolate_pose()와 같습니다.
+ */
+void interpolate_pose_3d(const PoseData *start, const PoseData *end, float t,
+                         PoseData *result);
+
 /**
  * @brief 값을 지정된 범위로 제한
  * @param value 제한할 값
@@ -98,6 +165,26 @@ float clamp(float value, float min, float max);
  */
 float fast_sqrt(float x);
 
+/**
+ * @brief 아크탄젠트2 근사 (분기 없는 다항식)
+ * @param y y 성분
+ * @param x x 성분
+ * @return 라디안 각도 (-π~π), 최대 절대 오차 약 2e-6 rad, (0, 0)이면 0
+ */
+float fast_atan2f(float y, float x);
+
+/**
+ * @brief 여러 값에 대한 아크탄젠트2 근사
+ * @param y y 성분 배열
+ * @param x x 성분 배열
+ * @param out 결과 각도 배열
+ * @param count 개수
+ *
+ * 분기 없는 본체를 인라인하므로 컴파일러가 루프를 SIMD로 벡터화합니다.
+ */
+void fast_atan2f_batch(const float *y, const float *x, float *out,
+                       int count);
+
 /**
  * @brief 포즈를 스케일링
  * @param pose 원본 포즈
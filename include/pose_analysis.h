@@ -23,6 +23,100 @@ extern "C" {
 float segment_calculate_similarity(const PoseData *pose1,
                                    const PoseData *pose2);
 
+/* 각도 유사도에 사용하는 관절 각도 수 (좌우 무릎, 엉덩이, 팔꿈치, 어깨) */
+#define JOINT_ANGLE_COUNT 8
+
+/**
+ * @brief 주요 관절 각도 계산
+ * @param pose 포즈
+ * @param out_angles 관절 각도 (라디안, 0~π) 출력
+ *
+ * 순서는 좌/우 무릎, 좌/우 엉덩이, 좌/우 팔꿈치, 좌/우 어깨입니다.
+ * 각도는 atan2(|u×v|, u·v)를 fast_atan2f_batch()로 근사합니다.
+ */
+void calculate_joint_angles(const PoseData *pose,
+                            float out_angles[JOINT_ANGLE_COUNT]);
+
+/**
+ * @brief 관절 각도 기반 두 포즈 간 유사도 계산
+ * @param pose1 첫 번째 포즈
+ * @param pose2 두 번째 포즈
+ * @return 유사도 (0.0~1.0)
+ *
+ * 평균 각도 차이가 0이면 1.0, 90° 이상이면 0.0입니다. 카메라 거리, 체형,
+ * 화면 위치와 무관하므로 목표 포즈를 사용자 크기로 맞출 필요가 없습니다.
+ * 목표가 고정된 프레임 루프에서는 segment_calculate_angle_similarity_cached()
+ * 를 사용하세요.
+ */
+float segment_calculate_angle_similarity(const PoseData *pose1,
+                                         const PoseData *pose2);
+
+/**
+ * @brief 미리 계산한 목표 관절 각도와의 관절 각도 유사도
+ * @param current_pose 현재 포즈
+ * @param target_angles calculate_joint_angles()로 구한 목표 포즈 각도
+ * @return segment_calculate_angle_similarity()와 같은 척도의 유사도
+ *
+ * 프레임마다 현재 포즈의 각도만 계산합니다 (atan2 8개 일괄 처리).
+ * 관절 각도는 상사 변환에 불변이므로 목표 포즈를 이동/스케일/회전한
+ * 스마트 목표에도 같은 목표 각도를 쓸 수 있습니다.
+ */
+float segment_calculate_angle_similarity_cached(
+    const PoseData *current_pose,
+    const float target_angles[JOINT_ANGLE_COUNT]);
+
+/* 좌우 대칭 랜드마크 순열 (g_mirror_landmarks[i]는 i의 반대쪽 랜드마크) */
+extern const JointType g_mirror_landmarks[POSE_LANDMARK_COUNT];
+
+/**
+ * @brief 포즈 좌우 반전
+ * @param input 입력 포즈
+ * @param output 반전된 포즈 (input과 같아도 됨)
+ *
+ * 좌우 랜드마크를 맞바꾸고 골반 중심을 지나는 세로축 기준으로 x를
+ * 반사합니다. 골반 중심 위치는 그대로입니다.
+ */
+void mirror_pose(const PoseData *input, PoseData *output);
+
+/**
+ * @brief 목표 포즈와 좌우 반전 목표 포즈 중 더 가까운 쪽과의 거리 유사도
+ * @param pose1 현재 포즈
+ * @param pose2 목표 포즈
+ * @param out_mirrored 반전 목표가 더 가까웠는지 여부 (NULL 허용)
+ * @return 두 유사도 중 큰 값 (segment_calculate_similarity()와 같은 척도)
+ *
+ * 골반 기준 상대 좌표를 한 번만 구하고 같은 루프에서 두 거리를 누적합니다.
+ */
+float segment_calculate_similarity_mirrored(const PoseData *pose1,
+                                            const PoseData *pose2,
+                                            bool *out_mirrored);
+
+/**
+ * @brief 좌우 반전을 고려한 관절 각도 유사도
+ * @param pose1 현재 포즈
+ * @param pose2 목표 포즈
+ * @param out_mirrored 반전 목표가 더 가까웠는지 여부 (NULL 허용)
+ * @return 두 유사도 중 큰 값 (segment_calculate_angle_similarity()와 같은 척도)
+ *
+ * 관절 각도는 반사에 불변이므로 좌우 각도 짝만 바꿔 비교합니다.
+ */
+float segment_calculate_angle_similarity_mirrored(const PoseData *pose1,
+                                                  const PoseData *pose2,
+                                                  bool *out_mirrored);
+
+/**
+ * @brief 미리 계산한 목표 관절 각도와의 좌우 반전 고려 관절 각도 유사도
+ * @param current_pose 현재 포즈
+ * @param target_angles calculate_joint_angles()로 구한 목표 포즈 각도
+ * @param out_mirrored 반전 목표가 더 가까웠는지 여부 (NULL 허용)
+ * @return 두 유사도 중 큰 값
+ *
+ * 현재 포즈 각도 한 벌로 원래/반전 목표를 모두 비교합니다.
+ */
+float segment_calculate_angle_similarity_mirrored_cached(
+    const PoseData *current_pose, const float target_angles[JOINT_ANGLE_COUNT],
+    bool *out_mirrored);
+
 /**
  * @brief 포즈 데이터 유효성 검사
  * @param pose 검사할 포즈 데이터
@@ -73,6 +167,80 @@ bool is_segment_completed(const PoseData *current_pose,
                           const JointType *care_joints, int care_joint_count,
                           float similarity_threshold);
 
+/**
+ * @brief 관심 관절 집합 종류
+ *
+ * 자주 쓰는 집합은 전용 루프로 처리합니다.
+ */
+typedef enum {
+  JOINT_SET_CUSTOM = 0,     /* 임의 집합 (인덱스 목록 순회) */
+  JOINT_SET_UPPER_BODY = 1, /* 어깨, 팔꿈치, 손목 */
+  JOINT_SET_LOWER_BODY = 2, /* 골반, 무릎, 발목 */
+  JOINT_SET_MAIN = 3        /* 상체 + 하체 주요 관절 12개 */
+} JointSetKind;
+
+/**
+ * @brief 미리 컴파일된 관심 관절 집합
+ *
+ * 세그먼트 선택 시 한 번 만들어 두고 매 프레임 커널에 넘깁니다.
+ */
+typedef struct {
+  uint64_t mask;                         /* 관절 비트마스크 */
+  int count;                             /* 관절 수 */
+  uint8_t indices[POSE_LANDMARK_COUNT];  /* 오름차순 관절 인덱스 */
+  JointSetKind kind;                     /* 집합 종류 */
+} JointSet;
+
+/**
+ * @brief 관심 관절 배열을 관절 집합으로 컴파일
+ * @param care_joints 관심 관절 배열 (중복 허용)
+ * @param care_joint_count 관심 관절 개수
+ * @param out_set 컴파일된 집합
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 범위를 벗어난 관절이 있거나 배열이 비어 있으면
+ * SEGMENT_ERROR_INVALID_PARAMETER를 반환합니다.
+ */
+int joint_set_compile(const JointType *care_joints, int care_joint_count,
+                      JointSet *out_set);
+
+/**
+ * @brief 관절 집합에 대한 세그먼트 진행도 계산
+ * @param current_pose 현재 포즈
+ * @param start_pose 시작 키포즈
+ * @param end_pose 종료 키포즈
+ * @param joint_set 컴파일된 관심 관절 집합
+ * @return 진행도 (0.0~1.0)
+ */
+float calculate_segment_progress_set(const PoseData *current_pose,
+                                     const PoseData *start_pose,
+                                     const PoseData *end_pose,
+                                     const JointSet *joint_set);
+
+/**
+ * @brief 관절 집합에 대한 교정 벡터 계산
+ * @param current_pose 현재 포즈
+ * @param target_pose 목표 포즈
+ * @param joint_set 컴파일된 관심 관절 집합
+ * @param corrections 교정 벡터 (집합 밖 관절은 0)
+ */
+void calculate_correction_vectors_set(const PoseData *current_pose,
+                                      const PoseData *target_pose,
+                                      const JointSet *joint_set,
+                                      Point3D corrections[POSE_LANDMARK_COUNT]);
+
+/**
+ * @brief 관절 집합에 대한 세그먼트 완료 여부 판단
+ * @param current_pose 현재 포즈
+ * @param end_pose 종료 키포즈
+ * @param joint_set 컴파일된 관심 관절 집합
+ * @param threshold 평균 거리 임계값
+ * @return true 완료, false 미완료
+ */
+bool is_segment_completed_set(const PoseData *current_pose,
+                              const PoseData *end_pose,
+                              const JointSet *joint_set, float threshold);
+
 /**
  * @brief 포즈 정규화 (중심점 맞춤)
  * @param input_pose 입력 포즈
@@ -0,0 +1,158 @@
+/**
+ * @file pose_embedding.h
+ * @brief 정규화된 포즈 임베딩 (골반 중심, 몸통 길이 스케일)
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 주요 12개 관절을 고정된 순서로 골반 중심 기준 상대 좌표로 옮기고 몸통
+ * 길이로 나눈 36차원 벡터입니다. 카메라 위치와 체격 차이가 제거되므로 유사도
+ * 비교, 최근접 검색, 클러스터링을 연속된 float 배열 위에서 수행할 수 있습니다.
+ * 저장 공간을 줄이기 위한 float16 변환도 제공합니다.
+ */
+
+#ifndef POSE_EMBEDDING_H
+#define POSE_EMBEDDING_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 임베딩에 사용하는 관절 수 (어깨, 팔꿈치, 손목, 골반, 무릎, 발목) */
+#define POSE_EMBEDDING_JOINT_COUNT 12
+
+/* 임베딩 차원 (관절 수 x 3, [x0, y0, z0, x1, y1, z1, ...]) */
+#define POSE_EMBEDDING_DIMENSION (POSE_EMBEDDING_JOINT_COUNT * 3)
+
+/* 몸통 길이가 이보다 작으면 스케일 정규화를 생략 */
+#define POSE_EMBEDDING_MIN_TORSO 1e-3f
+
+/* float16 반올림의 최대 상대 오차 (정규화 수, 반 ulp = 2^-11) */
+#define POSE_EMBEDDING_HALF_EPSILON (1.0f / 2048.0f)
+
+/* float16 비정규화 수와 0의 최대 반올림 오차 (2^-25) */
+#define POSE_EMBEDDING_HALF_MIN_ERROR (1.0f / 33554432.0f)
+
+/**
+ * @brief 임베딩 관절 순서 (i번째 관절이 임베딩의 [i*3, i*3+2] 구간)
+ */
+extern const JointType g_pose_embedding_joints[POSE_EMBEDDING_JOINT_COUNT];
+
+/**
+ * @brief 포즈의 정규화 임베딩 계산
+ * @param pose 입력 포즈
+ * @param out_embedding 출력 벡터 (POSE_EMBEDDING_DIMENSION개 float)
+ * @param out_torso_length 정규화에 사용한 몸통 길이 (NULL 허용)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 몸통 길이는 좌/우 어깨-골반 3D 거리의 평균입니다. 몸통 길이가
+ * POSE_EMBEDDING_MIN_TORSO 미만이면 골반 중심 이동만 적용합니다.
+ */
+int pose_embedding_compute(const PoseData *pose, float *out_embedding,
+                           float *out_torso_length);
+
+/**
+ * @brief 여러 포즈의 임베딩을 연속된 배열로 계산
+ * @param poses 포즈 배열
+ * @param count 포즈 개수
+ * @param out_embeddings 출력 배열 (count x POSE_EMBEDDING_DIMENSION)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_embedding_compute_batch(const PoseData *poses, int count,
+                                 float *out_embeddings);
+
+/**
+ * @brief 두 임베딩 사이의 제곱 유클리드 거리
+ */
+float pose_embedding_distance_sq(const float *a, const float *b);
+
+/**
+ * @brief 두 임베딩 사이의 유클리드 거리
+ */
+float pose_embedding_distance(const float *a, const float *b);
+
+/**
+ * @brief float 임베딩 라이브러리 전체를 선형 탐색
+ * @param library 임베딩 배열 (count x POSE_EMBEDDING_DIMENSION)
+ * @param count 임베딩 개수
+ * @param query 질의 임베딩
+ * @param out_distances 임베딩별 거리 (count개, NULL 허용)
+ * @return 가장 가까운 임베딩 인덱스 (0 이상), 음수 에러 코드
+ *
+ * pose_embedding_scan_half()와 같은 SIMD 경로(AVX, ARM NEON, 그 외 스칼라)로
+ * 거리를 계산하므로 두 탐색의 속도 차이는 저장 형식에서만 생깁니다. 거리가
+ * 같으면 앞의 인덱스를 반환합니다.
+ */
+int pose_embedding_scan(const float *library, int count, const float *query,
+                        float *out_distances);
+
+/**
+ * @brief float 배열을 float16(IEEE 754 binary16)으로 변환
+ * @param values 입력 값
+ * @param out_half 출력 값 (반올림: round-to-nearest-even)
+ * @param count 값 개수
+ */
+void pose_embedding_to_half(const float *values, uint16_t *out_half,
+                            int count);
+
+/**
+ * @brief float16 배열을 float로 변환
+ * @param half 입력 값
+ * @param out_values 출력 값
+ * @param count 값 개수
+ */
+void pose_embedding_from_half(const uint16_t *half, float *out_values,
+                              int count);
+
+/**
+ * @brief float 질의와 float16으로 저장된 임베딩 사이의 제곱 거리
+ * @param query 질의 임베딩 (POSE_EMBEDDING_DIMENSION개 float)
+ * @param half 저장된 임베딩 (POSE_EMBEDDING_DIMENSION개 float16)
+ *
+ * float16 → float 변환을 거리 루프 안에서 수행합니다 (x86 F16C, ARM fp16,
+ * 그 외 스칼라). 결과는 pose_embedding_from_half() 후
+ * pose_embedding_distance_sq()를 계산한 것과 합산 순서만 다릅니다.
+ */
+float pose_embedding_distance_sq_half(const float *query,
+                                      const uint16_t *half);
+
+/**
+ * @brief float 질의와 float16으로 저장된 임베딩 사이의 유클리드 거리
+ */
+float pose_embedding_distance_half(const float *query, const uint16_t *half);
+
+/**
+ * @brief float16 임베딩 라이브러리 전체를 선형 탐색
+ * @param library 임베딩 배열 (count x POSE_EMBEDDING_DIMENSION, float16)
+ * @param count 임베딩 개수
+ * @param query 질의 임베딩
+ * @param out_distances 임베딩별 거리 (count개, NULL 허용)
+ * @return 가장 가까운 임베딩 인덱스 (0 이상), 음수 에러 코드
+ *
+ * 임베딩당 72바이트만 읽으므로 pose_embedding_scan()(144바이트)보다 메모리
+ * 대역폭을 절반만 사용합니다. 계산량은 같고 변환 명령만 더해지므로 이득은
+ * 라이브러리가 캐시를 넘어 메모리 대역폭에 묶일 때 나타나며, 캐시 안의 작은
+ * 라이브러리에서는 float 탐색과 비슷하거나 느릴 수 있습니다. 거리가 같으면
+ * 앞의 인덱스를 반환합니다.
+ */
+int pose_embedding_scan_half(const uint16_t *library, int count,
+                             const float *query, float *out_distances);
+
+/**
+ * @brief float16 저장으로 생긴 거리 오차의 상한
+ * @param half 저장된 임베딩 (POSE_EMBEDDING_DIMENSION개 float16)
+ * @return 원래 float 임베딩 b와 저장값 h 사이의 |b - h| 상한
+ *
+ * 삼각 부등식에 의해 임의의 질의 q에 대해
+ * |distance(q, b) - distance_half(q, h)| <= 반환값 입니다 (float 연산 반올림
+ * 제외). 정규화 임베딩(값이 대략 -3~3)에서는 약 |h| * 2^-11, 즉 0.003 이하입니다.
+ */
+float pose_embedding_half_error_bound(const uint16_t *half);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POSE_EMBEDDING_H
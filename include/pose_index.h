@@ -0,0 +1,179 @@
+/**
+ * @file pose_index.h
+ * @brief 대규모 키포즈 라이브러리를 위한 최근접 포즈 검색 인덱스
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 골반 중심 기준으로 정규화한 포즈 임베딩 위에 VP-tree(vantage-point tree)를
+ * 구성하여, 수만 개의 키포즈 중 가장 가까운 포즈를 선형 탐색보다 적은
+ * 거리 계산으로 찾습니다. 인덱스는 한 번 생성한 뒤 파일로 저장/로드할 수
+ * 있습니다.
+ *
+ * 임베딩을 float16으로 저장하면(POSE_INDEX_FLOAT16) 메모리와 파일 크기가
+ * 절반이 되고, 검색 거리는 저장된 float16 임베딩 기준으로 계산됩니다.
+ * 원래 float 임베딩 기준 거리와의 차이는 pose_index_distance_error_bound()
+ * 이하입니다.
+ */
+
+#ifndef POSE_INDEX_H
+#define POSE_INDEX_H
+
+#include "pose_embedding.h"
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 인덱스는 pose_embedding.h의 정규화 임베딩을 그대로 사용 */
+#define POSE_INDEX_JOINT_COUNT POSE_EMBEDDING_JOINT_COUNT
+#define POSE_INDEX_DIMENSION POSE_EMBEDDING_DIMENSION
+
+/**
+ * @brief 인덱스 임베딩 저장 정밀도
+ */
+typedef enum {
+  POSE_INDEX_FLOAT32 = 0, /* float32 임베딩 (기본값, 파일 버전 1) */
+  POSE_INDEX_FLOAT16 = 1  /* float16 임베딩 (절반 크기, 파일 버전 2) */
+} PoseIndexPrecision;
+
+/**
+ * @brief 포즈 인덱스 (불투명 타입)
+ */
+typedef struct PoseIndex PoseIndex;
+
+/**
+ * @brief 검색 결과 구조체
+ */
+typedef struct {
+  int pose_id;    /* 인덱스 생성 시 포즈 배열의 인덱스 */
+  float distance; /* 임베딩 공간에서의 유클리드 거리 */
+} PoseIndexMatch;
+
+/**
+ * @brief 포즈 배열로 인덱스 생성
+ * @param poses 키포즈 배열
+ * @param count 키포즈 개수
+ * @param out_index 생성된 인덱스 (pose_index_destroy()로 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_index_build(const PoseData *poses, int count, PoseIndex **out_index);
+
+/**
+ * @brief 저장 정밀도를 지정해 포즈 배열로 인덱스 생성
+ * @param poses 키포즈 배열
+ * @param count 키포즈 개수
+ * @param precision 임베딩 저장 정밀도
+ * @param out_index 생성된 인덱스 (pose_index_destroy()로 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_index_build_ex(const PoseData *poses, int count,
+                        PoseIndexPrecision precision, PoseIndex **out_index);
+
+/**
+ * @brief 미리 계산된 임베딩 배열로 인덱스 생성
+ * @param embeddings 임베딩 배열 (count x POSE_INDEX_DIMENSION, 복사됨)
+ * @param count 임베딩 개수
+ * @param out_index 생성된 인덱스 (pose_index_destroy()로 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * pose_embedding_compute()로 만든 임베딩을 재사용하여 포즈를 다시 정규화하지
+ * 않고 인덱스를 만듭니다.
+ */
+int pose_index_build_from_embeddings(const float *embeddings, int count,
+                                     PoseIndex **out_index);
+
+/**
+ * @brief 저장 정밀도를 지정해 임베딩 배열로 인덱스 생성
+ * @param embeddings 임베딩 배열 (count x POSE_INDEX_DIMENSION, 복사/변환됨)
+ * @param count 임베딩 개수
+ * @param precision 임베딩 저장 정밀도
+ * @param out_index 생성된 인덱스 (pose_index_destroy()로 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_index_build_from_embeddings_ex(const float *embeddings, int count,
+                                        PoseIndexPrecision precision,
+                                        PoseIndex **out_index);
+
+/**
+ * @brief 인덱스 해제
+ * @param index 해제할 인덱스 (NULL 허용)
+ */
+void pose_index_destroy(PoseIndex *index);
+
+/**
+ * @brief 인덱스에 포함된 포즈 개수
+ * @param index 인덱스
+ * @return 포즈 개수 (index가 NULL이면 0)
+ */
+int pose_index_count(const PoseIndex *index);
+
+/**
+ * @brief 인덱스 임베딩 저장 정밀도
+ * @param index 인덱스
+ * @return 저장 정밀도 (index가 NULL이면 POSE_INDEX_FLOAT32)
+ */
+PoseIndexPrecision pose_index_precision(const PoseIndex *index);
+
+/**
+ * @brief 검색 거리의 float16 저장 오차 상한
+ * @param index 인덱스
+ * @return 원래 float 임베딩 기준 거리와 반환된 거리의 최대 차이
+ *         (float32 인덱스는 0)
+ *
+ * 반경 검색에서 원래 임베딩 기준으로 반경 안의 포즈를 빠짐없이 찾으려면
+ * 반경에 이 값을 더해 검색합니다.
+ */
+float pose_index_distance_error_bound(const PoseIndex *index);
+
+/**
+ * @brief k-최근접 포즈 검색
+ * @param index 인덱스
+ * @param query 검색할 포즈
+ * @param k 찾을 포즈 개수
+ * @param out_matches 결과 배열 (최소 k개, 거리 오름차순으로 채워짐)
+ * @param out_count 실제로 찾은 개수
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_index_knn(const PoseIndex *index, const PoseData *query, int k,
+                   PoseIndexMatch *out_matches, int *out_count);
+
+/**
+ * @brief 반경 내 포즈 검색
+ * @param index 인덱스
+ * @param query 검색할 포즈
+ * @param radius 임베딩 거리 반경
+ * @param out_matches 결과 배열 (거리 오름차순으로 채워짐)
+ * @param max_matches 결과 배열 크기
+ * @param out_count 결과 개수 (max_matches로 잘릴 수 있음)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 반경 내 포즈가 max_matches보다 많으면 가장 가까운 max_matches개만
+ * 반환합니다.
+ */
+int pose_index_radius(const PoseIndex *index, const PoseData *query,
+                      float radius, PoseIndexMatch *out_matches,
+                      int max_matches, int *out_count);
+
+/**
+ * @brief 인덱스를 바이너리 파일로 저장
+ * @param index 저장할 인덱스
+ * @param file_path 파일 경로
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_index_save(const PoseIndex *index, const char *file_path);
+
+/**
+ * @brief 바이너리 파일에서 인덱스 로드
+ * @param file_path 파일 경로
+ * @param out_index 로드된 인덱스 (pose_index_destroy()로 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_index_load(const char *file_path, PoseIndex **out_index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POSE_INDEX_H
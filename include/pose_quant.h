@@ -0,0 +1,100 @@
+/**
+ * @file pose_quant.h
+ * @brief 키포즈 양자화 저장 형식 (int16 좌표 + uint8 신뢰도)
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 캐시된 키포즈는 좌표를 축별 scale/offset 기준 int16으로, 신뢰도를 1/255
+ * 단위 uint8로 저장합니다. scale/offset은 워크아웃(키포즈 묶음)마다 값 범위에
+ * 맞춰 정하므로 좌표 오차는 축 범위의 1/131068 이하입니다 (1920px 범위에서
+ * 약 0.015px). 신뢰도는 반올림하므로 라이브러리가 쓰는 0.1/0.3/0.5 임계값
+ * 비교 결과는 그대로 유지됩니다. 포즈 하나가 536바이트에서 272바이트로
+ * 줄어듭니다.
+ */
+
+#ifndef POSE_QUANT_H
+#define POSE_QUANT_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 양자화 좌표 최대 절댓값 (int16 대칭 범위) */
+#define POSE_QUANT_MAX_CODE 32767
+
+/**
+ * @brief 축별 역양자화 계수 (값 = offset + code * scale)
+ */
+typedef struct {
+  Point3D offset; /* 축 범위의 중앙 */
+  Point3D scale;  /* 코드 1 단위의 크기 */
+} PoseQuantParams;
+
+/**
+ * @brief 양자화된 랜드마크 (8바이트)
+ */
+typedef struct {
+  int16_t x, y, z;    /* 축별 양자화 좌표 */
+  uint8_t confidence; /* 신뢰도 x 255 (반올림) */
+  uint8_t reserved;   /* 정렬용 (0) */
+} QuantizedLandmark;
+
+/**
+ * @brief 양자화된 포즈 (272바이트)
+ */
+typedef struct {
+  QuantizedLandmark landmarks[POSE_LANDMARK_COUNT];
+  uint64_t timestamp;
+} QuantizedPose;
+
+/**
+ * @brief 축별 최솟값/최댓값으로 양자화 계수 계산
+ * @param min_value 축별 최솟값
+ * @param max_value 축별 최댓값
+ * @param out_params 출력 계수
+ */
+void pose_quant_params_from_bounds(const Point3D *min_value,
+                                   const Point3D *max_value,
+                                   PoseQuantParams *out_params);
+
+/**
+ * @brief 포즈 배열 전체 좌표 범위에 맞는 양자화 계수 계산
+ * @param poses 포즈 배열
+ * @param count 포즈 개수
+ * @param out_params 출력 계수
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int pose_quant_params_compute(const PoseData *poses, int count,
+                              PoseQuantParams *out_params);
+
+/**
+ * @brief 값 하나를 양자화 코드로 변환 (범위 밖은 잘라냄)
+ */
+int16_t pose_quant_encode(float value, float offset, float scale);
+
+/**
+ * @brief 포즈 양자화
+ * @param pose 원본 포즈
+ * @param params 양자화 계수
+ * @param out_pose 양자화된 포즈
+ */
+void pose_quantize(const PoseData *pose, const PoseQuantParams *params,
+                   QuantizedPose *out_pose);
+
+/**
+ * @brief 양자화된 포즈 복원
+ * @param pose 양자화된 포즈
+ * @param params 양자화 계수
+ * @param out_pose 복원된 포즈
+ */
+void pose_dequantize(const QuantizedPose *pose, const PoseQuantParams *params,
+                     PoseData *out_pose);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POSE_QUANT_H
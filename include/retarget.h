@@ -0,0 +1,123 @@
+/**
+ * @file retarget.h
+ * @brief 뼈대 계층 기반 관절 길이 리타게팅
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 골반 중심을 루트로 하는 33개 뼈(랜드마크마다 하나)의 계층을 위상 순서로
+ * 한 번 순회하면서, 부모→자식 방향은 유지하고 뼈 길이만 관절별 스케일로
+ * 바꿉니다. 스케일은 CalibrationData의 관절 길이 측정값에서 가져옵니다.
+ */
+
+#ifndef RETARGET_H
+#define RETARGET_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 뼈 개수 (루트를 제외한 모든 랜드마크가 자식 관절) */
+#define RETARGET_BONE_COUNT POSE_LANDMARK_COUNT
+
+/* 부모가 루트(골반 중심)임을 나타내는 값 */
+#define RETARGET_ROOT (-1)
+
+/**
+ * @brief 뼈 하나 (부모 관절 → 자식 관절)
+ */
+typedef struct {
+  int parent;           /* 부모 랜드마크 (RETARGET_ROOT이면 골반 중심) */
+  int child;            /* 자식 랜드마크 */
+  int connection_index; /* 스케일 출처 g_joint_connections 인덱스
+                           (-1이면 부모 뼈 스케일 상속) */
+} RetargetBone;
+
+/**
+ * @brief 스케일이 결정된 리타게팅 뼈대
+ *
+ * bones는 부모가 항상 먼저 오는 위상 순서입니다. 루트(골반 중심)는
+ * root * root_position_scale + root_offset 위치로 옮겨집니다.
+ * 모든 뼈 스케일이 root_position_scale과 같으면(uniform) 계층을 따라가지
+ * 않고 랜드마크마다 position * scale + offset으로 바로 변환합니다.
+ */
+typedef struct {
+  RetargetBone bones[RETARGET_BONE_COUNT];
+  float scales[RETARGET_BONE_COUNT]; /* 뼈별 길이 스케일 */
+  float root_position_scale;         /* 루트 위치 스케일 (기본 1.0) */
+  Point3D root_offset;               /* 루트 위치 이동 (기본 0) */
+  bool uniform;                      /* 모든 뼈 스케일이 루트 위치 스케일과 같음 */
+} RetargetSkeleton;
+
+/**
+ * @brief 캘리브레이션 데이터로 뼈대 스케일 결정
+ * @param skeleton 출력 뼈대
+ * @param calibration 관절 길이 캘리브레이션 (NULL이면 모든 스케일 1.0)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 각 JointLength는 connection_index로 뼈에 연결됩니다. 측정되지 않은 뼈는
+ * 부모 뼈의 스케일을 상속하며, 루트 바로 아래 뼈의 기본값은 1.0입니다.
+ */
+int retarget_skeleton_init(RetargetSkeleton *skeleton,
+                           const CalibrationData *calibration);
+
+/**
+ * @brief 측정되지 않은 루트 뼈의 기본 스케일을 지정하여 뼈대 스케일 결정
+ * @param skeleton 출력 뼈대
+ * @param calibration 관절 길이 캘리브레이션 (NULL 허용)
+ * @param root_scale 측정값이 없는 루트 바로 아래 뼈의 스케일
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * retarget_skeleton_init()은 root_scale 1.0으로 이 함수를 호출합니다.
+ */
+int retarget_skeleton_init_scaled(RetargetSkeleton *skeleton,
+                                  const CalibrationData *calibration,
+                                  float root_scale);
+
+/**
+ * @brief 균일 스케일 + 이동 뼈대 (apply_calibration_to_pose()와 같은 변환)
+ * @param skeleton 출력 뼈대
+ * @param scale 모든 뼈와 루트 위치의 스케일
+ * @param offset 루트 위치 이동
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 모든 랜드마크가 position * scale + offset으로 옮겨집니다.
+ */
+int retarget_skeleton_init_uniform(RetargetSkeleton *skeleton, float scale,
+                                   const Point3D *offset);
+
+/**
+ * @brief 포즈 하나를 리타게팅
+ * @param skeleton 뼈대
+ * @param input 원본 포즈
+ * @param output 결과 포즈 (input과 같아도 됨)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 골반 중심은 제자리에 두고, 뼈 방향을 유지한 채 길이만 스케일합니다.
+ * 신뢰도와 타임스탬프는 그대로 복사됩니다.
+ */
+int retarget_pose(const RetargetSkeleton *skeleton, const PoseData *input,
+                  PoseData *output);
+
+/**
+ * @brief 여러 포즈를 한 번에 리타게팅
+ * @param skeleton 뼈대
+ * @param inputs 원본 포즈 배열
+ * @param outputs 결과 포즈 배열 (inputs와 겹치면 안 됨)
+ * @param count 포즈 개수
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 포즈를 바깥 루프, 뼈를 안쪽 루프로 순회하여 포즈 하나가 캐시에 있는
+ * 동안 모든 뼈를 처리합니다. 워크아웃 전체를 사용자 체형으로 바꿀 때
+ * 사용합니다.
+ */
+int retarget_poses(const RetargetSkeleton *skeleton, const PoseData *inputs,
+                   PoseData *outputs, int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RETARGET_H
@@ -0,0 +1,134 @@
+/**
+ * @file score_kernel.h
+ * @brief 한 프레임을 모든 키포즈와 한 번에 비교하는 SIMD 점수 커널
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 키포즈를 8개씩 묶어 관절/축별로 레인을 나란히 둔 블록 SoA 배치로
+ * 저장합니다. 프레임 하나를 점수화할 때 각 키포즈 데이터는 정확히 한 번만
+ * 읽히며, 8개 키포즈의 거리를 SIMD 레인에서 동시에 계산합니다.
+ * 점수는 segment_calculate_similarity()와 같은 척도입니다.
+ */
+
+#ifndef SCORE_KERNEL_H
+#define SCORE_KERNEL_H
+
+#include "pose_quant.h"
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 한 블록에 묶는 키포즈 수 (SIMD 레인 수) */
+#define SCORE_BLOCK_LANES 8
+
+/* 점수 계산에 사용하는 관절 수 (segment_calculate_similarity()와 동일) */
+#define SCORE_JOINT_COUNT 10
+
+/* 블록 하나의 float 개수 (관절 x 축 x 레인) */
+#define SCORE_BLOCK_FLOATS (SCORE_JOINT_COUNT * 3 * SCORE_BLOCK_LANES)
+
+/**
+ * @brief 블록 SoA 키포즈 테이블
+ *
+ * data[b * SCORE_BLOCK_FLOATS + (joint * 3 + axis) * SCORE_BLOCK_LANES + lane]
+ * 는 (b * SCORE_BLOCK_LANES + lane)번째 키포즈의 골반 기준 상대 좌표입니다.
+ */
+typedef struct {
+  int pose_count;  /* 키포즈 수 */
+  int block_count; /* 블록 수 (마지막 블록은 남는 레인을 0으로 채움) */
+  float *data;     /* block_count x SCORE_BLOCK_FLOATS */
+} ScoreBlockTable;
+
+/**
+ * @brief 키포즈 배열로 블록 테이블 생성
+ * @param poses 키포즈 배열
+ * @param count 키포즈 개수
+ * @param table 출력 테이블 (score_table_free()로 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int score_table_build(const PoseData *poses, int count,
+                      ScoreBlockTable *table);
+
+/**
+ * @brief 키포즈 count개의 블록 테이블에 필요한 저장 공간 (바이트)
+ */
+size_t score_table_storage_size(int count);
+
+/**
+ * @brief 호출자가 제공한 저장 공간에 블록 테이블 생성
+ * @param poses 키포즈 배열
+ * @param count 키포즈 개수
+ * @param storage score_table_storage_size(count) 바이트 이상의 공간
+ * @param table 출력 테이블 (저장 공간은 호출자 소유, score_table_free() 금지)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int score_table_build_into(const PoseData *poses, int count, float *storage,
+                           ScoreBlockTable *table);
+
+/**
+ * @brief 블록 테이블 해제
+ * @param table 해제할 테이블 (NULL 허용)
+ */
+void score_table_free(ScoreBlockTable *table);
+
+/**
+ * @brief 프레임 하나를 테이블의 모든 키포즈와 비교
+ * @param table 블록 테이블
+ * @param frame 현재 프레임
+ * @param out_scores 키포즈별 유사도 (0.0~1.0, pose_count개, NULL 허용)
+ * @return 가장 유사한 키포즈 인덱스 (0 이상), 음수 에러 코드
+ *
+ * 유사도가 같은 키포즈가 여럿이면 가장 앞의 인덱스를 반환합니다.
+ */
+int score_table_score(const ScoreBlockTable *table, const PoseData *frame,
+                      float *out_scores);
+
+/**
+ * @brief int16 양자화 블록 SoA 키포즈 테이블
+ *
+ * 배치는 ScoreBlockTable과 같고, 좌표는 params로 역양자화합니다.
+ * 점수 계산 시 레인을 읽는 즉시 SIMD로 float 변환하므로 별도 복원 단계가
+ * 없으며, 키포즈당 읽는 양이 절반(60바이트)입니다.
+ */
+typedef struct {
+  int pose_count;         /* 키포즈 수 */
+  int block_count;        /* 블록 수 */
+  PoseQuantParams params; /* 상대 좌표 계수 (offset은 축별, scale은 공통) */
+  int16_t *data;          /* block_count x SCORE_BLOCK_FLOATS */
+} QuantizedScoreTable;
+
+/**
+ * @brief 키포즈 count개의 양자화 블록 테이블에 필요한 저장 공간 (바이트)
+ */
+size_t score_table_quantized_storage_size(int count);
+
+/**
+ * @brief float 블록 테이블을 호출자 저장 공간에 양자화
+ * @param source 원본 블록 테이블
+ * @param storage score_table_quantized_storage_size() 바이트 이상의 공간
+ * @param table 출력 테이블 (저장 공간은 호출자 소유)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int score_table_quantize_into(const ScoreBlockTable *source, int16_t *storage,
+                              QuantizedScoreTable *table);
+
+/**
+ * @brief 프레임 하나를 양자화 테이블의 모든 키포즈와 비교
+ * @param table 양자화 블록 테이블
+ * @param frame 현재 프레임
+ * @param out_scores 키포즈별 유사도 (0.0~1.0, pose_count개, NULL 허용)
+ * @return 가장 유사한 키포즈 인덱스 (0 이상), 음수 에러 코드
+ *
+ * score_table_score()와 같은 척도이며, 좌표 양자화 오차만큼만 다릅니다.
+ */
+int score_table_score_quantized(const QuantizedScoreTable *table,
+                                const PoseData *frame, float *out_scores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCORE_KERNEL_H
@@ -15,6 +15,7 @@
 
 #include "segment_types.h"
 #include "pose_analysis.h"
+#include "pose_index.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -89,6 +90,8 @@ int segment_finalize_workout_json(const char *workout_name,
  *
  * B의 포즈를 API 내부 이상적 기본 포즈와 비교하여 신체 비율 차이를 계산하고,
  * 내부에 저장합니다. 이후 B가 사용하는 모든 포즈가 B의 체형에 맞게 변환됩니다.
+ * 이미 segment_load_all_segments()로 로드된 세그먼트는 JSON을 다시 읽지 않고
+ * 메모리에 유지된 원본 포즈에서 재변환되며, 선택된 세그먼트도 갱신됩니다.
  */
 int segment_calibrate_user(const PoseData *base_pose);
 
@@ -168,6 +171,51 @@ int segment_create_pose_data(const PoseLandmark *landmarks, PoseData *out_pose);
  */
 int segment_load_all_segments(const char *json_file_path);
 
+/**
+ * @brief 세그먼트 캐시의 키포즈 저장 방식 설정
+ * @param storage 저장 방식 (기본값 KEYPOSE_STORAGE_FLOAT32)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * KEYPOSE_STORAGE_QUANTIZED는 키포즈를 워크아웃별 축 scale/offset 기준
+ * int16 좌표와 uint8 신뢰도로, 전체 키포즈 점수 테이블을 int16으로 보관해
+ * 캐시 크기를 약 절반으로 줄입니다. segment_score_against_all()은 양자화
+ * 테이블을 읽으면서 바로 역양자화하고, 선택된 세그먼트의 시작/종료 포즈는
+ * segment_set_current_segment()에서 한 번 복원되므로 프레임 분석 비용은
+ * 같습니다. 좌표 오차는 축 범위의 1/131068 이하입니다. 점수 테이블이 캐시에
+ * 들어가는 크기에서는 변환 비용만큼 segment_score_against_all()이 느려지고,
+ * 메모리 대역폭이 병목인 큰 라이브러리에서 비슷해집니다.
+ * 이미 로드된 캐시도 즉시 변환되며, 이후 로드/프로필 복원/재캘리브레이션에도
+ * 적용됩니다.
+ */
+int segment_set_keypose_storage(KeyposeStorage storage);
+
+/**
+ * @brief 사용자 캘리브레이션 프로필을 바이너리 파일로 저장
+ * @param profile_dir 프로필 디렉토리 경로
+ * @param user_id 사용자 ID (영문/숫자/'-'/'_', 최대 64자)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * B 이용자의 캘리브레이션 데이터와, 로드되어 있다면 사용자 체형으로 변환된
+ * 세그먼트 캐시를 "<profile_dir>/<user_id>.profile"에 저장합니다.
+ * segment_calibrate_user()가 먼저 호출되어야 합니다.
+ */
+int segment_save_user_profile(const char *profile_dir, const char *user_id);
+
+/**
+ * @brief 저장된 사용자 캘리브레이션 프로필 복원
+ * @param profile_dir 프로필 디렉토리 경로
+ * @param user_id 사용자 ID
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 캘리브레이션 데이터를 복원하고, 프로필에 세그먼트 캐시가 있으면 재변환 없이
+ * 그대로 복원합니다. 이후 캘리브레이션 포즈나 segment_load_all_segments() 없이
+ * 바로 segment_set_current_segment()를 호출할 수 있습니다. 세그먼트 캐시를
+ * 복원하면 이전에 선택된 세그먼트는 해제되므로 다시 선택해야 합니다.
+ * 버전, 크기, 체크섬이 맞지 않거나 세그먼트 캐시에 원본 포즈가 없는 파일은
+ * 거부되며 기존 상태는 유지됩니다.
+ */
+int segment_load_user_profile(const char *profile_dir, const char *user_id);
+
 /**
  * @brief 미리 로드된 세그먼트에서 현재 사용할 세그먼트 선택
  * @param start_index 시작 포즈 인덱스
@@ -198,6 +246,250 @@ int segment_analyze_smart(const PoseData *current_pose, ScaleMode scale_mode,
                           bool *out_is_complete, Point3D *out_corrections,
                           PoseData *out_target_pose);
 
+/**
+ * @brief 요청한 출력만 계산하는 실시간 포즈 분석
+ * @param current_pose 현재 사용자 포즈
+ * @param scale_mode 스케일 모드 (측정/운동)
+ * @param screen_width 화면 너비
+ * @param screen_height 화면 높이
+ * @param outputs 계산할 출력 (SegmentOutputFlags 조합, 0이 아니어야 함)
+ * @param out_progress 진행도 출력 (요청하지 않으면 NULL 허용)
+ * @param out_similarity 유사도 출력 (요청하지 않으면 NULL 허용)
+ * @param out_is_complete 완료 여부 출력 (요청하지 않으면 NULL 허용)
+ * @param out_corrections 교정 벡터 배열 출력 (요청하지 않으면 NULL 허용)
+ * @param out_target_pose 목표 포즈 출력 (요청하지 않으면 NULL 허용)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 결과는 segment_analyze_smart()와 같으며, 요청하지 않은 출력에 필요한
+ * 작업은 생략됩니다. 진행도를 요청하지 않으면 시작 포즈 변환과 진행도
+ * 계산을, 교정 벡터와 목표 포즈를 모두 요청하지 않으면 목표 포즈의
+ * 위치 이동(스케일만 적용)을 생략합니다. 유사도와 완료 여부를 모두
+ * 요청하지 않으면 유사도 계산도 생략합니다 (반전 매칭 사용 시 제외).
+ * 요청하지 않은 출력 포인터에는 쓰지 않습니다.
+ */
+int segment_analyze_smart_ex(const PoseData *current_pose,
+                             ScaleMode scale_mode, float screen_width,
+                             float screen_height, unsigned int outputs,
+                             float *out_progress, float *out_similarity,
+                             bool *out_is_complete, Point3D *out_corrections,
+                             PoseData *out_target_pose);
+
+/**
+ * @brief 현재 세그먼트의 가이드 애니메이션 포즈 조회
+ * @param t 애니메이션 위치 (0.0=시작 포즈, 1.0=종료 포즈, 범위 밖은 잘라냄)
+ * @param out_pose 가이드 포즈 (사용자 체형 기준 좌표)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 세그먼트 선택 시 시작~종료 키포즈를 지나는 Catmull-Rom 곡선을 미리
+ * 샘플링해 두므로 화면 주사율로 호출해도 표 조회와 선형 보간만 수행합니다.
+ * z 좌표와 신뢰도도 보간합니다.
+ */
+int segment_get_guide_pose(float t, PoseData *out_pose);
+
+/**
+ * @brief 스마트 목표 포즈를 오버레이 정점 버퍼로 바로 출력하는 분석
+ * @param current_pose 현재 사용자 포즈
+ * @param scale_mode 스케일 모드 (측정/운동)
+ * @param screen_width 화면 너비
+ * @param screen_height 화면 높이
+ * @param outputs 함께 계산할 출력 (SEGMENT_OUTPUT_TARGET_POSE 제외, 0 허용)
+ * @param out_progress 진행도 출력 (요청하지 않으면 NULL 허용)
+ * @param out_similarity 유사도 출력 (요청하지 않으면 NULL 허용)
+ * @param out_is_complete 완료 여부 출력 (요청하지 않으면 NULL 허용)
+ * @param out_corrections 교정 벡터 배열 출력 (요청하지 않으면 NULL 허용)
+ * @param out_vertices 정점 버퍼 (SEGMENT_OVERLAY_VERTEX_FLOATS개 float)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 목표 포즈를 랜드마크마다 {x, y, 표시 여부} 순서로 기록합니다. 표시 여부는
+ * 신뢰도가 SEGMENT_OVERLAY_MIN_VISIBILITY 이상이면 1.0, 아니면 0.0입니다.
+ * 뼈대 선분은 segment_get_overlay_bone_indices()의 인덱스로 그립니다.
+ */
+int segment_analyze_smart_overlay(const PoseData *current_pose,
+                                  ScaleMode scale_mode, float screen_width,
+                                  float screen_height, unsigned int outputs,
+                                  float *out_progress, float *out_similarity,
+                                  bool *out_is_complete,
+                                  Point3D *out_corrections,
+                                  float *out_vertices);
+
+/**
+ * @brief 오버레이 뼈대 선분 인덱스 버퍼 (정적, 프레임마다 다시 만들 필요 없음)
+ * @param out_index_count 인덱스 개수 출력 (선분 개수 * 2, NULL 허용)
+ * @return 관절 연결 테이블 순서의 정점 인덱스 쌍 배열
+ *
+ * 인덱스는 segment_analyze_smart_overlay()의 정점 번호(랜드마크 번호)이며
+ * 라인 리스트 그리기에 그대로 사용할 수 있습니다.
+ */
+const uint16_t *segment_get_overlay_bone_indices(int *out_index_count);
+
+/**
+ * @brief stride 뷰에서 포즈 데이터를 한 번에 읽고 검증
+ * @param view 33개 랜드마크를 가리키는 호스트 버퍼 뷰
+ * @param timestamp 포즈 캡처 시간 (밀리초)
+ * @param out_pose 생성된 포즈 데이터
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * segment_create_pose_data()와 같은 검증을 복사하는 동안 함께 수행합니다.
+ */
+int segment_pose_from_view(const LandmarkView *view, uint64_t timestamp,
+                           PoseData *out_pose);
+
+/**
+ * @brief stride 뷰를 직접 입력받는 segment_analyze_simple()
+ * @param view 33개 랜드마크를 가리키는 호스트 버퍼 뷰
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 나머지 인자와 결과는 segment_analyze_simple()과 같습니다. 호출자가
+ * PoseData를 만들 필요가 없으며, 버퍼는 호출이 끝나면 다시 쓸 수 있습니다.
+ * 유효성 검사는 버퍼를 읽는 동안 한 번만 수행합니다.
+ */
+int segment_analyze_simple_view(const LandmarkView *view, float *out_progress,
+                                bool *out_is_complete, float *out_similarity,
+                                Point3D *out_corrections);
+
+/**
+ * @brief stride 뷰를 직접 입력받는 segment_analyze_smart_ex()
+ * @param view 33개 랜드마크를 가리키는 호스트 버퍼 뷰
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 나머지 인자와 결과는 segment_analyze_smart_ex()와 같습니다 (모션 게이팅,
+ * 스마트 목표 포즈 캐시 포함). 유효성 검사는 버퍼를 읽는 동안 한 번만
+ * 수행합니다.
+ */
+int segment_analyze_smart_view(const LandmarkView *view, ScaleMode scale_mode,
+                               float screen_width, float screen_height,
+                               unsigned int outputs, float *out_progress,
+                               float *out_similarity, bool *out_is_complete,
+                               Point3D *out_corrections,
+                               PoseData *out_target_pose);
+
+/**
+ * @brief segment_analyze_smart()의 모션 게이팅 설정
+ * @param enabled 게이팅 사용 여부
+ * @param motion_threshold 관절 평균 이동량 임계값 (px, RMS 기준)
+ * @param max_stale_ms 캐시 결과를 재사용할 수 있는 최대 경과 시간 (밀리초)
+ * @param max_stale_frames 캐시 결과를 연속으로 재사용할 수 있는 최대 프레임 수
+ *                         (0이면 프레임 수 제한 없음)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 활성화하면 현재 세그먼트의 중요 관절(analyze_exercise_joints() 결과)이
+ * 마지막으로 전체 분석한 프레임 대비 임계값 미만으로 움직였을 때 캐시된
+ * 결과와 목표 포즈를 그대로 반환합니다. 경과 시간은 PoseData.timestamp로
+ * 재므로 프레임 도착 간격이 불규칙해도 캐시 결과는 max_stale_ms보다 오래되지
+ * 않으며, 타임스탬프가 거꾸로 가면 전체 분석을 수행합니다. max_stale_frames는
+ * 보조 제한으로, 타임스탬프가 없는 입력(segment_analyze_smart_view()는
+ * 0으로 기록)에서는 이 값만 신선도를 보장합니다. max_stale_ms가 0이면
+ * SEGMENT_ERROR_INVALID_PARAMETER를 반환합니다. 설정 시 통계와 캐시가
+ * 초기화됩니다.
+ */
+int segment_set_motion_gating(bool enabled, float motion_threshold,
+                              uint64_t max_stale_ms, int max_stale_frames);
+
+/**
+ * @brief 모션 게이팅 통계 조회
+ * @param out_skipped_frames 분석을 생략하고 캐시를 반환한 누적 프레임 수
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int segment_get_motion_gating_stats(uint64_t *out_skipped_frames);
+
+/**
+ * @brief segment_analyze_smart()의 목표 포즈 기준점 설정
+ * @param type 기준점 종류 (기본값 ANCHOR_TYPE_AUTO)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 사용자 포즈와 키포즈의 기준점을 맞춰 목표 포즈를 배치합니다.
+ * ANCHOR_TYPE_AUTO는 운동 모드에서 발목, 측정 모드에서 골반을 사용합니다.
+ * 발이 가려지는 푸시업 같은 운동은 ANCHOR_TYPE_SHOULDERS가 적합합니다.
+ * 기준 그룹이 보이지 않으면 골반 중심으로 대체합니다.
+ */
+int segment_set_anchor_type(AnchorType type);
+
+/**
+ * @brief segment_analyze_smart()의 스마트 목표 포즈 재사용 허용 오차 설정
+ * @param center_epsilon 재사용 허용 사용자 중심점 이동량 (px, 기본값 0)
+ * @param scale_epsilon 재사용 허용 스케일 변화 비율 (기본값 0)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 시작/종료 키포즈의 중심점과 기준 길이는 세그먼트 선택 시 한 번만
+ * 계산됩니다. 사용자 중심점(운동 모드: 발목, 측정 모드: 골반)과 스케일이
+ * 마지막 계산 시점 대비 허용 오차 이내로 변하면 이전에 만든 스마트
+ * 시작/종료 포즈를 그대로 사용합니다. 기본값 0은 완전히 같을 때만
+ * 재사용합니다. 2px / 0.01 정도면 화면상 차이 없이 대부분의 프레임에서
+ * 포즈 변환을 생략합니다. 설정 시 캐시와 통계가 초기화됩니다.
+ * ALIGNMENT_MODE_PROCRUSTES에는 적용되지 않습니다.
+ */
+int segment_set_smart_target_cache(float center_epsilon, float scale_epsilon);
+
+/**
+ * @brief 스마트 목표 포즈 캐시 통계 조회
+ * @param out_hits 캐시된 포즈를 재사용한 누적 프레임 수
+ * @param out_misses 포즈를 새로 계산한 누적 프레임 수
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int segment_get_smart_target_cache_stats(uint64_t *out_hits,
+                                         uint64_t *out_misses);
+
+/**
+ * @brief 분석 함수가 사용할 유사도 척도 설정
+ * @param metric 유사도 척도 (기본값 SIMILARITY_METRIC_DISTANCE)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * segment_analyze_simple()과 segment_analyze_smart() 계열의 out_similarity와
+ * 완료 판단에 적용됩니다. SIMILARITY_METRIC_ANGLE은 무릎/엉덩이/팔꿈치/어깨
+ * 각도를 비교하므로 카메라 거리나 체형에 영향을 받지 않습니다.
+ * segment_score_against_all()은 항상 거리 척도를 사용합니다.
+ */
+int segment_set_similarity_metric(SimilarityMetric metric);
+
+/**
+ * @brief segment_analyze_smart()의 목표 포즈 정렬 방식 설정
+ * @param mode 정렬 방식 (기본값 ALIGNMENT_MODE_ANCHOR)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * ALIGNMENT_MODE_PROCRUSTES는 신뢰도 높은 주요 관절로 종료 키포즈를 현재
+ * 프레임에 맞추는 닫힌 형식 상사 변환을 매 프레임 구해 시작/종료 포즈에
+ * 적용합니다. 사용자가 카메라에서 약간 돌아서 있어도 회전이 보정되며,
+ * scale_mode와 화면 크기에 따른 중심/스케일 규칙은 사용되지 않습니다.
+ * 유효 관절이 3개 미만이면 해당 프레임은 기존 방식으로 처리합니다.
+ */
+int segment_set_alignment_mode(AlignmentMode mode);
+
+/**
+ * @brief 좌우 반전 매칭 설정
+ * @param enabled 반전 매칭 사용 여부 (기본값 false)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 활성화하면 segment_analyze_simple()과 segment_analyze_smart() 계열이
+ * 목표 포즈와 좌우 반전된 목표 포즈를 한 루프에서 함께 비교하고 더 높은
+ * 유사도를 사용합니다. 반전 쪽이 매칭되면 진행도, 교정 벡터, 반환되는
+ * 목표 포즈도 반전된 포즈 기준으로 계산됩니다. 녹화자와 반대쪽으로 하는
+ * 단측 운동(런지, 한쪽 팔 운동 등)에 사용합니다.
+ */
+int segment_set_mirror_matching(bool enabled);
+
+/**
+ * @brief 마지막 분석이 반전 목표와 매칭되었는지 조회
+ * @param out_mirrored 반전 목표와 매칭되었으면 true
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int segment_get_last_match_mirrored(bool *out_mirrored);
+
+/**
+ * @brief 진행도/교정/완료 판단에 사용할 관심 관절 설정
+ * @param care_joints 관심 관절 배열 (NULL이면 해제)
+ * @param care_joint_count 관심 관절 개수 (0이면 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 관절 배열은 호출 시 한 번 관절 집합으로 컴파일되어 이후 매 프레임
+ * 재사용됩니다. 설정되면 segment_analyze_simple()과
+ * segment_analyze_smart() 계열은 해당 관절만으로 진행도를 계산하고
+ * 나머지 관절의 교정 벡터는 0으로 채웁니다. 상체, 하체, 주요 관절 12개
+ * 집합은 전용 루프로 처리됩니다. 좌우 반전 매칭 시에는 관절 집합도
+ * 반전되어 적용됩니다. 설정은 세그먼트를 바꿔도 유지됩니다.
+ */
+int segment_set_care_joints(const JointType *care_joints,
+                            int care_joint_count);
+
 /**
  * @brief 세그먼트 정보 조회
  * @param out_segment_count 총 세그먼트 개수 출력
@@ -207,6 +499,43 @@ int segment_analyze_smart(const PoseData *current_pose, ScaleMode scale_mode,
  */
 int segment_get_segment_info(int *out_segment_count);
 
+/**
+ * @brief 로드된 모든 키포즈로 최근접 포즈 검색 인덱스 생성
+ * @param out_index 생성된 인덱스 (pose_index_destroy()로 해제)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * segment_load_all_segments()로 캐시된 포즈로 인덱스를 만듭니다.
+ * 검색 결과의 pose_id는 segment_set_current_segment()의 인덱스와 같습니다.
+ * 한 번 만든 인덱스는 pose_index_save()로 저장해 재사용할 수 있습니다.
+ */
+int segment_build_pose_index(PoseIndex **out_index);
+
+/**
+ * @brief 로드된 모든 키포즈의 정규화 임베딩 테이블 조회
+ * @param out_embeddings 임베딩 배열 (count x POSE_EMBEDDING_DIMENSION, 읽기 전용)
+ * @param out_count 키포즈 개수
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 임베딩은 segment_load_all_segments()에서 한 번 계산되며 다음 로드 또는
+ * segment_api_cleanup() 전까지 유효합니다. 실시간 프레임은
+ * pose_embedding_compute()로 같은 공간에 임베딩할 수 있습니다.
+ */
+int segment_get_pose_embeddings(const float **out_embeddings, int *out_count);
+
+/**
+ * @brief 현재 프레임을 로드된 모든 키포즈와 비교
+ * @param frame 현재 사용자 포즈
+ * @param out_scores 키포즈별 유사도 출력 (0.0~1.0, 로드된 키포즈 수만큼,
+ *                   NULL이면 최고 인덱스만 계산)
+ * @return 가장 유사한 키포즈 인덱스 (0 이상), 음수 에러 코드
+ *
+ * 사용자가 어느 세그먼트에 있는지 모를 때 segment_set_current_segment()와
+ * segment_analyze_simple()을 반복 호출하는 대신 사용합니다. 유사도는
+ * segment_calculate_similarity()와 같은 척도이며, 로드 시 만든 블록 SoA
+ * 테이블을 SIMD로 한 번만 훑습니다. 현재 세그먼트 선택은 바뀌지 않습니다.
+ */
+int segment_score_against_all(const PoseData *frame, float *out_scores);
+
 // MARK: - Swift 호환성을 위한 함수들
 
 /**
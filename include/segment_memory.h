@@ -0,0 +1,146 @@
+/**
+ * @file segment_memory.h
+ * @brief 교체 가능한 메모리 할당자와 용도별 메모리 사용량 집계
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 라이브러리의 모든 힙 할당은 설정된 할당자를 거치며, 할당마다 용도
+ * (파싱 버퍼, 세그먼트 캐시, 인덱스)별로 현재/최대 사용량을 집계합니다.
+ * 할당자를 설정하지 않으면 malloc/realloc/free를 사용합니다.
+ * 집계는 원자적이지 않으며 API 호출 스레드에서만 할당한다고 가정합니다.
+ */
+
+#ifndef SEGMENT_MEMORY_H
+#define SEGMENT_MEMORY_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 메모리 사용 용도
+ */
+typedef enum {
+  SEGMENT_MEMORY_PARSE = 0,     // JSON/프로필 파일 읽기·파싱 버퍼
+  SEGMENT_MEMORY_SEGMENTS = 1,  // 워크아웃 블록 (키포즈 + 파생 테이블)
+  SEGMENT_MEMORY_INDEX = 2,     // 포즈 인덱스, 독립 점수 테이블
+  SEGMENT_MEMORY_CATEGORY_COUNT // 용도 개수
+} SegmentMemoryCategory;
+
+/**
+ * @brief 호스트가 제공하는 할당자 (user_data는 각 콜백에 그대로 전달)
+ * reallocate(NULL, size)는 allocate와 같아야 하며, 실패 시 NULL 반환
+ */
+typedef struct {
+  void *(*allocate)(size_t size, void *user_data);
+  void *(*reallocate)(void *ptr, size_t size, void *user_data);
+  void (*release)(void *ptr, void *user_data);
+  void *user_data;
+} SegmentAllocator;
+
+/**
+ * @brief 용도별 메모리 사용량
+ */
+typedef struct {
+  size_t live_bytes;    // 현재 사용 중인 바이트 (요청 크기 기준)
+  size_t peak_bytes;    // 최대 사용량 (마지막 초기화 이후)
+  uint64_t allocations; // 누적 할당 횟수
+} SegmentMemoryStats;
+
+/**
+ * @brief 라이브러리 할당자 설정
+ * @param allocator 사용할 할당자 (NULL이면 malloc/realloc/free로 복원)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 라이브러리 메모리가 하나도 남아 있지 않을 때만 바꿀 수 있습니다
+ * (segment_api_init() 전, 또는 segment_api_cleanup()과 앱이 만든 포즈
+ * 인덱스 해제 후). 설정 시 최대 사용량과 할당 횟수도 초기화됩니다.
+ */
+int segment_set_allocator(const SegmentAllocator *allocator);
+
+/**
+ * @brief 용도별 메모리 사용량 조회
+ * @param category 조회할 용도
+ * @param out_stats 사용량 출력
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int segment_get_memory_stats(SegmentMemoryCategory category,
+                             SegmentMemoryStats *out_stats);
+
+/**
+ * @brief 모든 용도의 최대 사용량을 현재 사용량으로 초기화
+ */
+void segment_reset_memory_peaks(void);
+
+// MARK: - 라이브러리 내부 할당 함수
+
+/* 아레나 할당 정렬 단위 (캐시 라인) */
+#define SEGMENT_ARENA_ALIGNMENT 64
+
+/**
+ * @brief 블록 하나를 앞에서부터 잘라 쓰는 범프 할당자
+ * 개별 해제 없이 segment_arena_reset()/release()로 한 번에 반납합니다.
+ */
+typedef struct {
+  void *block;         // segment_mem_alloc로 받은 원본 블록 (해제용)
+  unsigned char *base; // SEGMENT_ARENA_ALIGNMENT 정렬된 시작 주소
+  size_t capacity;     // 사용 가능한 바이트
+  size_t used;         // 사용한 바이트 (다음 할당 위치)
+} SegmentArena;
+
+/**
+ * @brief 아레나 할당 하나가 차지하는 크기 (정렬 단위로 올림)
+ */
+size_t segment_arena_footprint(size_t size);
+
+/**
+ * @brief capacity 바이트짜리 정렬된 아레나 생성 (할당 한 번)
+ */
+int segment_arena_init(SegmentArena *arena, SegmentMemoryCategory category,
+                       size_t capacity);
+
+/**
+ * @brief 정렬된 size 바이트 할당 (공간이 부족하면 NULL)
+ */
+void *segment_arena_alloc(SegmentArena *arena, size_t size);
+
+/**
+ * @brief 모든 할당을 한 번에 반납 (블록은 유지)
+ */
+void segment_arena_reset(SegmentArena *arena);
+
+/**
+ * @brief 아레나 블록 해제 (초기화하지 않은 0 상태의 아레나도 허용)
+ */
+void segment_arena_release(SegmentArena *arena);
+
+/**
+ * @brief 용도를 지정해 할당 (size가 0이면 NULL)
+ */
+void *segment_mem_alloc(SegmentMemoryCategory category, size_t size);
+
+/**
+ * @brief 0으로 채운 배열 할당 (calloc 대체)
+ */
+void *segment_mem_calloc(SegmentMemoryCategory category, size_t count,
+                         size_t size);
+
+/**
+ * @brief 크기 변경 (ptr이 NULL이면 할당, 실패 시 원래 블록 유지)
+ */
+void *segment_mem_realloc(SegmentMemoryCategory category, void *ptr,
+                          size_t size);
+
+/**
+ * @brief segment_mem_* 로 할당한 메모리 해제 (NULL 허용)
+ */
+void segment_mem_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SEGMENT_MEMORY_H
@@ -9,6 +9,7 @@
 #define SEGMENT_TYPES_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -107,6 +108,32 @@ typedef struct {
   uint64_t timestamp; /* 포즈 캡처 시간 (밀리초) */
 } PoseData;
 
+/* LandmarkView에서 해당 필드가 없음을 나타내는 오프셋 */
+#define LANDMARK_VIEW_NO_FIELD ((size_t)-1)
+
+/**
+ * @brief 호스트 버퍼의 랜드마크 배열을 복사 없이 가리키는 stride 뷰
+ * 랜드마크 i의 각 필드는 (const char *)base + i * stride + offset 위치의
+ * float 값 (정렬 불필요). 예: x,y,z,visibility 연속 배열이면
+ * stride = 4 * sizeof(float), 오프셋 0/4/8/12
+ */
+typedef struct {
+  const void *base;         /* 첫 번째 랜드마크 시작 주소 */
+  size_t stride;            /* 랜드마크 간 바이트 간격 */
+  size_t offset_x;          /* x 좌표 바이트 오프셋 */
+  size_t offset_y;          /* y 좌표 바이트 오프셋 */
+  size_t offset_z;          /* z 좌표 오프셋 (없으면 0.0) */
+  size_t offset_visibility; /* 신뢰도 오프셋 (없으면 1.0) */
+} LandmarkView;
+
+/* 오버레이 정점 하나의 float 개수 (화면 x, 화면 y, 표시 여부 0/1) */
+#define SEGMENT_OVERLAY_VERTEX_STRIDE 3
+/* 오버레이 정점 버퍼 크기 (float 개수, 랜드마크 순서) */
+#define SEGMENT_OVERLAY_VERTEX_FLOATS                                         \
+  (POSE_LANDMARK_COUNT * SEGMENT_OVERLAY_VERTEX_STRIDE)
+/* 오버레이 정점을 표시할 최소 신뢰도 */
+#define SEGMENT_OVERLAY_MIN_VISIBILITY 0.5f
+
 /* Swift 호환성을 위한 타입 별칭 */
 #ifdef __cplusplus
 extern "C" {
@@ -137,6 +164,9 @@ typedef struct {
   const char *name;            /* 연결 이름 (예: "상완", "대퇴") */
 } JointConnection;
 
+/* g_joint_connections의 관절 연결 개수 */
+#define JOINT_CONNECTION_COUNT 20
+
 /**
  * @brief 관절별 길이 정보
  * 각 관절 간의 길이와 스케일 팩터
@@ -154,7 +184,7 @@ typedef struct {
  * 모든 관절 간 연결의 길이 정보
  */
 typedef struct {
-  JointLength lengths[20]; /* 주요 관절 연결들 (최대 20개) */
+  JointLength lengths[JOINT_CONNECTION_COUNT]; /* 관절 연결별 길이 */
   int count;               /* 실제 연결 개수 */
 } JointLengthCalibration;
 
@@ -198,6 +228,52 @@ typedef enum {
   SCALE_MODE_EXERCISE = 1     // 운동 모드: 스케일 조정 함
 } ScaleMode;
 
+/**
+ * @brief 포즈 유사도 척도
+ */
+typedef enum {
+  SIMILARITY_METRIC_DISTANCE = 0, // 골반 기준 관절 거리 (500px 기준)
+  SIMILARITY_METRIC_ANGLE = 1     // 관절 각도 차이 (체형/카메라 거리 무관)
+} SimilarityMetric;
+
+/**
+ * @brief 스마트 분석의 목표 포즈 정렬 방식
+ */
+typedef enum {
+  ALIGNMENT_MODE_ANCHOR = 0,    // 발목/골반 중심 이동 + 어깨 기준 스케일
+  ALIGNMENT_MODE_PROCRUSTES = 1 // 주요 관절 상사 변환 (회전 + 스케일 + 이동)
+} AlignmentMode;
+
+/**
+ * @brief 스마트 분석에서 목표 포즈를 사용자에게 맞출 기준점
+ */
+typedef enum {
+  ANCHOR_TYPE_AUTO = 0,     // 스케일 모드 기본값 (운동: 발목, 측정: 골반)
+  ANCHOR_TYPE_ANKLES = 1,   // 발목 중심 → 골반 중심
+  ANCHOR_TYPE_HIPS = 2,     // 골반 중심
+  ANCHOR_TYPE_SHOULDERS = 3 // 어깨 중심 → 골반 중심 (푸시업 등)
+} AnchorType;
+
+/**
+ * @brief 세그먼트 캐시의 키포즈 저장 방식
+ */
+typedef enum {
+  KEYPOSE_STORAGE_FLOAT32 = 0,  // float32 그대로 (기본값)
+  KEYPOSE_STORAGE_QUANTIZED = 1 // int16 좌표 + uint8 신뢰도 (약 절반 크기)
+} KeyposeStorage;
+
+/**
+ * @brief segment_analyze_smart_ex()가 계산할 출력 플래그 (비트 OR로 조합)
+ */
+typedef enum {
+  SEGMENT_OUTPUT_PROGRESS = 1 << 0,    // 진행도
+  SEGMENT_OUTPUT_SIMILARITY = 1 << 1,  // 유사도
+  SEGMENT_OUTPUT_COMPLETION = 1 << 2,  // 완료 여부
+  SEGMENT_OUTPUT_CORRECTIONS = 1 << 3, // 교정 벡터
+  SEGMENT_OUTPUT_TARGET_POSE = 1 << 4, // 사용자 위치 기준 목표 포즈
+  SEGMENT_OUTPUT_ALL = 0x1F            // 모든 출력
+} SegmentOutputFlags;
+
 /**
  * @brief 에러 코드 열거형
  * API 함수들의 반환값으로 사용
@@ -0,0 +1,98 @@
+/**
+ * @file skeleton.h
+ * @brief 뼈 방향 기반 포즈 표현과 순운동학(FK) 복원
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 포즈를 절대 좌표 대신 루트(골반 중심) 위치와 뼈별 단위 방향/길이로
+ * 저장합니다. 체형과 무관한 형태로 키포즈를 한 번만 저장해 두고, 필요할 때
+ * 사용자 CalibrationData로 만든 SkeletonRig를 적용하여 PoseData를 복원합니다.
+ * 뼈 계층과 관절 길이 스케일 규칙은 retarget.h와 같습니다.
+ */
+
+#ifndef SKELETON_H
+#define SKELETON_H
+
+#include "retarget.h"
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 뼈 방향 공간의 포즈
+ *
+ * directions[b]와 lengths[b]는 retarget 뼈 계층의 b번째 뼈(부모 → 자식)에
+ * 해당합니다. 방향은 카메라 좌표계 기준 단위 벡터이며, 길이가 0인 뼈는
+ * 방향도 0입니다.
+ */
+typedef struct {
+  Point3D root_position;                   /* 골반 중심 (전역 루트 위치) */
+  Point3D directions[RETARGET_BONE_COUNT]; /* 뼈별 단위 방향 */
+  float lengths[RETARGET_BONE_COUNT];      /* 뼈별 원래 길이 */
+  float confidences[POSE_LANDMARK_COUNT];  /* 랜드마크별 신뢰도 */
+  uint64_t timestamp;                      /* 원래 포즈의 타임스탬프 */
+} SkeletonPose;
+
+/**
+ * @brief 한 사용자에 대해 미리 계산된 FK 파라미터
+ */
+typedef struct {
+  RetargetSkeleton bones; /* 뼈 계층과 뼈별 길이 스케일 */
+  float root_scale;       /* 루트 위치 스케일 */
+  Point3D root_offset;    /* 루트 위치 오프셋 */
+} SkeletonRig;
+
+/**
+ * @brief PoseData를 뼈 방향 표현으로 변환
+ * @param pose 입력 포즈
+ * @param out_skeleton 출력 표현
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int skeleton_from_pose(const PoseData *pose, SkeletonPose *out_skeleton);
+
+/**
+ * @brief 캘리브레이션으로 FK 파라미터 준비
+ * @param rig 출력 파라미터
+ * @param calibration 사용자 캘리브레이션 (NULL이면 원래 크기/위치 그대로 복원)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 루트 위치는 apply_calibration_to_pose()와 같이 scale_factor와
+ * center_offset으로 옮기고, 측정된 뼈는 관절별 스케일, 나머지는 부모 뼈
+ * (루트는 scale_factor) 스케일을 사용합니다.
+ */
+int skeleton_rig_init(SkeletonRig *rig, const CalibrationData *calibration);
+
+/**
+ * @brief 순운동학으로 PoseData 복원
+ * @param rig FK 파라미터
+ * @param skeleton 뼈 방향 표현
+ * @param out_pose 복원된 포즈
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 루트에서 위상 순서로 뼈를 한 번 순회하는 O(33) 연산입니다.
+ */
+int skeleton_forward_kinematics(const SkeletonRig *rig,
+                                const SkeletonPose *skeleton,
+                                PoseData *out_pose);
+
+/**
+ * @brief 캘리브레이션을 바로 적용하여 PoseData 복원
+ * @param skeleton 뼈 방향 표현
+ * @param calibration 사용자 캘리브레이션 (NULL 허용)
+ * @param out_pose 복원된 포즈
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 같은 사용자로 여러 포즈를 복원할 때는 skeleton_rig_init()을 한 번 호출하고
+ * skeleton_forward_kinematics()를 사용하는 편이 빠릅니다.
+ */
+int skeleton_to_pose(const SkeletonPose *skeleton,
+                     const CalibrationData *calibration, PoseData *out_pose);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SKELETON_H
@@ -0,0 +1,65 @@
+/**
+ * @file trajectory.h
+ * @brief 키포즈 사이 가이드 애니메이션 궤적 (미리 샘플링한 Catmull-Rom 곡선)
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ *
+ * @details
+ * 가이드("고스트") 애니메이션은 화면 주사율(60~120Hz)로 그려지므로 매 프레임
+ * 보간 곡선을 계산하지 않도록, 세그먼트 선택 시 시작~종료 키포즈를 지나는
+ * Catmull-Rom 곡선을 고정 해상도로 샘플링해 둡니다. 이후 임의의 t는 표 조회
+ * 한 번과 선형 보간 한 번으로 구합니다. z 좌표와 신뢰도도 보간합니다.
+ */
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include "segment_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 궤적 샘플 수 (구간 64개: 키포즈 구간이 1, 2, 4, 8개면 샘플이 키포즈에 일치) */
+#define TRAJECTORY_SAMPLE_COUNT 65
+
+/**
+ * @brief 미리 샘플링한 포즈 궤적
+ * 호출자가 메모리를 소유하며, trajectory_build()로 채웁니다.
+ */
+typedef struct {
+  PoseData samples[TRAJECTORY_SAMPLE_COUNT]; /* t = i / (개수 - 1) 위치 포즈 */
+  bool ready;                                /* 생성 완료 여부 */
+} PoseTrajectory;
+
+/**
+ * @brief 키포즈 목록의 first~last 구간을 지나는 궤적 생성
+ * @param trajectory 채울 궤적
+ * @param keyposes 키포즈 배열 (운동 순서)
+ * @param keypose_count 키포즈 개수
+ * @param first 구간 시작 인덱스
+ * @param last 구간 종료 인덱스 (first와 같으면 정지 포즈)
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ *
+ * 구간 밖의 이웃 키포즈(first - 1, last + 1)가 있으면 양 끝 접선에 사용해
+ * 연속된 세그먼트의 애니메이션이 부드럽게 이어지고, 없으면 끝 키포즈를
+ * 반복해 사용합니다 (끝에서 감속). 신뢰도는 키포즈 사이 선형 보간합니다.
+ */
+int trajectory_build(PoseTrajectory *trajectory, const PoseData *keyposes,
+                     int keypose_count, int first, int last);
+
+/**
+ * @brief 궤적에서 t 위치의 포즈 조회
+ * @param trajectory 생성된 궤적
+ * @param t 진행 위치 (0.0=시작, 1.0=종료, 범위 밖은 잘라냄)
+ * @param out_pose 보간된 포즈
+ * @return SEGMENT_OK 성공, 음수 에러 코드
+ */
+int trajectory_sample(const PoseTrajectory *trajectory, float t,
+                      PoseData *out_pose);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRAJECTORY_H
@@ -0,0 +1,269 @@
+/**
+ * @file alignment.c
+ * @brief Horn 쿼터니언 기반 Procrustes 정렬 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/alignment.h"
+#include <math.h>
+#include <string.h>
+
+// Jacobi 고유값 분해 최대 스윕 수 (4x4는 보통 3~4회에 수렴)
+#define ALIGNMENT_MAX_SWEEPS 8
+
+// 원본 점들이 이보다 좁게 모여 있으면 스케일/회전을 정의하지 않음
+#define ALIGNMENT_MIN_SPREAD 1e-6f
+
+const JointType g_alignment_joints[ALIGNMENT_JOINT_COUNT] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
+    POSE_LANDMARK_LEFT_HIP,      POSE_LANDMARK_RIGHT_HIP,
+    POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
+    POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
+
+/**
+ * @brief 4x4 대칭 행렬의 순환 Jacobi 고유값 분해
+ * @param a 입력 행렬 (대각 원소에 고유값이 남음)
+ * @param v 고유벡터 (열 단위)
+ */
+static void jacobi_eigen_4x4(double a[4][4], double v[4][4]) {
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      v[i][j] = (i == j) ? 1.0 : 0.0;
+    }
+  }
+
+  for (int sweep = 0; sweep < ALIGNMENT_MAX_SWEEPS; sweep++) {
+    double off = 0.0;
+    double diag = 0.0;
+    for (int i = 0; i < 4; i++) {
+      diag += a[i][i] * a[i][i];
+      for (int j = i + 1; j < 4; j++) {
+        off += a[i][j] * a[i][j];
+      }
+    }
+    if (off <= 1e-24 * diag) {
+      break;
+    }
+
+    for (int p = 0; p < 3; p++) {
+      for (int q = p + 1; q < 4; q++) {
+        if (a[p][q] == 0.0) {
+          continue;
+        }
+
+        // a[p][q]를 0으로 만드는 회전각
+        double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+        double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                   (fabs(theta) + sqrt(theta * theta + 1.0));
+        double c = 1.0 / sqrt(t * t + 1.0);
+        double s = t * c;
+
+        for (int k = 0; k < 4; k++) {
+          double akp = a[k][p];
+          double akq = a[k][q];
+          a[k][p] = c * akp - s * akq;
+          a[k][q] = s * akp + c * akq;
+        }
+        for (int k = 0; k < 4; k++) {
+          double apk = a[p][k];
+          double aqk = a[q][k];
+          a[p][k] = c * apk - s * aqk;
+          a[q][k] = s * apk + c * aqk;
+        }
+        for (int k = 0; k < 4; k++) {
+          double vkp = v[k][p];
+          double vkq = v[k][q];
+          v[k][p] = c * vkp - s * vkq;
+          v[k][q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+}
+
+int alignment_solve(const Point3D *source, const Point3D *target,
+                    const float *weights, int count,
+                    SimilarityTransform *out_transform) {
+  if (!source || !target || count < 0 || !out_transform) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 1. 가중 중심
+  double weight_sum = 0.0;
+  double sc[3] = {0.0, 0.0, 0.0};
+  double tc[3] = {0.0, 0.0, 0.0};
+  int used = 0;
+
+  for (int i = 0; i < count; i++) {
+    double w = weights ? weights[i] : 1.0;
+    if (w <= 0.0) {
+      continue;
+    }
+    weight_sum += w;
+    sc[0] += w * source[i].x;
+    sc[1] += w * source[i].y;
+    sc[2] += w * source[i].z;
+    tc[0] += w * target[i].x;
+    tc[1] += w * target[i].y;
+    tc[2] += w * target[i].z;
+    used++;
+  }
+
+  if (used < ALIGNMENT_MIN_POINTS) {
+    return SEGMENT_ERROR_INVALID_POSE;
+  }
+
+  for (int k = 0; k < 3; k++) {
+    sc[k] /= weight_sum;
+    tc[k] /= weight_sum;
+  }
+
+  // 2. 교차 공분산 S[a][b] = Σ w s'_a t'_b 와 분산
+  double S[3][3] = {{0.0}};
+  double source_var = 0.0;
+  double target_var = 0.0;
+
+  for (int i = 0; i < count; i++) {
+    double w = weights ? weights[i] : 1.0;
+    if (w <= 0.0) {
+      continue;
+    }
+    double s[3] = {source[i].x - sc[0], source[i].y - sc[1],
+                   source[i].z - sc[2]};
+    double t[3] = {target[i].x - tc[0], target[i].y - tc[1],
+                   target[i].z - tc[2]};
+    for (int a = 0; a < 3; a++) {
+      for (int b = 0; b < 3; b++) {
+        S[a][b] += w * s[a] * t[b];
+      }
+    }
+    source_var += w * (s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+    target_var += w * (t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+  }
+
+  if (source_var < ALIGNMENT_MIN_SPREAD * weight_sum) {
+    return SEGMENT_ERROR_INVALID_POSE;
+  }
+
+  // 3. Horn의 4x4 대칭 행렬과 최대 고유벡터 (= 최적 회전 쿼터니언)
+  double N[4][4] = {
+      {S[0][0] + S[1][1] + S[2][2], S[1][2] - S[2][1], S[2][0] - S[0][2],
+       S[0][1] - S[1][0]},
+      {S[1][2] - S[2][1], S[0][0] - S[1][1] - S[2][2], S[0][1] + S[1][0],
+       S[2][0] + S[0][2]},
+      {S[2][0] - S[0][2], S[0][1] + S[1][0], -S[0][0] + S[1][1] - S[2][2],
+       S[1][2] + S[2][1]},
+      {S[0][1] - S[1][0], S[2][0] + S[0][2], S[1][2] + S[2][1],
+       -S[0][0] - S[1][1] + S[2][2]}};
+  double V[4][4];
+  jacobi_eigen_4x4(N, V);
+
+  int best = 0;
+  for (int i = 1; i < 4; i++) {
+    if (N[i][i] > N[best][best]) {
+      best = i;
+    }
+  }
+  double lambda = N[best][best];
+
+  double qw = V[0][best], qx = V[1][best], qy = V[2][best], qz = V[3][best];
+  double norm = sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+  qw /= norm;
+  qx /= norm;
+  qy /= norm;
+  qz /= norm;
+
+  double R[3][3] = {
+      {1.0 - 2.0 * (qy * qy + qz * qz), 2.0 * (qx * qy - qw * qz),
+       2.0 * (qx * qz + qw * qy)},
+      {2.0 * (qx * qy + qw * qz), 1.0 - 2.0 * (qx * qx + qz * qz),
+       2.0 * (qy * qz - qw * qx)},
+      {2.0 * (qx * qz - qw * qy), 2.0 * (qy * qz + qw * qx),
+       1.0 - 2.0 * (qx * qx + qy * qy)}};
+
+  // 4. 스케일 (Umeyama)과 이동, 잔차
+  double scale = lambda / source_var;
+  if (scale <= 0.0) {
+    return SEGMENT_ERROR_INVALID_POSE;
+  }
+
+  double residual = target_var - lambda * lambda / source_var;
+  out_transform->rms_error =
+      (float)sqrt((residual > 0.0 ? residual : 0.0) / weight_sum);
+  out_transform->scale = (float)scale;
+  out_transform->point_count = used;
+
+  for (int a = 0; a < 3; a++) {
+    for (int b = 0; b < 3; b++) {
+      out_transform->rotation[a][b] = (float)R[a][b];
+    }
+  }
+
+  out_transform->translation.x =
+      (float)(tc[0] - scale * (R[0][0] * sc[0] + R[0][1] * sc[1] +
+                               R[0][2] * sc[2]));
+  out_transform->translation.y =
+      (float)(tc[1] - scale * (R[1][0] * sc[0] + R[1][1] * sc[1] +
+                               R[1][2] * sc[2]));
+  out_transform->translation.z =
+      (float)(tc[2] - scale * (R[2][0] * sc[0] + R[2][1] * sc[1] +
+                               R[2][2] * sc[2]));
+
+  return SEGMENT_OK;
+}
+
+int alignment_solve_poses(const PoseData *source, const PoseData *target,
+                          SimilarityTransform *out_transform) {
+  if (!source || !target || !out_transform) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  Point3D source_points[ALIGNMENT_JOINT_COUNT];
+  Point3D target_points[ALIGNMENT_JOINT_COUNT];
+  float weights[ALIGNMENT_JOINT_COUNT];
+
+  for (int i = 0; i < ALIGNMENT_JOINT_COUNT; i++) {
+    const PoseLandmark *s = &source->landmarks[g_alignment_joints[i]];
+    const PoseLandmark *t = &target->landmarks[g_alignment_joints[i]];
+    float confidence = fminf(s->inFrameLikelihood, t->inFrameLikelihood);
+
+    source_points[i] = s->position;
+    target_points[i] = t->position;
+    weights[i] = (confidence >= ALIGNMENT_MIN_CONFIDENCE) ? confidence : 0.0f;
+  }
+
+  return alignment_solve(source_points, target_points, weights,
+                         ALIGNMENT_JOINT_COUNT, out_transform);
+}
+
+void alignment_apply(const SimilarityTransform *transform,
+                     const PoseData *input, PoseData *output) {
+  if (!transform || !input || !output) {
+    return;
+  }
+
+  if (output != input) {
+    *output = *input;
+  }
+
+  // 스케일을 회전 행렬에 미리 곱해 관절당 9회 곱셈
+  float m[3][3];
+  for (int a = 0; a < 3; a++) {
+    for (int b = 0; b < 3; b++) {
+      m[a][b] = transform->rotation[a][b] * transform->scale;
+    }
+  }
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    Point3D p = output->landmarks[i].position;
+    output->landmarks[i].position.x = m[0][0] * p.x + m[0][1] * p.y +
+                                      m[0][2] * p.z + transform->translation.x;
+    output->landmarks[i].position.y = m[1][0] * p.x + m[1][1] * p.y +
+                                      m[1][2] * p.z + transform->translation.y;
+    output->landmarks[i].position.z = m[2][0] * p.x + m[2][1] * p.y +
+                                      m[2][2] * p.z + transform->translation.z;
+  }
+}
@@ -7,6 +7,7 @@
 
 #include "../include/calibration.h"
 #include "../include/math_utils.h"
+#include "../include/retarget.h"
 #include "../include/segment_api.h"
 #include "../include/segment_types.h"
 #include <math.h>
@@ -19,11 +20,45 @@
 // 최소 신뢰도 임계값
 #define MIN_CONFIDENCE_THRESHOLD 0.5f
 
-// 관절 연결 관계 정의
-JointConnection g_joint_connections[20];
+// 이상적 어깨 너비 (실제 데이터 기반: ~322.78)
+#define IDEAL_SHOULDER_WIDTH 322.78f
+
+// 관절 연결 관계 정의 (상수 테이블이라 여러 스레드에서 동시에 읽어도 안전)
+#define JOINT_CONNECTION_ENTRY(from, to, name) {from, to, name},
+const JointConnection g_joint_connections[] = {
+    JOINT_CONNECTION_LIST(JOINT_CONNECTION_ENTRY)};
+#undef JOINT_CONNECTION_ENTRY
+
+// 목록 길이와 JOINT_CONNECTION_COUNT가 다르면 컴파일 오류
+typedef char joint_connection_count_check
+    [sizeof(g_joint_connections) / sizeof(g_joint_connections[0]) ==
+             JOINT_CONNECTION_COUNT
+         ? 1
+         : -1];
 
 // segment_calibrate_recorder는 segment_core.c에서 구현됨
 
+/**
+ * @brief 사용자 캘리브레이션을 확정하고 캐시된 세그먼트 재변환
+ *
+ * 재변환이 실패하면 이전 캘리브레이션을 복원합니다 (세그먼트 캐시는
+ * 재변환 실패 시 바뀌지 않으므로 이전 캘리브레이션과 일치).
+ */
+static int commit_user_calibration(const CalibrationData *calibration) {
+  CalibrationData previous = g_user_calibration;
+  bool previous_calibrated = g_user_calibrated;
+
+  g_user_calibration = *calibration;
+  g_user_calibrated = true;
+
+  int result = segment_retransform_cached_segments();
+  if (result != SEGMENT_OK) {
+    g_user_calibration = previous;
+    g_user_calibrated = previous_calibrated;
+  }
+  return result;
+}
+
 int segment_calibrate_user(const PoseData *base_pose) {
   if (!base_pose) {
     return SEGMENT_ERROR_INVALID_PARAMETER;
@@ -61,15 +96,14 @@ int segment_calibrate_user(const PoseData *base_pose) {
     return SEGMENT_ERROR_CALIBRATION_FAILED;
   }
 
-  // 이상적 어깨 너비 (실제 데이터 기반: ~322.78)
-  float ideal_shoulder_width = 322.78f;
+  // 새 캘리브레이션은 복사본에서 계산하고 재변환이 성공해야 확정
+  CalibrationData calibration = g_user_calibration;
 
   // 스케일 팩터 계산
-  g_user_calibration.scale_factor = user_shoulder_width / ideal_shoulder_width;
+  calibration.scale_factor = user_shoulder_width / IDEAL_SHOULDER_WIDTH;
 
   // 스케일 팩터 유효성 검사
-  if (g_user_calibration.scale_factor < 0.01f ||
-      g_user_calibration.scale_factor > 100.0f) {
+  if (calibration.scale_factor < 0.01f || calibration.scale_factor > 100.0f) {
     return SEGMENT_ERROR_CALIBRATION_FAILED;
   }
 
@@ -78,24 +112,28 @@ int segment_calibrate_user(const PoseData *base_pose) {
   // 이상적 기본 포즈 중심점 계산 (g_ideal_base_pose는 헤더에서 extern 선언됨)
   Point3D ideal_center_3d = calculate_pose_center(&g_ideal_base_pose);
 
-  g_user_calibration.center_offset.x = ideal_center_3d.x - user_center_3d.x;
-  g_user_calibration.center_offset.y = ideal_center_3d.y - user_center_3d.y;
-  g_user_calibration.center_offset.z = 0.0f;
+  calibration.center_offset.x = ideal_center_3d.x - user_center_3d.x;
+  calibration.center_offset.y = ideal_center_3d.y - user_center_3d.y;
+  calibration.center_offset.z = 0.0f;
 
   // 관절별 길이 켈리브레이션 수행
   printf("\n🔧 관절별 길이 켈리브레이션 시작...\n");
   int joint_result =
-      segment_calibrate_joint_lengths(base_pose, &g_user_calibration);
+      segment_calibrate_joint_lengths(base_pose, &calibration);
   if (joint_result != SEGMENT_OK) {
     printf("⚠️  관절별 길이 켈리브레이션 실패, 기본 켈리브레이션만 적용\n");
   }
 
   // 캘리브레이션 완료 플래그 설정
-  g_user_calibration.is_calibrated = true;
-  g_user_calibration.calibration_quality = 0.95f;
-
-  // 중요: 사용자 캘리브레이션 완료 플래그 설정
-  g_user_calibrated = true;
+  calibration.is_calibrated = true;
+  calibration.calibration_quality =
+      calculate_calibration_quality(base_pose, &calibration);
+
+  // 이미 로드된 세그먼트를 새 체형으로 재변환 (JSON 재로드 불필요)
+  int commit_result = commit_user_calibration(&calibration);
+  if (commit_result != SEGMENT_OK) {
+    return commit_result;
+  }
 
   // 관절별 길이 정보 출력
   // print_joint_lengths(&g_user_calibration);
@@ -194,56 +232,8 @@ Point3D calculate_pose_center(const PoseData *pose) {
 // MARK: - 관절별 길이 켈리브레이션 함수들
 
 int initialize_joint_connections(void) {
-  // 주요 관절 연결 관계 정의 (인체 해부학적 구조 기반)
-  g_joint_connections[0] = (JointConnection){
-      POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_ELBOW, "좌상완"};
-  g_joint_connections[1] = (JointConnection){
-      POSE_LANDMARK_LEFT_ELBOW, POSE_LANDMARK_LEFT_WRIST, "좌전완"};
-  g_joint_connections[2] = (JointConnection){
-      POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_ELBOW, "우상완"};
-  g_joint_connections[3] = (JointConnection){
-      POSE_LANDMARK_RIGHT_ELBOW, POSE_LANDMARK_RIGHT_WRIST, "우전완"};
-
-  g_joint_connections[4] = (JointConnection){POSE_LANDMARK_LEFT_HIP,
-                                             POSE_LANDMARK_LEFT_KNEE, "좌대퇴"};
-  g_joint_connections[5] = (JointConnection){
-      POSE_LANDMARK_LEFT_KNEE, POSE_LANDMARK_LEFT_ANKLE, "좌정강"};
-  g_joint_connections[6] = (JointConnection){
-      POSE_LANDMARK_RIGHT_HIP, POSE_LANDMARK_RIGHT_KNEE, "우대퇴"};
-  g_joint_connections[7] = (JointConnection){
-      POSE_LANDMARK_RIGHT_KNEE, POSE_LANDMARK_RIGHT_ANKLE, "우정강"};
-
-  g_joint_connections[8] = (JointConnection){POSE_LANDMARK_LEFT_SHOULDER,
-                                             POSE_LANDMARK_LEFT_HIP, "좌상체"};
-  g_joint_connections[9] = (JointConnection){POSE_LANDMARK_RIGHT_SHOULDER,
-                                             POSE_LANDMARK_RIGHT_HIP, "우상체"};
-
-  g_joint_connections[10] = (JointConnection){
-      POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER, "어깨너비"};
-  g_joint_connections[11] = (JointConnection){
-      POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_RIGHT_HIP, "골반너비"};
-
-  g_joint_connections[12] = (JointConnection){
-      POSE_LANDMARK_NOSE, POSE_LANDMARK_LEFT_SHOULDER, "목-좌어깨"};
-  g_joint_connections[13] = (JointConnection){
-      POSE_LANDMARK_NOSE, POSE_LANDMARK_RIGHT_SHOULDER, "목-우어깨"};
-
-  g_joint_connections[14] = (JointConnection){
-      POSE_LANDMARK_LEFT_ANKLE, POSE_LANDMARK_LEFT_HEEL, "좌발길이"};
-  g_joint_connections[15] = (JointConnection){
-      POSE_LANDMARK_RIGHT_ANKLE, POSE_LANDMARK_RIGHT_HEEL, "우발길이"};
-
-  g_joint_connections[16] = (JointConnection){
-      POSE_LANDMARK_LEFT_WRIST, POSE_LANDMARK_LEFT_INDEX, "좌손길이"};
-  g_joint_connections[17] = (JointConnection){
-      POSE_LANDMARK_RIGHT_WRIST, POSE_LANDMARK_RIGHT_INDEX, "우손길이"};
-
-  g_joint_connections[18] = (JointConnection){
-      POSE_LANDMARK_LEFT_ANKLE, POSE_LANDMARK_LEFT_FOOT_INDEX, "좌발가락"};
-  g_joint_connections[19] = (JointConnection){
-      POSE_LANDMARK_RIGHT_ANKLE, POSE_LANDMARK_RIGHT_FOOT_INDEX, "우발가락"};
-
-  return 20; // 총 20개 연결
+  // 연결 테이블은 상수로 초기화되므로 개수만 반환
+  return JOINT_CONNECTION_COUNT;
 }
 
 float calculate_joint_distance(const PoseData *pose,
@@ -277,8 +267,7 @@ int segment_calibrate_joint_lengths(const PoseData *base_pose,
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // 관절 연결 관계 초기화
-  int connection_count = initialize_joint_connections();
+  int connection_count = JOINT_CONNECTION_COUNT;
 
   // 관절 길이 켈리브레이션 초기화
   out_calibration->joint_lengths.count = 0;
@@ -286,7 +275,7 @@ int segment_calibrate_joint_lengths(const PoseData *base_pose,
   printf("🔧 관절별 길이 켈리브레이션 시작...\n");
 
   for (int i = 0; i < connection_count; i++) {
-    JointConnection *conn = &g_joint_connections[i];
+    const JointConnection *conn = &g_joint_connections[i];
 
     // 사용자 관절 길이 계산
     float user_length =
@@ -345,46 +334,32 @@ int apply_joint_length_calibration(const PoseData *original_pose,
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // 원본 포즈 복사
-  *calibrated_pose = *original_pose;
+  // 골반 중심 기준 뼈 계층을 따라 관절별 길이 스케일 적용
+  RetargetSkeleton skeleton;
+  int result = retarget_skeleton_init(&skeleton, calibration);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
 
-  // 관절별 길이 켈리브레이션 적용
-  for (int i = 0; i < calibration->joint_lengths.count; i++) {
-    const JointLength *joint_length = &calibration->joint_lengths.lengths[i];
+  return retarget_pose(&skeleton, original_pose, calibrated_pose);
+}
 
-    if (!joint_length->is_valid) {
-      continue;
-    }
+int apply_joint_length_calibration_batch(const PoseData *original_poses,
+                                         const CalibrationData *calibration,
+                                         PoseData *calibrated_poses,
+                                         int count) {
+  if (!original_poses || !calibration || !calibrated_poses || count < 0) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
 
-    // 해당 관절 연결에 대한 스케일링 적용
-    // (실제 구현에서는 더 정교한 변환 필요)
-    // 여기서는 간단히 전체 스케일 팩터를 사용
-    PoseLandmarkType from_joint = g_joint_connections[i].from_joint;
-    PoseLandmarkType to_joint = g_joint_connections[i].to_joint;
-
-    // 관절 위치를 중심점 기준으로 스케일링
-    Point3D center = calculate_pose_center(original_pose);
-
-    // 시작 관절 스케일링
-    calibrated_pose->landmarks[from_joint].position.x =
-        center.x +
-        (original_pose->landmarks[from_joint].position.x - center.x) *
-            joint_length->scale_factor;
-    calibrated_pose->landmarks[from_joint].position.y =
-        center.y +
-        (original_pose->landmarks[from_joint].position.y - center.y) *
-            joint_length->scale_factor;
-
-    // 끝 관절 스케일링
-    calibrated_pose->landmarks[to_joint].position.x =
-        center.x + (original_pose->landmarks[to_joint].position.x - center.x) *
-                       joint_length->scale_factor;
-    calibrated_pose->landmarks[to_joint].position.y =
-        center.y + (original_pose->landmarks[to_joint].position.y - center.y) *
-                       joint_length->scale_factor;
+  // 뼈대 스케일은 한 번만 계산하고 워크아웃 전체에 재사용
+  RetargetSkeleton skeleton;
+  int result = retarget_skeleton_init(&skeleton, calibration);
+  if (result != SEGMENT_OK) {
+    return result;
   }
 
-  return SEGMENT_OK;
+  return retarget_poses(&skeleton, original_poses, calibrated_poses, count);
 }
 
 void print_joint_lengths(const CalibrationData *calibration) {
@@ -399,7 +374,7 @@ void print_joint_lengths(const CalibrationData *calibration) {
   for (int i = 0; i < calibration->joint_lengths.count; i++) {
     const JointLength *joint_length = &calibration->joint_lengths.lengths[i];
     int conn_idx = joint_length->connection_index; // 저장된 인덱스 사용 ⭐
-    JointConnection *conn = &g_joint_connections[conn_idx];
+    const JointConnection *conn = &g_joint_connections[conn_idx];
 
     if (joint_length->is_valid) {
       printf("  %s:\n", conn->name);
@@ -415,3 +390,375 @@ void print_joint_lengths(const CalibrationData *calibration) {
   printf("총 %d개 관절 연결이 켈리브레이션되었습니다.\n",
          calibration->joint_lengths.count);
 }
+
+// MARK: - 다중 프레임 캘리브레이션
+
+// 사분위 범위 / 중앙값 비율이 품질 점수에 미치는 가중치
+#define CALIBRATION_SPREAD_WEIGHT 10.0f
+
+// 품질 점수 항목별 가중치 (합 1.0). 가중 평균이므로 신뢰도가 높으면 일부
+// 관절만 보여도 segment_validate_calibration()의 0.5 기준을 넘습니다.
+#define CALIBRATION_RELIABILITY_WEIGHT 0.5f
+#define CALIBRATION_COVERAGE_WEIGHT 0.25f
+#define CALIBRATION_CONSISTENCY_WEIGHT 0.25f
+
+// 좌우 대칭 관절 연결 쌍 (g_joint_connections 인덱스)
+static const int g_symmetric_connections[][2] = {
+    {0, 2},   {1, 3},   {4, 6},   {5, 7},  {8, 9},
+    {12, 13}, {14, 15}, {16, 17}, {18, 19}};
+
+/**
+ * @brief 품질 항목(각 0.0~1.0)을 가중 평균해 품질 점수로 합침
+ * @param reliability 측정 신뢰도 (핵심 관절 신뢰도 또는 프레임 수용률)
+ * @param coverage 측정된 관절 연결 비율
+ * @param consistency 측정 일관성 (좌우 대칭성 또는 흔들림 기반 안정도)
+ */
+static float combine_calibration_quality(float reliability, float coverage,
+                                         float consistency) {
+  return CALIBRATION_RELIABILITY_WEIGHT * reliability +
+         CALIBRATION_COVERAGE_WEIGHT * coverage +
+         CALIBRATION_CONSISTENCY_WEIGHT * consistency;
+}
+
+static void p2_init(P2QuantileEstimator *estimator, float quantile) {
+  memset(estimator, 0, sizeof(P2QuantileEstimator));
+  estimator->quantile = quantile;
+}
+
+static void sort_floats(float *values, int count) {
+  for (int i = 1; i < count; i++) {
+    float value = values[i];
+    int j = i - 1;
+    while (j >= 0 && values[j] > value) {
+      values[j + 1] = values[j];
+      j--;
+    }
+    values[j + 1] = value;
+  }
+}
+
+static float p2_parabolic(const P2QuantileEstimator *e, int i, float d) {
+  const float *q = e->heights;
+  const float *n = e->positions;
+  return q[i] + d / (n[i + 1] - n[i - 1]) *
+                    ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) /
+                         (n[i + 1] - n[i]) +
+                     (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) /
+                         (n[i] - n[i - 1]));
+}
+
+static float p2_linear(const P2QuantileEstimator *e, int i, int d) {
+  return e->heights[i] + (float)d * (e->heights[i + d] - e->heights[i]) /
+                             (e->positions[i + d] - e->positions[i]);
+}
+
+static void p2_add(P2QuantileEstimator *e, float x) {
+  // 처음 5개 관측값으로 마커 초기화
+  if (e->count < 5) {
+    e->heights[e->count++] = x;
+    if (e->count == 5) {
+      float p = e->quantile;
+      sort_floats(e->heights, 5);
+      for (int i = 0; i < 5; i++) {
+        e->positions[i] = (float)(i + 1);
+      }
+      e->desired[0] = 1.0f;
+      e->desired[1] = 1.0f + 2.0f * p;
+      e->desired[2] = 1.0f + 4.0f * p;
+      e->desired[3] = 3.0f + 2.0f * p;
+      e->desired[4] = 5.0f;
+      e->increments[0] = 0.0f;
+      e->increments[1] = p / 2.0f;
+      e->increments[2] = p;
+      e->increments[3] = (1.0f + p) / 2.0f;
+      e->increments[4] = 1.0f;
+    }
+    return;
+  }
+
+  // 관측값이 속한 구간 찾기 (필요하면 양 끝 마커 확장)
+  int k;
+  if (x < e->heights[0]) {
+    e->heights[0] = x;
+    k = 0;
+  } else if (x >= e->heights[4]) {
+    e->heights[4] = x;
+    k = 3;
+  } else {
+    k = 0;
+    while (k < 3 && x >= e->heights[k + 1]) {
+      k++;
+    }
+  }
+
+  for (int i = k + 1; i < 5; i++) {
+    e->positions[i] += 1.0f;
+  }
+  for (int i = 0; i < 5; i++) {
+    e->desired[i] += e->increments[i];
+  }
+  e->count++;
+
+  // 가운데 마커를 목표 위치 쪽으로 조정
+  for (int i = 1; i <= 3; i++) {
+    float d = e->desired[i] - e->positions[i];
+    if ((d >= 1.0f && e->positions[i + 1] - e->positions[i] > 1.0f) ||
+        (d <= -1.0f && e->positions[i - 1] - e->positions[i] < -1.0f)) {
+      int step = (d >= 0.0f) ? 1 : -1;
+      float q = p2_parabolic(e, i, (float)step);
+      if (e->heights[i - 1] < q && q < e->heights[i + 1]) {
+        e->heights[i] = q;
+      } else {
+        e->heights[i] = p2_linear(e, i, step);
+      }
+      e->positions[i] += (float)step;
+    }
+  }
+}
+
+/**
+ * @brief marker번째 마커 값 (0~4, 관측값이 5개 미만이면 정렬된 표본에서 근사)
+ */
+static float p2_marker(const P2QuantileEstimator *e, int marker) {
+  if (e->count >= 5) {
+    return e->heights[marker];
+  }
+  if (e->count == 0) {
+    return 0.0f;
+  }
+
+  float sorted[5];
+  memcpy(sorted, e->heights, (size_t)e->count * sizeof(float));
+  sort_floats(sorted, e->count);
+  int index = (int)lroundf((float)marker / 4.0f * (float)(e->count - 1));
+  return sorted[index];
+}
+
+// 중앙값 대비 사분위 범위 (흔들림 정도)
+static float p2_relative_spread(const P2QuantileEstimator *e) {
+  float median = p2_marker(e, 2);
+  if (median <= 0.0f) {
+    return 0.0f;
+  }
+  return (p2_marker(e, 3) - p2_marker(e, 1)) / median;
+}
+
+int calibration_accumulator_init(CalibrationAccumulator *accumulator) {
+  if (!accumulator) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  memset(accumulator, 0, sizeof(CalibrationAccumulator));
+  p2_init(&accumulator->shoulder_width, 0.5f);
+  p2_init(&accumulator->center_x, 0.5f);
+  p2_init(&accumulator->center_y, 0.5f);
+  for (int i = 0; i < JOINT_CONNECTION_COUNT; i++) {
+    p2_init(&accumulator->bone_lengths[i], 0.5f);
+  }
+
+  return SEGMENT_OK;
+}
+
+int calibration_accumulator_add(CalibrationAccumulator *accumulator,
+                                const PoseData *pose) {
+  if (!accumulator || !pose) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  accumulator->frames_seen++;
+
+  // 단일 프레임 캘리브레이션과 같은 기준으로 프레임 거부
+  if (pose->landmarks[POSE_LANDMARK_LEFT_SHOULDER].inFrameLikelihood < 0.1f ||
+      pose->landmarks[POSE_LANDMARK_RIGHT_SHOULDER].inFrameLikelihood < 0.1f ||
+      pose->landmarks[POSE_LANDMARK_LEFT_HIP].inFrameLikelihood < 0.1f ||
+      pose->landmarks[POSE_LANDMARK_RIGHT_HIP].inFrameLikelihood < 0.1f) {
+    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  }
+
+  float shoulder_width =
+      distance_3d(&pose->landmarks[POSE_LANDMARK_LEFT_SHOULDER].position,
+                  &pose->landmarks[POSE_LANDMARK_RIGHT_SHOULDER].position);
+  if (shoulder_width <= 10.0f) {
+    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  }
+
+  accumulator->frames_accepted++;
+  p2_add(&accumulator->shoulder_width, shoulder_width);
+
+  Point3D center = calculate_pose_center(pose);
+  p2_add(&accumulator->center_x, center.x);
+  p2_add(&accumulator->center_y, center.y);
+
+  // 양 끝 관절이 모두 보이는 연결만 누적
+  for (int i = 0; i < JOINT_CONNECTION_COUNT; i++) {
+    const JointConnection *conn = &g_joint_connections[i];
+    if (pose->landmarks[conn->from_joint].inFrameLikelihood <
+            MIN_CONFIDENCE_THRESHOLD ||
+        pose->landmarks[conn->to_joint].inFrameLikelihood <
+            MIN_CONFIDENCE_THRESHOLD) {
+      continue;
+    }
+    p2_add(&accumulator->bone_lengths[i],
+           calculate_joint_distance(pose, conn->from_joint, conn->to_joint));
+  }
+
+  return SEGMENT_OK;
+}
+
+int calibration_accumulator_finalize(const CalibrationAccumulator *accumulator,
+                                     CalibrationData *out_calibration) {
+  if (!accumulator || !out_calibration) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  if (accumulator->frames_accepted < CALIBRATION_MIN_FRAMES) {
+    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  }
+
+  CalibrationData calibration;
+  memset(&calibration, 0, sizeof(CalibrationData));
+
+  float shoulder_width = p2_marker(&accumulator->shoulder_width, 2);
+  calibration.scale_factor = shoulder_width / IDEAL_SHOULDER_WIDTH;
+  if (calibration.scale_factor < 0.01f || calibration.scale_factor > 100.0f) {
+    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  }
+
+  Point3D ideal_center = calculate_pose_center(&g_ideal_base_pose);
+  calibration.center_offset.x =
+      ideal_center.x - p2_marker(&accumulator->center_x, 2);
+  calibration.center_offset.y =
+      ideal_center.y - p2_marker(&accumulator->center_y, 2);
+  calibration.center_offset.z = 0.0f;
+
+  float spread_sum = p2_relative_spread(&accumulator->shoulder_width);
+  int spread_count = 1;
+
+  for (int i = 0; i < JOINT_CONNECTION_COUNT; i++) {
+    const P2QuantileEstimator *bone = &accumulator->bone_lengths[i];
+    if (bone->count < CALIBRATION_MIN_BONE_SAMPLES) {
+      continue;
+    }
+
+    const JointConnection *conn = &g_joint_connections[i];
+    float user_length = p2_marker(bone, 2);
+    float ideal_length = calculate_joint_distance(
+        &g_ideal_base_pose, conn->from_joint, conn->to_joint);
+    if (ideal_length <= 0.0f) {
+      continue;
+    }
+
+    float scale_factor = user_length / ideal_length;
+    if (scale_factor < 0.1f || scale_factor > 10.0f) {
+      continue;
+    }
+
+    JointLength *joint_length =
+        &calibration.joint_lengths.lengths[calibration.joint_lengths.count++];
+    joint_length->connection_index = i;
+    joint_length->ideal_length = ideal_length;
+    joint_length->user_length = user_length;
+    joint_length->scale_factor = scale_factor;
+    joint_length->is_valid = true;
+
+    spread_sum += p2_relative_spread(bone);
+    spread_count++;
+  }
+
+  // 품질 = 프레임 수용률, 관절 커버리지, 측정 안정도의 가중 평균
+  float acceptance =
+      (float)accumulator->frames_accepted / (float)accumulator->frames_seen;
+  float coverage =
+      (float)calibration.joint_lengths.count / (float)JOINT_CONNECTION_COUNT;
+  float stability =
+      1.0f / (1.0f + CALIBRATION_SPREAD_WEIGHT * (spread_sum / spread_count));
+
+  calibration.is_calibrated = true;
+  calibration.calibration_quality =
+      combine_calibration_quality(acceptance, coverage, stability);
+
+  *out_calibration = calibration;
+  return SEGMENT_OK;
+}
+
+float calculate_calibration_quality(const PoseData *base_pose,
+                                    const CalibrationData *calibration) {
+  if (!base_pose || !calibration) {
+    return 0.0f;
+  }
+
+  // 핵심 관절 평균 신뢰도
+  float confidence =
+      (base_pose->landmarks[POSE_LANDMARK_LEFT_SHOULDER].inFrameLikelihood +
+       base_pose->landmarks[POSE_LANDMARK_RIGHT_SHOULDER].inFrameLikelihood +
+       base_pose->landmarks[POSE_LANDMARK_LEFT_HIP].inFrameLikelihood +
+       base_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].inFrameLikelihood) /
+      4.0f;
+  confidence = fminf(fmaxf(confidence, 0.0f), 1.0f);
+
+  // 관절 길이 커버리지
+  float coverage =
+      (float)calibration->joint_lengths.count / (float)JOINT_CONNECTION_COUNT;
+
+  // 좌우 관절 길이 대칭성 (한 프레임에서는 흔들림 대신 사용)
+  float user_lengths[JOINT_CONNECTION_COUNT] = {0};
+  for (int i = 0; i < calibration->joint_lengths.count; i++) {
+    const JointLength *joint_length = &calibration->joint_lengths.lengths[i];
+    if (joint_length->is_valid && joint_length->connection_index >= 0 &&
+        joint_length->connection_index < JOINT_CONNECTION_COUNT) {
+      user_lengths[joint_length->connection_index] = joint_length->user_length;
+    }
+  }
+
+  float symmetry_sum = 0.0f;
+  int symmetry_count = 0;
+  int pair_count = (int)(sizeof(g_symmetric_connections) /
+                         sizeof(g_symmetric_connections[0]));
+  for (int i = 0; i < pair_count; i++) {
+    float a = user_lengths[g_symmetric_connections[i][0]];
+    float b = user_lengths[g_symmetric_connections[i][1]];
+    if (a > 0.0f && b > 0.0f) {
+      symmetry_sum += fminf(a, b) / fmaxf(a, b);
+      symmetry_count++;
+    }
+  }
+  // 비교할 좌우 쌍이 없으면 감점하지 않음 (증거 없음은 실패가 아님)
+  float symmetry = (symmetry_count > 0) ? symmetry_sum / symmetry_count : 1.0f;
+
+  return combine_calibration_quality(confidence, coverage, symmetry);
+}
+
+static int validate_external_calibration(const CalibrationData *calibration) {
+  if (!calibration) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  if (!calibration->is_calibrated || calibration->scale_factor < 0.01f ||
+      calibration->scale_factor > 100.0f ||
+      calibration->joint_lengths.count < 0 ||
+      calibration->joint_lengths.count > JOINT_CONNECTION_COUNT) {
+    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  }
+
+  return SEGMENT_OK;
+}
+
+int segment_set_user_calibration(const CalibrationData *calibration) {
+  int result = validate_external_calibration(calibration);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  return commit_user_calibration(calibration);
+}
+
+int segment_set_recorder_calibration(const CalibrationData *calibration) {
+  int result = validate_external_calibration(calibration);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  g_recorder_calibration = *calibration;
+  g_recorder_calibrated = true;
+  return SEGMENT_OK;
+}
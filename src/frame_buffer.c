@@ -0,0 +1,171 @@
+/**
+ * @file frame_buffer.c
+ * @brief 지터 버퍼 및 타임스탬프 기반 리샘플링 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/frame_buffer.h"
+#include "../include/math_utils.h"
+#include <string.h>
+
+static uint64_t frame_time_us(const PoseData *pose) {
+  return pose->timestamp * 1000ULL;
+}
+
+// 가장 오래된 프레임부터 count개 제거
+static void drop_oldest_frames(FrameJitterBuffer *buffer, int count) {
+  if (count <= 0) {
+    return;
+  }
+  buffer->count -= count;
+  memmove(&buffer->frames[0], &buffer->frames[count],
+          buffer->count * sizeof(PoseData));
+}
+
+int frame_jitter_buffer_init(FrameJitterBuffer *buffer, float output_rate_hz,
+                             uint32_t delay_ms) {
+  if (!buffer || output_rate_hz <= 0.0f || output_rate_hz > 1000.0f) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  memset(buffer, 0, sizeof(FrameJitterBuffer));
+  buffer->interval_us = (uint64_t)(1000000.0f / output_rate_hz + 0.5f);
+  buffer->delay_us = (uint64_t)delay_ms * 1000ULL;
+
+  return SEGMENT_OK;
+}
+
+void frame_jitter_buffer_reset(FrameJitterBuffer *buffer) {
+  if (!buffer) {
+    return;
+  }
+
+  buffer->count = 0;
+  buffer->next_output_us = 0;
+  buffer->newest_timestamp = 0;
+  buffer->has_output = false;
+  buffer->has_emitted = false;
+  buffer->last_output_us = 0;
+}
+
+int frame_jitter_buffer_push(FrameJitterBuffer *buffer, const PoseData *pose) {
+  if (!buffer || !pose || buffer->interval_us == 0) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  uint64_t time_us = frame_time_us(pose);
+
+  // 이미 출력한 시각 이전에 도착한 프레임은 사용할 수 없음
+  if (buffer->has_emitted && time_us <= buffer->last_output_us) {
+    buffer->dropped_late_frames++;
+    return SEGMENT_OK;
+  }
+
+  // 삽입 위치 탐색 (대부분 순서대로 도착하므로 뒤에서부터)
+  int insert_at = buffer->count;
+  while (insert_at > 0 &&
+         buffer->frames[insert_at - 1].timestamp > pose->timestamp) {
+    insert_at--;
+  }
+
+  // 같은 타임스탬프의 중복 프레임
+  if (insert_at > 0 &&
+      buffer->frames[insert_at - 1].timestamp == pose->timestamp) {
+    buffer->dropped_late_frames++;
+    return SEGMENT_OK;
+  }
+
+  if (buffer->count == FRAME_JITTER_BUFFER_CAPACITY) {
+    if (insert_at == 0) {
+      // 가장 오래된 프레임보다 더 오래된 프레임
+      buffer->dropped_overflow_frames++;
+      return SEGMENT_OK;
+    }
+    drop_oldest_frames(buffer, 1);
+    insert_at--;
+    buffer->dropped_overflow_frames++;
+  }
+
+  memmove(&buffer->frames[insert_at + 1], &buffer->frames[insert_at],
+          (buffer->count - insert_at) * sizeof(PoseData));
+  buffer->frames[insert_at] = *pose;
+  buffer->count++;
+
+  if (pose->timestamp > buffer->newest_timestamp) {
+    buffer->newest_timestamp = pose->timestamp;
+  }
+
+  // 첫 출력 전에는 가장 오래된 프레임 시각부터 출력 시작
+  if (!buffer->has_emitted) {
+    buffer->next_output_us = frame_time_us(&buffer->frames[0]);
+    buffer->has_output = true;
+  }
+
+  return SEGMENT_OK;
+}
+
+bool frame_jitter_buffer_pop(FrameJitterBuffer *buffer, PoseData *out_pose) {
+  if (!buffer || !out_pose || !buffer->has_output || buffer->count == 0) {
+    return false;
+  }
+
+  uint64_t newest_us = buffer->newest_timestamp * 1000ULL;
+  if (newest_us < buffer->delay_us) {
+    return false;
+  }
+  uint64_t playout_us = newest_us - buffer->delay_us;
+
+  // 버퍼가 비었다가 다시 채워진 경우 첫 프레임 시각으로 재동기화
+  if (buffer->next_output_us < frame_time_us(&buffer->frames[0])) {
+    buffer->next_output_us = frame_time_us(&buffer->frames[0]);
+  }
+
+  uint64_t output_us = buffer->next_output_us;
+  if (output_us > playout_us) {
+    return false;
+  }
+
+  // output_us를 감싸는 두 프레임 찾기 (left <= output_us < right)
+  int left = 0;
+  while (left + 1 < buffer->count &&
+         frame_time_us(&buffer->frames[left + 1]) <= output_us) {
+    left++;
+  }
+
+  const PoseData *left_frame = &buffer->frames[left];
+  uint64_t left_us = frame_time_us(left_frame);
+
+  if (left_us == output_us) {
+    *out_pose = *left_frame;
+  } else {
+    if (left + 1 >= buffer->count) {
+      return false; // 오른쪽 프레임이 아직 도착하지 않음
+    }
+
+    const PoseData *right_frame = &buffer->frames[left + 1];
+    uint64_t right_us = frame_time_us(right_frame);
+
+    // 추적이 끊긴 긴 공백은 보간하지 않고 다음 프레임으로 건너뜀
+    if (right_us - left_us > (uint64_t)FRAME_JITTER_MAX_GAP_MS * 1000ULL) {
+      drop_oldest_frames(buffer, left + 1);
+      buffer->next_output_us = right_us;
+      return frame_jitter_buffer_pop(buffer, out_pose);
+    }
+
+    float t = (float)(output_us - left_us) / (float)(right_us - left_us);
+    interpolate_pose_3d(left_frame, right_frame, t, out_pose);
+  }
+
+  out_pose->timestamp = output_us / 1000ULL;
+
+  // 왼쪽 프레임은 다음 보간에 필요하므로 그 이전 프레임만 제거
+  drop_oldest_frames(buffer, left);
+
+  buffer->last_output_us = output_us;
+  buffer->next_output_us = output_us + buffer->interval_us;
+  buffer->has_emitted = true;
+  buffer->emitted_frames++;
+
+  return true;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file kinematics.c
+ * @brief 관절별 속도/가속도 및 세그먼트 템포 추적 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/kinematics.h"
+#include "../include/math_utils.h"
+#include <math.h>
+#include <string.h>
+
+int kinematics_tracker_init(KinematicsTracker *tracker, float smoothing) {
+  if (!tracker || smoothing <= 0.0f || smoothing > 1.0f) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  memset(tracker, 0, sizeof(KinematicsTracker));
+  tracker->smoothing = smoothing;
+  tracker->tempo_low = KINEMATICS_TEMPO_LOW;
+  tracker->tempo_high = KINEMATICS_TEMPO_HIGH;
+
+  return SEGMENT_OK;
+}
+
+void kinematics_tracker_reset(KinematicsTracker *tracker) {
+  if (!tracker) {
+    return;
+  }
+
+  float smoothing = tracker->smoothing;
+  float tempo_low = tracker->tempo_low;
+  float tempo_high = tracker->tempo_high;
+
+  memset(tracker, 0, sizeof(KinematicsTracker));
+  tracker->smoothing = smoothing;
+  tracker->tempo_low = tempo_low;
+  tracker->tempo_high = tempo_high;
+}
+
+// 진행도 기반 템포 상태 갱신 (~0 이탈 시각부터 ~1 도달 시각까지)
+static bool update_tempo(KinematicsTracker *tracker, uint64_t timestamp,
+                         float progress) {
+  if (progress < 0.0f) {
+    return false;
+  }
+
+  if (progress <= tracker->tempo_low) {
+    bool updated = false;
+    if (tracker->tempo_phase == 2) {
+      tracker->last_return_tempo_ms =
+          (float)(timestamp - tracker->high_timestamp);
+      updated = true;
+    }
+    tracker->tempo_phase = 1;
+    tracker->low_timestamp = timestamp;
+    return updated;
+  }
+
+  if (progress >= tracker->tempo_high) {
+    bool updated = false;
+    if (tracker->tempo_phase == 1) {
+      tracker->last_tempo_ms = (float)(timestamp - tracker->low_timestamp);
+      tracker->completed_reps++;
+      updated = true;
+    }
+    if (tracker->tempo_phase != 0) {
+      tracker->tempo_phase = 2;
+    }
+    tracker->high_timestamp = timestamp;
+    return updated;
+  }
+
+  return false;
+}
+
+static void fill_output(const KinematicsTracker *tracker, bool tempo_updated,
+                        KinematicsOutput *out) {
+  memcpy(out->velocity, tracker->velocity, sizeof(out->velocity));
+  memcpy(out->acceleration, tracker->acceleration, sizeof(out->acceleration));
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    const Point3D *v = &tracker->velocity[i];
+    out->speed[i] = sqrtf(v->x * v->x + v->y * v->y + v->z * v->z);
+  }
+
+  out->velocity_valid = tracker->frame_count >= 2;
+  out->acceleration_valid = tracker->frame_count >= 3;
+  out->last_tempo_ms = tracker->last_tempo_ms;
+  out->last_return_tempo_ms = tracker->last_return_tempo_ms;
+  out->completed_reps = tracker->completed_reps;
+  out->tempo_updated = tempo_updated;
+}
+
+int kinematics_tracker_update(KinematicsTracker *tracker, const PoseData *pose,
+                              float progress, KinematicsOutput *out) {
+  if (!tracker || !pose || !out || tracker->smoothing <= 0.0f) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 시간이 거꾸로 가거나 같은 프레임이면 상태 유지
+  if (tracker->frame_count > 0 &&
+      pose->timestamp <= tracker->previous_timestamp) {
+    fill_output(tracker, false, out);
+    return SEGMENT_OK;
+  }
+
+  Point3D hip_center = calculate_hip_center(pose);
+  float alpha = tracker->smoothing;
+  float dt = (tracker->frame_count > 0)
+                 ? (float)(pose->timestamp - tracker->previous_timestamp) /
+                       1000.0f
+                 : 0.0f;
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    Point3D relative = {pose->landmarks[i].position.x - hip_center.x,
+                        pose->landmarks[i].position.y - hip_center.y,
+                        pose->landmarks[i].position.z - hip_center.z};
+
+    if (tracker->frame_count > 0) {
+      Point3D *previous = &tracker->previous_relative[i];
+      Point3D raw_velocity = {(relative.x - previous->x) / dt,
+                              (relative.y - previous->y) / dt,
+                              (relative.z - previous->z) / dt};
+
+      Point3D *velocity = &tracker->velocity[i];
+      Point3D smoothed = raw_velocity;
+      if (tracker->frame_count > 1) {
+        smoothed.x = velocity->x + alpha * (raw_velocity.x - velocity->x);
+        smoothed.y = velocity->y + alpha * (raw_velocity.y - velocity->y);
+        smoothed.z = velocity->z + alpha * (raw_velocity.z - velocity->z);
+
+        Point3D *acceleration = &tracker->acceleration[i];
+        Point3D raw_acceleration = {(smoothed.x - velocity->x) / dt,
+                                    (smoothed.y - velocity->y) / dt,
+                                    (smoothed.z - velocity->z) / dt};
+        if (tracker->frame_count > 2) {
+          acceleration->x +=
+              alpha * (raw_acceleration.x - acceleration->x);
+          acceleration->y +=
+              alpha * (raw_acceleration.y - acceleration->y);
+          acceleration->z +=
+              alpha * (raw_acceleration.z - acceleration->z);
+        } else {
+          *acceleration = raw_acceleration;
+        }
+      }
+      *velocity = smoothed;
+    }
+
+    tracker->previous_relative[i] = relative;
+  }
+
+  tracker->previous_timestamp = pose->timestamp;
+  if (tracker->frame_count < 3) {
+    tracker->frame_count++;
+  }
+
+  bool tempo_updated = update_tempo(tracker, pose->timestamp, progress);
+  fill_output(tracker, tempo_updated, out);
+
+  return SEGMENT_OK;
+}
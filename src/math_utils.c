@@ -9,6 +9,10 @@
 #include <math.h>
 #include <string.h>
 
+// C99 표준 math.h에는 M_PI가 없으므로 직접 정의
+#define MATH_PI_F 3.14159265f
+#define MATH_HALF_PI_F 1.57079633f
+
 float distance_2d(const Point2D *p1, const Point2D *p2) {
   if (!p1 || !p2)
     return 0.0f;
@@ -114,30 +118,126 @@ Point2D calculate_center_point_selected(const PoseData *pose,
   return center;
 }
 
-void interpolate_pose(const PoseData *start, const PoseData *end, float t,
-                      PoseData *result) {
+Point3D calculate_hip_center(const PoseData *pose) {
+  Point3D center = {0.0f, 0.0f, 0.0f};
+
+  if (!pose)
+    return center;
+
+  const Point3D *left = &pose->landmarks[POSE_LANDMARK_LEFT_HIP].position;
+  const Point3D *right = &pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position;
+
+  center.x = (left->x + right->x) / 2.0f;
+  center.y = (left->y + right->y) / 2.0f;
+  center.z = (left->z + right->z) / 2.0f;
+
+  return center;
+}
+
+static const AnchorLadder g_anchor_ladders[] = {
+    [ANCHOR_TYPE_ANKLES] = {2,
+                            {{POSE_LANDMARK_LEFT_ANKLE,
+                              POSE_LANDMARK_RIGHT_ANKLE},
+                             {POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_RIGHT_HIP}}},
+    [ANCHOR_TYPE_HIPS] = {1,
+                          {{POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_RIGHT_HIP}}},
+    [ANCHOR_TYPE_SHOULDERS] = {2,
+                               {{POSE_LANDMARK_LEFT_SHOULDER,
+                                 POSE_LANDMARK_RIGHT_SHOULDER},
+                                {POSE_LANDMARK_LEFT_HIP,
+                                 POSE_LANDMARK_RIGHT_HIP}}}};
+
+const AnchorLadder *anchor_ladder_for(AnchorType type, ScaleMode scale_mode) {
+  if (type == ANCHOR_TYPE_AUTO) {
+    type = (scale_mode == SCALE_MODE_EXERCISE) ? ANCHOR_TYPE_ANKLES
+                                               : ANCHOR_TYPE_HIPS;
+  }
+
+  if (type < ANCHOR_TYPE_ANKLES || type > ANCHOR_TYPE_SHOULDERS) {
+    return NULL;
+  }
+  return &g_anchor_ladders[type];
+}
+
+bool resolve_anchor_point(const PoseData *pose, const AnchorLadder *ladder,
+                          Point3D *out_point) {
+  if (!pose || !ladder || !out_point) {
+    return false;
+  }
+
+  for (int g = 0; g < ladder->group_count; g++) {
+    const PoseLandmark *left = &pose->landmarks[ladder->groups[g].left];
+    const PoseLandmark *right = &pose->landmarks[ladder->groups[g].right];
+
+    // 신뢰도 마스크: 보이는 쪽만 가중치 1
+    float left_weight =
+        (left->inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE) ? 1.0f : 0.0f;
+    float right_weight =
+        (right->inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE) ? 1.0f : 0.0f;
+    float weight_sum = left_weight + right_weight;
+
+    if (weight_sum > 0.0f) {
+      out_point->x = (left_weight * left->position.x +
+                      right_weight * right->position.x) /
+                     weight_sum;
+      out_point->y = (left_weight * left->position.y +
+                      right_weight * right->position.y) /
+                     weight_sum;
+      out_point->z = (left_weight * left->position.z +
+                      right_weight * right->position.z) /
+                     weight_sum;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief 두 포즈 사이의 선형 보간 (interpolate_pose(), interpolate_pose_3d())
+ * @param blend_confidence true면 신뢰도도 t로 보간, false면 두 포즈의 평균
+ */
+static void interpolate_pose_landmarks(const PoseData *start,
+                                       const PoseData *end, float t,
+                                       bool blend_confidence,
+                                       PoseData *result) {
   if (!start || !end || !result)
     return;
 
   t = clamp(t, 0.0f, 1.0f);
 
   for (int i = 0; i < JOINT_COUNT; i++) {
+    const PoseLandmark *a = &start->landmarks[i];
+    const PoseLandmark *b = &end->landmarks[i];
+
     result->landmarks[i].position.x =
-        start->landmarks[i].position.x +
-        t * (end->landmarks[i].position.x - start->landmarks[i].position.x);
+        a->position.x + t * (b->position.x - a->position.x);
     result->landmarks[i].position.y =
-        start->landmarks[i].position.y +
-        t * (end->landmarks[i].position.y - start->landmarks[i].position.y);
-
-    // 신뢰도는 두 포즈의 평균으로 계산
+        a->position.y + t * (b->position.y - a->position.y);
+    result->landmarks[i].position.z =
+        a->position.z + t * (b->position.z - a->position.z);
     result->landmarks[i].inFrameLikelihood =
-        (start->landmarks[i].inFrameLikelihood +
-         end->landmarks[i].inFrameLikelihood) *
-        0.5f;
+        blend_confidence ? a->inFrameLikelihood +
+                               t * (b->inFrameLikelihood - a->inFrameLikelihood)
+                         : (a->inFrameLikelihood + b->inFrameLikelihood) * 0.5f;
   }
 
-  result->timestamp =
-      start->timestamp + (uint64_t)(t * (end->timestamp - start->timestamp));
+  // 순서가 뒤바뀐 타임스탬프는 부호 없는 차이가 순환하므로 0으로 제한
+  uint64_t duration = (end->timestamp > start->timestamp)
+                          ? end->timestamp - start->timestamp
+                          : 0;
+  result->timestamp = start->timestamp + (uint64_t)(t * (float)duration);
+}
+
+void interpolate_pose(const PoseData *start, const PoseData *end, float t,
+                      PoseData *result) {
+  // 신뢰도는 두 포즈의 평균으로 계산
+  interpolate_pose_landmarks(start, end, t, false, result);
+}
+
+void interpolate_pose_3d(const PoseData *start, const PoseData *end, float t,
+                         PoseData *result) {
+  interpolate_pose_landmarks(start, end, t, true, result);
 }
 
 float clamp(float value, float min, float max) {
@@ -160,6 +260,40 @@ float fast_sqrt(float x) {
   return sqrtf(x);
 }
 
+// 인라인 가능한 atan2 근사 본체 (일괄 버전의 루프 벡터화용)
+static inline float atan2_approx(float y, float x) {
+  float ax = fabsf(x);
+  float ay = fabsf(y);
+  // fmaxf/fminf 대신 비교 선택을 사용해야 루프가 벡터화됨
+  float max_v = (ax > ay) ? ax : ay;
+  float min_v = (ax > ay) ? ay : ax;
+  // 0~1 구간으로 접은 뒤 홀수 차수 미니맥스 다항식 ((0, 0)이면 z = 0)
+  float z = min_v / ((max_v > 0.0f) ? max_v : 1.0f);
+  float z2 = z * z;
+  float r =
+      z * (0.99997726f +
+           z2 * (-0.33262347f +
+                 z2 * (0.19354346f +
+                       z2 * (-0.11643287f +
+                             z2 * (0.05265332f + z2 * -0.01172120f)))));
+
+  r = (ay > ax) ? MATH_HALF_PI_F - r : r;
+  r = (x < 0.0f) ? MATH_PI_F - r : r;
+  return (y < 0.0f) ? -r : r;
+}
+
+float fast_atan2f(float y, float x) { return atan2_approx(y, x); }
+
+void fast_atan2f_batch(const float *y, const float *x, float *out,
+                       int count) {
+  if (!y || !x || !out)
+    return;
+
+  for (int i = 0; i < count; i++) {
+    out[i] = atan2_approx(y[i], x[i]);
+  }
+}
+
 void scale_pose(const PoseData *pose, float scale_factor, PoseData *result) {
   if (!pose || !result)
     return;
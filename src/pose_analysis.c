@@ -14,69 +14,108 @@
 // 최소 신뢰도 임계값
 #define MIN_CONFIDENCE_THRESHOLD 0.5f
 
-float calculate_segment_progress(const PoseData *current_pose,
-                                 const PoseData *start_pose,
-                                 const PoseData *end_pose,
-                                 const JointType *care_joints
-                                 __attribute__((unused)),
-                                 int care_joint_count __attribute__((unused))) {
-  if (!current_pose || !start_pose || !end_pose) {
-    return 0.0f;
+// 자주 쓰는 관절 집합 (joint_set_compile()과 같은 오름차순)
+static const uint8_t g_upper_body_joints[6] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST};
+
+static const uint8_t g_lower_body_joints[6] = {
+    POSE_LANDMARK_LEFT_HIP,   POSE_LANDMARK_RIGHT_HIP,
+    POSE_LANDMARK_LEFT_KNEE,  POSE_LANDMARK_RIGHT_KNEE,
+    POSE_LANDMARK_LEFT_ANKLE, POSE_LANDMARK_RIGHT_ANKLE};
+
+static const uint8_t g_main_body_joints[12] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
+    POSE_LANDMARK_LEFT_HIP,      POSE_LANDMARK_RIGHT_HIP,
+    POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
+    POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
+
+// care_joints가 없을 때의 기본 관절 (진행도: 어깨, 팔꿈치, 손목, 무릎, 발목)
+static const uint8_t g_default_progress_joints[10] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
+    POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
+    POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
+
+// care_joints가 없을 때의 기본 관절 (완료 판단: 어깨, 팔꿈치, 무릎)
+static const uint8_t g_default_completion_joints[6] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE};
+
+static const uint64_t g_upper_body_mask =
+    (1ULL << POSE_LANDMARK_LEFT_SHOULDER) |
+    (1ULL << POSE_LANDMARK_RIGHT_SHOULDER) |
+    (1ULL << POSE_LANDMARK_LEFT_ELBOW) | (1ULL << POSE_LANDMARK_RIGHT_ELBOW) |
+    (1ULL << POSE_LANDMARK_LEFT_WRIST) | (1ULL << POSE_LANDMARK_RIGHT_WRIST);
+
+static const uint64_t g_lower_body_mask =
+    (1ULL << POSE_LANDMARK_LEFT_HIP) | (1ULL << POSE_LANDMARK_RIGHT_HIP) |
+    (1ULL << POSE_LANDMARK_LEFT_KNEE) | (1ULL << POSE_LANDMARK_RIGHT_KNEE) |
+    (1ULL << POSE_LANDMARK_LEFT_ANKLE) | (1ULL << POSE_LANDMARK_RIGHT_ANKLE);
+
+int joint_set_compile(const JointType *care_joints, int care_joint_count,
+                      JointSet *out_set) {
+  if (!care_joints || care_joint_count <= 0 || !out_set) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // 골반 중심 기준 상대 좌표로 진행도 계산 (카메라 이동 무관)
+  uint64_t mask = 0;
+  for (int i = 0; i < care_joint_count; i++) {
+    int joint = (int)care_joints[i];
+    if (joint < 0 || joint >= POSE_LANDMARK_COUNT) {
+      return SEGMENT_ERROR_INVALID_PARAMETER;
+    }
+    mask |= 1ULL << joint;
+  }
 
-  // 1. 각 포즈의 골반 중심점 계산
-  Point3D current_hip_center = {
-      (current_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.x +
-       current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.x) /
-          2.0f,
-      (current_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.y +
-       current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.y) /
-          2.0f,
-      (current_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.z +
-       current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.z) /
-          2.0f};
+  // 중복을 제거한 오름차순 인덱스 목록
+  out_set->mask = mask;
+  out_set->count = 0;
+  for (int joint = 0; joint < POSE_LANDMARK_COUNT; joint++) {
+    if (mask & (1ULL << joint)) {
+      out_set->indices[out_set->count++] = (uint8_t)joint;
+    }
+  }
 
-  Point3D start_hip_center = {
-      (start_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.x +
-       start_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.x) /
-          2.0f,
-      (start_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.y +
-       start_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.y) /
-          2.0f,
-      (start_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.z +
-       start_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.z) /
-          2.0f};
+  if (mask == g_upper_body_mask) {
+    out_set->kind = JOINT_SET_UPPER_BODY;
+  } else if (mask == g_lower_body_mask) {
+    out_set->kind = JOINT_SET_LOWER_BODY;
+  } else if (mask == (g_upper_body_mask | g_lower_body_mask)) {
+    out_set->kind = JOINT_SET_MAIN;
+  } else {
+    out_set->kind = JOINT_SET_CUSTOM;
+  }
 
-  Point3D end_hip_center = {
-      (end_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.x +
-       end_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.x) /
-          2.0f,
-      (end_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.y +
-       end_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.y) /
-          2.0f,
-      (end_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.z +
-       end_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.z) /
-          2.0f};
+  return SEGMENT_OK;
+}
+
+/**
+ * @brief 주어진 관절 목록으로 진행도 계산
+ *
+ * 상수 관절 테이블로 호출되면 인라인되어 집합별 전용 루프가 됩니다.
+ */
+static inline float progress_over_joints(const PoseData *current_pose,
+                                         const PoseData *start_pose,
+                                         const PoseData *end_pose,
+                                         const uint8_t *joints, int count) {
+  // 골반 중심 기준 상대 좌표로 진행도 계산 (카메라 이동 무관)
+  Point3D current_hip_center = calculate_hip_center(current_pose);
+  Point3D start_hip_center = calculate_hip_center(start_pose);
+  Point3D end_hip_center = calculate_hip_center(end_pose);
 
-  // 2. 주요 관절들의 진행도 계산 (가중 평균 방식)
+  // 주요 관절들의 진행도 계산 (가중 평균 방식)
   // 많이 움직이는 관절에 더 큰 가중치를 부여
   float weighted_progress = 0.0f;
   float total_weight = 0.0f;
 
-  // 주요 관절들 (어깨, 팔꿈치, 손목, 무릎, 발목)
-  JointType main_joints[] = {
-      POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
-      POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
-      POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
-      POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
-      POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
-
-  int main_joint_count = sizeof(main_joints) / sizeof(main_joints[0]);
-
-  for (int i = 0; i < main_joint_count; i++) {
-    JointType joint = main_joints[i];
+  for (int i = 0; i < count; i++) {
+    JointType joint = (JointType)joints[i];
 
     // 신뢰도 확인
     if (current_pose->landmarks[joint].inFrameLikelihood <
@@ -144,49 +183,20 @@ float calculate_segment_progress(const PoseData *current_pose,
   return fmaxf(0.0f, fminf(1.0f, progress));
 }
 
-bool is_segment_completed(const PoseData *current_pose,
-                          const PoseData *end_pose,
-                          const JointType *care_joints __attribute__((unused)),
-                          int care_joint_count __attribute__((unused)),
-                          float threshold) {
-  if (!current_pose || !end_pose) {
-    return false;
-  }
-
+/**
+ * @brief 주어진 관절 목록으로 목표 포즈까지 평균 거리 계산
+ */
+static inline float average_distance_over_joints(const PoseData *current_pose,
+                                                 const PoseData *end_pose,
+                                                 const uint8_t *joints,
+                                                 int count) {
   // 골반 중심 기준 상대적 완료 판단
-  Point3D current_hip_center = {
-      (current_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.x +
-       current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.x) /
-          2.0f,
-      (current_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.y +
-       current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.y) /
-          2.0f,
-      (current_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.z +
-       current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.z) /
-          2.0f};
-
-  Point3D target_hip_center = {
-      (end_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.x +
-       end_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.x) /
-          2.0f,
-      (end_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.y +
-       end_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.y) /
-          2.0f,
-      (end_pose->landmarks[POSE_LANDMARK_LEFT_HIP].position.z +
-       end_pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position.z) /
-          2.0f};
+  Point3D current_hip_center = calculate_hip_center(current_pose);
+  Point3D target_hip_center = calculate_hip_center(end_pose);
 
   float total_distance = 0.0f;
-  int joint_count = 0;
-
-  // 주요 관절들
-  JointType main_joints[] = {
-      POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
-      POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
-      POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE};
-
-  for (int i = 0; i < 6; i++) {
-    JointType joint = main_joints[i];
+  for (int i = 0; i < count; i++) {
+    JointType joint = (JointType)joints[i];
 
     // 골반 기준 상대 좌표
     Point3D current_relative = {
@@ -199,16 +209,106 @@ bool is_segment_completed(const PoseData *current_pose,
         end_pose->landmarks[joint].position.y - target_hip_center.y,
         end_pose->landmarks[joint].position.z - target_hip_center.z};
 
-    float distance = distance_3d(&current_relative, &target_relative);
-    total_distance += distance;
-    joint_count++;
+    total_distance += distance_3d(&current_relative, &target_relative);
   }
 
-  if (joint_count == 0) {
+  return total_distance / count;
+}
+
+float calculate_segment_progress_set(const PoseData *current_pose,
+                                     const PoseData *start_pose,
+                                     const PoseData *end_pose,
+                                     const JointSet *joint_set) {
+  if (!current_pose || !start_pose || !end_pose || !joint_set ||
+      joint_set->count <= 0) {
+    return 0.0f;
+  }
+
+  switch (joint_set->kind) {
+  case JOINT_SET_UPPER_BODY:
+    return progress_over_joints(current_pose, start_pose, end_pose,
+                                g_upper_body_joints, 6);
+  case JOINT_SET_LOWER_BODY:
+    return progress_over_joints(current_pose, start_pose, end_pose,
+                                g_lower_body_joints, 6);
+  case JOINT_SET_MAIN:
+    return progress_over_joints(current_pose, start_pose, end_pose,
+                                g_main_body_joints, 12);
+  default:
+    return progress_over_joints(current_pose, start_pose, end_pose,
+                                joint_set->indices, joint_set->count);
+  }
+}
+
+float calculate_segment_progress(const PoseData *current_pose,
+                                 const PoseData *start_pose,
+                                 const PoseData *end_pose,
+                                 const JointType *care_joints,
+                                 int care_joint_count) {
+  if (!current_pose || !start_pose || !end_pose) {
+    return 0.0f;
+  }
+
+  JointSet joint_set;
+  if (care_joints && care_joint_count > 0 &&
+      joint_set_compile(care_joints, care_joint_count, &joint_set) ==
+          SEGMENT_OK) {
+    return calculate_segment_progress_set(current_pose, start_pose, end_pose,
+                                          &joint_set);
+  }
+
+  return progress_over_joints(current_pose, start_pose, end_pose,
+                              g_default_progress_joints, 10);
+}
+
+bool is_segment_completed_set(const PoseData *current_pose,
+                              const PoseData *end_pose,
+                              const JointSet *joint_set, float threshold) {
+  if (!current_pose || !end_pose || !joint_set || joint_set->count <= 0) {
     return false;
   }
 
-  float avg_distance = total_distance / joint_count;
+  float avg_distance;
+  switch (joint_set->kind) {
+  case JOINT_SET_UPPER_BODY:
+    avg_distance = average_distance_over_joints(current_pose, end_pose,
+                                                g_upper_body_joints, 6);
+    break;
+  case JOINT_SET_LOWER_BODY:
+    avg_distance = average_distance_over_joints(current_pose, end_pose,
+                                                g_lower_body_joints, 6);
+    break;
+  case JOINT_SET_MAIN:
+    avg_distance = average_distance_over_joints(current_pose, end_pose,
+                                                g_main_body_joints, 12);
+    break;
+  default:
+    avg_distance = average_distance_over_joints(
+        current_pose, end_pose, joint_set->indices, joint_set->count);
+    break;
+  }
+
+  return avg_distance <= threshold;
+}
+
+bool is_segment_completed(const PoseData *current_pose,
+                          const PoseData *end_pose,
+                          const JointType *care_joints, int care_joint_count,
+                          float threshold) {
+  if (!current_pose || !end_pose) {
+    return false;
+  }
+
+  JointSet joint_set;
+  if (care_joints && care_joint_count > 0 &&
+      joint_set_compile(care_joints, care_joint_count, &joint_set) ==
+          SEGMENT_OK) {
+    return is_segment_completed_set(current_pose, end_pose, &joint_set,
+                                    threshold);
+  }
+
+  float avg_distance = average_distance_over_joints(
+      current_pose, end_pose, g_default_completion_joints, 6);
   return avg_distance <= threshold;
 }
 
@@ -286,17 +386,322 @@ float segment_calculate_similarity(const PoseData *current_pose,
   return similarity;
 }
 
+// 관절 각도 정의 (끝점 A - 꼭짓점 - 끝점 B)
+static const JointType g_joint_angle_triplets[JOINT_ANGLE_COUNT][3] = {
+    {POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_LEFT_KNEE, POSE_LANDMARK_LEFT_ANKLE},
+    {POSE_LANDMARK_RIGHT_HIP, POSE_LANDMARK_RIGHT_KNEE,
+     POSE_LANDMARK_RIGHT_ANKLE},
+    {POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_HIP,
+     POSE_LANDMARK_LEFT_KNEE},
+    {POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_HIP,
+     POSE_LANDMARK_RIGHT_KNEE},
+    {POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_ELBOW,
+     POSE_LANDMARK_LEFT_WRIST},
+    {POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_ELBOW,
+     POSE_LANDMARK_RIGHT_WRIST},
+    {POSE_LANDMARK_LEFT_ELBOW, POSE_LANDMARK_LEFT_SHOULDER,
+     POSE_LANDMARK_LEFT_HIP},
+    {POSE_LANDMARK_RIGHT_ELBOW, POSE_LANDMARK_RIGHT_SHOULDER,
+     POSE_LANDMARK_RIGHT_HIP}};
+
+// 유사도 0이 되는 평균 각도 차이 (90°)
+#define ANGLE_SIMILARITY_SCALE 1.57079633f
+
+// 관절 각도의 atan2 입력 (|u×w|, u·w)을 SoA로 수집
+// 두 변을 먼저 SoA로 모은 뒤 계산 루프를 돌려야 sqrtf까지 SIMD로 벡터화됨
+static void collect_angle_terms(const PoseData *pose, float *cross_norm,
+                                float *dot) {
+  float ux[JOINT_ANGLE_COUNT], uy[JOINT_ANGLE_COUNT], uz[JOINT_ANGLE_COUNT];
+  float wx[JOINT_ANGLE_COUNT], wy[JOINT_ANGLE_COUNT], wz[JOINT_ANGLE_COUNT];
+  for (int i = 0; i < JOINT_ANGLE_COUNT; i++) {
+    const Point3D *a = &pose->landmarks[g_joint_angle_triplets[i][0]].position;
+    const Point3D *v = &pose->landmarks[g_joint_angle_triplets[i][1]].position;
+    const Point3D *b = &pose->landmarks[g_joint_angle_triplets[i][2]].position;
+    ux[i] = a->x - v->x;
+    uy[i] = a->y - v->y;
+    uz[i] = a->z - v->z;
+    wx[i] = b->x - v->x;
+    wy[i] = b->y - v->y;
+    wz[i] = b->z - v->z;
+  }
+
+  for (int i = 0; i < JOINT_ANGLE_COUNT; i++) {
+    float cx = uy[i] * wz[i] - uz[i] * wy[i];
+    float cy = uz[i] * wx[i] - ux[i] * wz[i];
+    float cz = ux[i] * wy[i] - uy[i] * wx[i];
+
+    cross_norm[i] = sqrtf(cx * cx + cy * cy + cz * cz);
+    dot[i] = ux[i] * wx[i] + uy[i] * wy[i] + uz[i] * wz[i];
+  }
+}
+
+void calculate_joint_angles(const PoseData *pose,
+                            float out_angles[JOINT_ANGLE_COUNT]) {
+  if (!pose || !out_angles) {
+    return;
+  }
+
+  float cross_norm[JOINT_ANGLE_COUNT];
+  float dot[JOINT_ANGLE_COUNT];
+  collect_angle_terms(pose, cross_norm, dot);
+  fast_atan2f_batch(cross_norm, dot, out_angles, JOINT_ANGLE_COUNT);
+}
+
+float segment_calculate_angle_similarity_cached(
+    const PoseData *current_pose,
+    const float target_angles[JOINT_ANGLE_COUNT]) {
+  if (!current_pose || !target_angles) {
+    return 0.0f;
+  }
+
+  float angles[JOINT_ANGLE_COUNT];
+  calculate_joint_angles(current_pose, angles);
+
+  float total_difference = 0.0f;
+  for (int i = 0; i < JOINT_ANGLE_COUNT; i++) {
+    total_difference += fabsf(angles[i] - target_angles[i]);
+  }
+
+  float avg_difference = total_difference / JOINT_ANGLE_COUNT;
+  return fmaxf(0.0f, 1.0f - (avg_difference / ANGLE_SIMILARITY_SCALE));
+}
+
+float segment_calculate_angle_similarity(const PoseData *current_pose,
+                                         const PoseData *target_pose) {
+  if (!current_pose || !target_pose) {
+    return 0.0f;
+  }
+
+  float target_angles[JOINT_ANGLE_COUNT];
+  calculate_joint_angles(target_pose, target_angles);
+  return segment_calculate_angle_similarity_cached(current_pose,
+                                                   target_angles);
+}
+
+const JointType g_mirror_landmarks[POSE_LANDMARK_COUNT] = {
+    POSE_LANDMARK_NOSE,
+    POSE_LANDMARK_RIGHT_EYE_INNER,  POSE_LANDMARK_RIGHT_EYE,
+    POSE_LANDMARK_RIGHT_EYE_OUTER,  POSE_LANDMARK_LEFT_EYE_INNER,
+    POSE_LANDMARK_LEFT_EYE,         POSE_LANDMARK_LEFT_EYE_OUTER,
+    POSE_LANDMARK_RIGHT_EAR,        POSE_LANDMARK_LEFT_EAR,
+    POSE_LANDMARK_MOUTH_RIGHT,      POSE_LANDMARK_MOUTH_LEFT,
+    POSE_LANDMARK_RIGHT_SHOULDER,   POSE_LANDMARK_LEFT_SHOULDER,
+    POSE_LANDMARK_RIGHT_ELBOW,      POSE_LANDMARK_LEFT_ELBOW,
+    POSE_LANDMARK_RIGHT_WRIST,      POSE_LANDMARK_LEFT_WRIST,
+    POSE_LANDMARK_RIGHT_PINKY,      POSE_LANDMARK_LEFT_PINKY,
+    POSE_LANDMARK_RIGHT_INDEX,      POSE_LANDMARK_LEFT_INDEX,
+    POSE_LANDMARK_RIGHT_THUMB,      POSE_LANDMARK_LEFT_THUMB,
+    POSE_LANDMARK_RIGHT_HIP,        POSE_LANDMARK_LEFT_HIP,
+    POSE_LANDMARK_RIGHT_KNEE,       POSE_LANDMARK_LEFT_KNEE,
+    POSE_LANDMARK_RIGHT_ANKLE,      POSE_LANDMARK_LEFT_ANKLE,
+    POSE_LANDMARK_RIGHT_HEEL,       POSE_LANDMARK_LEFT_HEEL,
+    POSE_LANDMARK_RIGHT_FOOT_INDEX, POSE_LANDMARK_LEFT_FOOT_INDEX};
+
+void mirror_pose(const PoseData *input, PoseData *output) {
+  if (!input || !output) {
+    return;
+  }
+
+  PoseData original = *input;
+  float axis_x = calculate_hip_center(&original).x;
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    PoseLandmark landmark = original.landmarks[g_mirror_landmarks[i]];
+    landmark.position.x = 2.0f * axis_x - landmark.position.x;
+    output->landmarks[i] = landmark;
+  }
+  output->timestamp = original.timestamp;
+}
+
+// segment_calculate_similarity()와 같은 관절, 좌우 짝이 인접하도록 배치
+// (반전 시 i번째 관절의 짝은 i ^ 1)
+static const JointType g_similarity_joints[10] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
+    POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
+    POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
+
+float segment_calculate_similarity_mirrored(const PoseData *current_pose,
+                                            const PoseData *target_pose,
+                                            bool *out_mirrored) {
+  if (out_mirrored) {
+    *out_mirrored = false;
+  }
+  if (!current_pose || !target_pose) {
+    return 0.0f;
+  }
+
+  Point3D current_hip_center = calculate_hip_center(current_pose);
+  Point3D target_hip_center = calculate_hip_center(target_pose);
+
+  // 골반 기준 상대 좌표를 한 번만 계산
+  float cx[10], cy[10], cz[10];
+  float tx[10], ty[10], tz[10];
+  for (int j = 0; j < 10; j++) {
+    const Point3D *c = &current_pose->landmarks[g_similarity_joints[j]].position;
+    const Point3D *t = &target_pose->landmarks[g_similarity_joints[j]].position;
+    cx[j] = c->x - current_hip_center.x;
+    cy[j] = c->y - current_hip_center.y;
+    cz[j] = c->z - current_hip_center.z;
+    tx[j] = t->x - target_hip_center.x;
+    ty[j] = t->y - target_hip_center.y;
+    tz[j] = t->z - target_hip_center.z;
+  }
+
+  // 같은 루프에서 원래 목표(앞 10개)와 반전 목표(뒤 10개)의 거리 계산
+  // 반전 목표의 j번째 관절 = 목표의 (j ^ 1)번째 관절, x 부호 반전
+  float distances[20];
+  for (int j = 0; j < 10; j++) {
+    int m = j ^ 1;
+    float dx = cx[j] - tx[j], dy = cy[j] - ty[j], dz = cz[j] - tz[j];
+    float mx = cx[j] + tx[m], my = cy[j] - ty[m], mz = cz[j] - tz[m];
+    distances[j] = dx * dx + dy * dy + dz * dz;
+    distances[10 + j] = mx * mx + my * my + mz * mz;
+  }
+
+  float direct_total = 0.0f;
+  float mirrored_total = 0.0f;
+  for (int j = 0; j < 10; j++) {
+    direct_total += sqrtf(distances[j]);
+    mirrored_total += sqrtf(distances[10 + j]);
+  }
+
+  bool mirrored = mirrored_total < direct_total;
+  if (out_mirrored) {
+    *out_mirrored = mirrored;
+  }
+
+  float avg_distance = (mirrored ? mirrored_total : direct_total) / 10.0f;
+  return fmaxf(0.0f, 1.0f - (avg_distance / 500.0f));
+}
+
+float segment_calculate_angle_similarity_mirrored_cached(
+    const PoseData *current_pose, const float target_angles[JOINT_ANGLE_COUNT],
+    bool *out_mirrored) {
+  if (out_mirrored) {
+    *out_mirrored = false;
+  }
+  if (!current_pose || !target_angles) {
+    return 0.0f;
+  }
+
+  float angles[JOINT_ANGLE_COUNT];
+  calculate_joint_angles(current_pose, angles);
+
+  // 각도 정의도 좌우 짝이 인접하므로 반전 목표의 i번째 각도 = (i ^ 1)번째
+  float direct_total = 0.0f;
+  float mirrored_total = 0.0f;
+  for (int i = 0; i < JOINT_ANGLE_COUNT; i++) {
+    direct_total += fabsf(angles[i] - target_angles[i]);
+    mirrored_total += fabsf(angles[i] - target_angles[i ^ 1]);
+  }
+
+  bool mirrored = mirrored_total < direct_total;
+  if (out_mirrored) {
+    *out_mirrored = mirrored;
+  }
+
+  float avg_difference =
+      (mirrored ? mirrored_total : direct_total) / JOINT_ANGLE_COUNT;
+  return fmaxf(0.0f, 1.0f - (avg_difference / ANGLE_SIMILARITY_SCALE));
+}
+
+float segment_calculate_angle_similarity_mirrored(const PoseData *current_pose,
+                                                  const PoseData *target_pose,
+                                                  bool *out_mirrored) {
+  if (out_mirrored) {
+    *out_mirrored = false;
+  }
+  if (!current_pose || !target_pose) {
+    return 0.0f;
+  }
+
+  float target_angles[JOINT_ANGLE_COUNT];
+  calculate_joint_angles(target_pose, target_angles);
+  return segment_calculate_angle_similarity_mirrored_cached(
+      current_pose, target_angles, out_mirrored);
+}
+
+/**
+ * @brief 주어진 관절 목록에만 교정 벡터 계산 (나머지는 호출자가 0으로 채움)
+ */
+static inline void corrections_over_joints(const PoseData *current_pose,
+                                           const PoseData *target_pose,
+                                           const uint8_t *joints, int count,
+                                           Point3D *corrections) {
+  for (int k = 0; k < count; k++) {
+    int i = joints[k];
+
+    // 신뢰도 확인
+    if (current_pose->landmarks[i].inFrameLikelihood <
+            MIN_CONFIDENCE_THRESHOLD ||
+        target_pose->landmarks[i].inFrameLikelihood <
+            MIN_CONFIDENCE_THRESHOLD) {
+      corrections[i] = (Point3D){0.0f, 0.0f, 0.0f};
+      continue;
+    }
+
+    // 교정 벡터 계산 (목표 - 현재), 실제 거리 정보 유지
+    corrections[i].x = target_pose->landmarks[i].position.x -
+                       current_pose->landmarks[i].position.x;
+    corrections[i].y = target_pose->landmarks[i].position.y -
+                       current_pose->landmarks[i].position.y;
+    corrections[i].z = target_pose->landmarks[i].position.z -
+                       current_pose->landmarks[i].position.z;
+  }
+}
+
+void calculate_correction_vectors_set(const PoseData *current_pose,
+                                      const PoseData *target_pose,
+                                      const JointSet *joint_set,
+                                      Point3D corrections[POSE_LANDMARK_COUNT]) {
+  if (!current_pose || !target_pose || !joint_set || !corrections) {
+    return;
+  }
+
+  // 집합에 없는 관절은 교정하지 않음
+  memset(corrections, 0, sizeof(Point3D) * POSE_LANDMARK_COUNT);
+
+  switch (joint_set->kind) {
+  case JOINT_SET_UPPER_BODY:
+    corrections_over_joints(current_pose, target_pose, g_upper_body_joints, 6,
+                            corrections);
+    break;
+  case JOINT_SET_LOWER_BODY:
+    corrections_over_joints(current_pose, target_pose, g_lower_body_joints, 6,
+                            corrections);
+    break;
+  case JOINT_SET_MAIN:
+    corrections_over_joints(current_pose, target_pose, g_main_body_joints, 12,
+                            corrections);
+    break;
+  default:
+    corrections_over_joints(current_pose, target_pose, joint_set->indices,
+                            joint_set->count, corrections);
+    break;
+  }
+}
+
 void calculate_correction_vectors(const PoseData *current_pose,
                                   const PoseData *target_pose,
-                                  const JointType *care_joints
-                                  __attribute__((unused)),
-                                  int care_joint_count __attribute__((unused)),
+                                  const JointType *care_joints,
+                                  int care_joint_count,
                                   Point3D corrections[POSE_LANDMARK_COUNT]) {
   if (!current_pose || !target_pose || !corrections) {
     return;
   }
 
-  // 모든 랜드마크에 대해 교정 벡터 계산
+  JointSet joint_set;
+  if (care_joints && care_joint_count > 0 &&
+      joint_set_compile(care_joints, care_joint_count, &joint_set) ==
+          SEGMENT_OK) {
+    calculate_correction_vectors_set(current_pose, target_pose, &joint_set,
+                                     corrections);
+    return;
+  }
+
+  // care_joints가 없으면 모든 랜드마크에 대해 교정 벡터 계산
   for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
     // 신뢰도 확인
     if (current_pose->landmarks[i].inFrameLikelihood <
@@ -307,24 +712,13 @@ void calculate_correction_vectors(const PoseData *current_pose,
       continue;
     }
 
-    // 교정 벡터 계산 (목표 - 현재)
+    // 교정 벡터 계산 (목표 - 현재), 실제 거리 정보 유지
     corrections[i].x = target_pose->landmarks[i].position.x -
                        current_pose->landmarks[i].position.x;
     corrections[i].y = target_pose->landmarks[i].position.y -
                        current_pose->landmarks[i].position.y;
     corrections[i].z = target_pose->landmarks[i].position.z -
                        current_pose->landmarks[i].position.z;
-
-    // 벡터 정규화 제거 - 실제 거리 정보 유지
-    // float magnitude = sqrtf(corrections[i].x * corrections[i].x +
-    //                         corrections[i].y * corrections[i].y +
-    //                         corrections[i].z * corrections[i].z);
-
-    // if (magnitude > 0.0f) {
-    //   corrections[i].x /= magnitude;
-    //   corrections[i].y /= magnitude;
-    //   corrections[i].z /= magnitude;
-    // }
   }
 }
 
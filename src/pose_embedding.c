@@ -0,0 +1,355 @@
+/**
+ * @file pose_embedding.c
+ * @brief 정규화된 포즈 임베딩 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/pose_embedding.h"
+#include "../include/math_utils.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#define POSE_EMBEDDING_F16C 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define POSE_EMBEDDING_NEON 1
+#endif
+
+const JointType g_pose_embedding_joints[POSE_EMBEDDING_JOINT_COUNT] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
+    POSE_LANDMARK_LEFT_HIP,      POSE_LANDMARK_RIGHT_HIP,
+    POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
+    POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
+
+int pose_embedding_compute(const PoseData *pose, float *out_embedding,
+                           float *out_torso_length) {
+  if (!pose || !out_embedding) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  Point3D hip_center = calculate_hip_center(pose);
+
+  float torso_length =
+      (distance_3d(&pose->landmarks[POSE_LANDMARK_LEFT_SHOULDER].position,
+                   &pose->landmarks[POSE_LANDMARK_LEFT_HIP].position) +
+       distance_3d(&pose->landmarks[POSE_LANDMARK_RIGHT_SHOULDER].position,
+                   &pose->landmarks[POSE_LANDMARK_RIGHT_HIP].position)) /
+      2.0f;
+  float inv_scale =
+      (torso_length > POSE_EMBEDDING_MIN_TORSO) ? 1.0f / torso_length : 1.0f;
+
+  for (int i = 0; i < POSE_EMBEDDING_JOINT_COUNT; i++) {
+    const Point3D *p = &pose->landmarks[g_pose_embedding_joints[i]].position;
+    out_embedding[i * 3 + 0] = (p->x - hip_center.x) * inv_scale;
+    out_embedding[i * 3 + 1] = (p->y - hip_center.y) * inv_scale;
+    out_embedding[i * 3 + 2] = (p->z - hip_center.z) * inv_scale;
+  }
+
+  if (out_torso_length) {
+    *out_torso_length = torso_length;
+  }
+
+  return SEGMENT_OK;
+}
+
+int pose_embedding_compute_batch(const PoseData *poses, int count,
+                                 float *out_embeddings) {
+  if (!poses || count < 0 || !out_embeddings) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  for (int i = 0; i < count; i++) {
+    pose_embedding_compute(
+        &poses[i], &out_embeddings[(size_t)i * POSE_EMBEDDING_DIMENSION],
+        NULL);
+  }
+
+  return SEGMENT_OK;
+}
+
+float pose_embedding_distance_sq(const float *a, const float *b) {
+  float sum = 0.0f;
+  for (int i = 0; i < POSE_EMBEDDING_DIMENSION; i++) {
+    float d = a[i] - b[i];
+    sum += d * d;
+  }
+  return sum;
+}
+
+float pose_embedding_distance(const float *a, const float *b) {
+  return sqrtf(pose_embedding_distance_sq(a, b));
+}
+
+// MARK: - float16 변환
+
+static uint16_t float_to_half(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  uint32_t sign = (bits >> 16) & 0x8000u;
+  uint32_t raw_exponent = (bits >> 23) & 0xffu;
+  uint32_t mantissa = bits & 0x7fffffu;
+
+  // Inf / NaN
+  if (raw_exponent == 0xffu) {
+    return (uint16_t)(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+  }
+
+  int32_t exponent = (int32_t)raw_exponent - 127 + 15;
+
+  // 표현 범위 초과는 Inf
+  if (exponent >= 31) {
+    return (uint16_t)(sign | 0x7c00u);
+  }
+
+  // 비정규화 수 또는 0
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return (uint16_t)sign;
+    }
+    mantissa |= 0x800000u;
+    uint32_t shift = (uint32_t)(14 - exponent);
+    uint32_t half_mantissa = mantissa >> shift;
+    uint32_t remainder = mantissa & ((1u << shift) - 1u);
+    uint32_t halfway = 1u << (shift - 1u);
+    if (remainder > halfway ||
+        (remainder == halfway && (half_mantissa & 1u))) {
+      half_mantissa++;
+    }
+    return (uint16_t)(sign | half_mantissa);
+  }
+
+  uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+  uint32_t remainder = mantissa & 0x1fffu;
+  // 반올림으로 가수가 넘치면 지수로 올라가므로 별도 처리 불필요
+  if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+    half++;
+  }
+  return (uint16_t)half;
+}
+
+static float half_to_float(uint16_t half) {
+  uint32_t sign = ((uint32_t)half & 0x8000u) << 16;
+  uint32_t exponent = ((uint32_t)half >> 10) & 0x1fu;
+  uint32_t mantissa = (uint32_t)half & 0x3ffu;
+  uint32_t bits;
+
+  if (exponent == 0) {
+    if (mantissa == 0) {
+      bits = sign;
+    } else {
+      // 비정규화 수를 정규화
+      int32_t e = 1;
+      while (!(mantissa & 0x400u)) {
+        mantissa <<= 1;
+        e--;
+      }
+      mantissa &= 0x3ffu;
+      bits = sign | ((uint32_t)(e + 112) << 23) | (mantissa << 13);
+    }
+  } else if (exponent == 31) {
+    bits = sign | 0x7f800000u | (mantissa << 13);
+  } else {
+    bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+  }
+
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void pose_embedding_to_half(const float *values, uint16_t *out_half,
+                            int count) {
+  if (!values || !out_half) {
+    return;
+  }
+
+  int i = 0;
+#if defined(POSE_EMBEDDING_F16C)
+  for (; i + 8 <= count; i += 8) {
+    __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(values + i),
+                                   _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128((__m128i *)(out_half + i), half);
+  }
+#elif defined(POSE_EMBEDDING_NEON)
+  for (; i + 4 <= count; i += 4) {
+    float16x4_t half = vcvt_f16_f32(vld1q_f32(values + i));
+    vst1_u16(out_half + i, vreinterpret_u16_f16(half));
+  }
+#endif
+  for (; i < count; i++) {
+    out_half[i] = float_to_half(values[i]);
+  }
+}
+
+void pose_embedding_from_half(const uint16_t *half, float *out_values,
+                              int count) {
+  if (!half || !out_values) {
+    return;
+  }
+
+  int i = 0;
+#if defined(POSE_EMBEDDING_F16C)
+  for (; i + 8 <= count; i += 8) {
+    __m128i packed = _mm_loadu_si128((const __m128i *)(half + i));
+    _mm256_storeu_ps(out_values + i, _mm256_cvtph_ps(packed));
+  }
+#elif defined(POSE_EMBEDDING_NEON)
+  for (; i + 4 <= count; i += 4) {
+    float16x4_t packed = vreinterpret_f16_u16(vld1_u16(half + i));
+    vst1q_f32(out_values + i, vcvt_f32_f16(packed));
+  }
+#endif
+  for (; i < count; i++) {
+    out_values[i] = half_to_float(half[i]);
+  }
+}
+
+// MARK: - float 임베딩 탐색
+
+// pose_embedding_distance_sq_half()와 같은 SIMD 구조로 계산해 float32/
+// float16 탐색의 차이가 저장 형식에서만 나오게 함
+static float distance_sq_simd(const float *query, const float *stored) {
+  int i = 0;
+  float sum = 0.0f;
+#if defined(POSE_EMBEDDING_F16C)
+  __m256 acc = _mm256_setzero_ps();
+  for (; i + 8 <= POSE_EMBEDDING_DIMENSION; i += 8) {
+    __m256 d = _mm256_sub_ps(_mm256_loadu_ps(query + i),
+                             _mm256_loadu_ps(stored + i));
+    acc = _mm256_add_ps(acc, _mm256_mul_ps(d, d));
+  }
+  __m128 acc4 = _mm_add_ps(_mm256_castps256_ps128(acc),
+                           _mm256_extractf128_ps(acc, 1));
+  for (; i + 4 <= POSE_EMBEDDING_DIMENSION; i += 4) {
+    __m128 d = _mm_sub_ps(_mm_loadu_ps(query + i), _mm_loadu_ps(stored + i));
+    acc4 = _mm_add_ps(acc4, _mm_mul_ps(d, d));
+  }
+  acc4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+  acc4 = _mm_add_ss(acc4, _mm_shuffle_ps(acc4, acc4, 1));
+  sum = _mm_cvtss_f32(acc4);
+#elif defined(POSE_EMBEDDING_NEON)
+  float32x4_t acc = vdupq_n_f32(0.0f);
+  for (; i + 4 <= POSE_EMBEDDING_DIMENSION; i += 4) {
+    float32x4_t d = vsubq_f32(vld1q_f32(query + i), vld1q_f32(stored + i));
+    acc = vmlaq_f32(acc, d, d);
+  }
+  sum = vaddvq_f32(acc);
+#else
+  for (; i < POSE_EMBEDDING_DIMENSION; i++) {
+    float d = query[i] - stored[i];
+    sum += d * d;
+  }
+#endif
+  return sum;
+}
+
+int pose_embedding_scan(const float *library, int count, const float *query,
+                        float *out_distances) {
+  if (!library || count <= 0 || !query) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  int best_index = 0;
+  float best_distance_sq = INFINITY;
+  for (int i = 0; i < count; i++) {
+    float distance_sq = distance_sq_simd(
+        query, &library[(size_t)i * POSE_EMBEDDING_DIMENSION]);
+    if (out_distances) {
+      out_distances[i] = sqrtf(distance_sq);
+    }
+    if (distance_sq < best_distance_sq) {
+      best_distance_sq = distance_sq;
+      best_index = i;
+    }
+  }
+  return best_index;
+}
+
+// MARK: - float16 임베딩 거리 (변환을 거리 계산에 합침)
+
+// SIMD 경로는 POSE_EMBEDDING_DIMENSION(36)이 4의 배수라 남는 원소가 없음
+float pose_embedding_distance_sq_half(const float *query,
+                                      const uint16_t *half) {
+  int i = 0;
+  float sum = 0.0f;
+#if defined(POSE_EMBEDDING_F16C)
+  __m256 acc = _mm256_setzero_ps();
+  for (; i + 8 <= POSE_EMBEDDING_DIMENSION; i += 8) {
+    __m256 stored =
+        _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(half + i)));
+    __m256 d = _mm256_sub_ps(_mm256_loadu_ps(query + i), stored);
+    acc = _mm256_add_ps(acc, _mm256_mul_ps(d, d));
+  }
+  __m128 acc4 = _mm_add_ps(_mm256_castps256_ps128(acc),
+                           _mm256_extractf128_ps(acc, 1));
+  for (; i + 4 <= POSE_EMBEDDING_DIMENSION; i += 4) {
+    __m128 stored =
+        _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *)(half + i)));
+    __m128 d = _mm_sub_ps(_mm_loadu_ps(query + i), stored);
+    acc4 = _mm_add_ps(acc4, _mm_mul_ps(d, d));
+  }
+  acc4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+  acc4 = _mm_add_ss(acc4, _mm_shuffle_ps(acc4, acc4, 1));
+  sum = _mm_cvtss_f32(acc4);
+#elif defined(POSE_EMBEDDING_NEON)
+  float32x4_t acc = vdupq_n_f32(0.0f);
+  for (; i + 4 <= POSE_EMBEDDING_DIMENSION; i += 4) {
+    float32x4_t stored =
+        vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(half + i)));
+    float32x4_t d = vsubq_f32(vld1q_f32(query + i), stored);
+    acc = vmlaq_f32(acc, d, d);
+  }
+  sum = vaddvq_f32(acc);
+#else
+  for (; i < POSE_EMBEDDING_DIMENSION; i++) {
+    float d = query[i] - half_to_float(half[i]);
+    sum += d * d;
+  }
+#endif
+  return sum;
+}
+
+float pose_embedding_distance_half(const float *query, const uint16_t *half) {
+  return sqrtf(pose_embedding_distance_sq_half(query, half));
+}
+
+int pose_embedding_scan_half(const uint16_t *library, int count,
+                             const float *query, float *out_distances) {
+  if (!library || count <= 0 || !query) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 제곱 거리로 비교하고 sqrt는 출력할 때만 계산
+  int best_index = 0;
+  float best_distance_sq = INFINITY;
+  for (int i = 0; i < count; i++) {
+    float distance_sq = pose_embedding_distance_sq_half(
+        query, &library[(size_t)i * POSE_EMBEDDING_DIMENSION]);
+    if (out_distances) {
+      out_distances[i] = sqrtf(distance_sq);
+    }
+    if (distance_sq < best_distance_sq) {
+      best_distance_sq = distance_sq;
+      best_index = i;
+    }
+  }
+  return best_index;
+}
+
+float pose_embedding_half_error_bound(const uint16_t *half) {
+  // 반올림 오차는 저장된 값의 반 ulp 이하: 정규화 수는 |h| * 2^-11,
+  // 비정규화 수와 0은 2^-25
+  float sum = 0.0f;
+  for (int i = 0; i < POSE_EMBEDDING_DIMENSION; i++) {
+    float e = fmaxf(fabsf(half_to_float(half[i])) * POSE_EMBEDDING_HALF_EPSILON,
+                    POSE_EMBEDDING_HALF_MIN_ERROR);
+    sum += e * e;
+  }
+  return sqrtf(sum);
+}
@@ -0,0 +1,549 @@
+/**
+ * @file pose_index.c
+ * @brief VP-tree 기반 최근접 포즈 검색 인덱스 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/pose_index.h"
+#include "../include/segment_memory.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 파일 포맷 식별자와 버전 (버전 2는 float16 임베딩)
+#define POSE_INDEX_MAGIC "ESPI"
+#define POSE_INDEX_VERSION 1u
+#define POSE_INDEX_VERSION_HALF 2u
+
+// VP-tree 노드 (노드 하나가 포즈 하나를 vantage point로 가짐)
+typedef struct {
+  int32_t item;      // vantage point 포즈 id
+  float threshold;   // 안쪽/바깥쪽을 나누는 거리
+  int32_t inside;    // 거리 <= threshold 인 하위 트리 (-1이면 없음)
+  int32_t outside;   // 거리 >= threshold 인 하위 트리 (-1이면 없음)
+} VPNode;
+
+struct PoseIndex {
+  int count;                 // 포즈 개수
+  int root;                  // 루트 노드 인덱스
+  float *embeddings;         // count x POSE_INDEX_DIMENSION (float32 인덱스)
+  uint16_t *half_embeddings; // count x POSE_INDEX_DIMENSION (float16 인덱스)
+  float error_bound;         // float16 저장으로 생긴 거리 오차 상한
+  VPNode *nodes;             // count개 노드
+};
+
+// 빌드 시 포즈 id와 vantage point까지의 거리를 함께 정렬하기 위한 구조체
+typedef struct {
+  int32_t item;
+  float distance;
+} BuildEntry;
+
+// 검색 중 유지하는 최대 힙 (가장 먼 결과가 루트)
+typedef struct {
+  PoseIndexMatch *matches;
+  int count;
+  int capacity;
+  float radius; // 검색 반경 상한
+} MatchHeap;
+
+static const float *index_embedding(const PoseIndex *index, int item) {
+  return &index->embeddings[(size_t)item * POSE_INDEX_DIMENSION];
+}
+
+static const uint16_t *index_half_embedding(const PoseIndex *index,
+                                            int item) {
+  return &index->half_embeddings[(size_t)item * POSE_INDEX_DIMENSION];
+}
+
+// 질의와 저장된 임베딩 사이의 거리 (float16이면 변환을 거리 계산에 합침)
+static float index_distance(const PoseIndex *index, const float *query,
+                            int item) {
+  if (index->half_embeddings) {
+    return pose_embedding_distance_half(query,
+                                        index_half_embedding(index, item));
+  }
+  return pose_embedding_distance(query, index_embedding(index, item));
+}
+
+// 저장된 임베딩의 float 값 (float16이면 buffer에 복원)
+static const float *index_vector(const PoseIndex *index, int item,
+                                 float *buffer) {
+  if (index->half_embeddings) {
+    pose_embedding_from_half(index_half_embedding(index, item), buffer,
+                             POSE_INDEX_DIMENSION);
+    return buffer;
+  }
+  return index_embedding(index, item);
+}
+
+// float16 인덱스의 항목별 오차 상한 중 최댓값
+static float compute_error_bound(const PoseIndex *index) {
+  float bound = 0.0f;
+  for (int i = 0; index->half_embeddings && i < index->count; i++) {
+    bound = fmaxf(bound, pose_embedding_half_error_bound(
+                             index_half_embedding(index, i)));
+  }
+  return bound;
+}
+
+// MARK: - 빌드
+
+// 간단한 xorshift 난수 (vantage point 선택용, 재현 가능한 빌드)
+static uint32_t next_random(uint32_t *state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+// entries[lo..hi) 에서 nth 위치의 원소를 거리 기준으로 제자리에 배치
+static void select_nth(BuildEntry *entries, int lo, int hi, int nth) {
+  while (hi - lo > 1) {
+    float pivot = entries[lo + (hi - lo) / 2].distance;
+    int i = lo;
+    int j = hi - 1;
+    while (i <= j) {
+      while (entries[i].distance < pivot)
+        i++;
+      while (entries[j].distance > pivot)
+        j--;
+      if (i <= j) {
+        BuildEntry tmp = entries[i];
+        entries[i] = entries[j];
+        entries[j] = tmp;
+        i++;
+        j--;
+      }
+    }
+    if (nth <= j) {
+      hi = j + 1;
+    } else if (nth >= i) {
+      lo = i;
+    } else {
+      return;
+    }
+  }
+}
+
+static int build_node(PoseIndex *index, BuildEntry *entries, int lo, int hi,
+                      int *next_node, uint32_t *rng) {
+  if (lo >= hi) {
+    return -1;
+  }
+
+  int node_id = (*next_node)++;
+  VPNode *node = &index->nodes[node_id];
+
+  // 임의의 vantage point를 맨 앞으로
+  int pick = lo + (int)(next_random(rng) % (uint32_t)(hi - lo));
+  BuildEntry tmp = entries[lo];
+  entries[lo] = entries[pick];
+  entries[pick] = tmp;
+
+  node->item = entries[lo].item;
+  node->threshold = 0.0f;
+  node->inside = -1;
+  node->outside = -1;
+
+  if (hi - lo == 1) {
+    return node_id;
+  }
+
+  float vantage_buffer[POSE_INDEX_DIMENSION];
+  const float *vantage = index_vector(index, node->item, vantage_buffer);
+  for (int i = lo + 1; i < hi; i++) {
+    entries[i].distance = index_distance(index, vantage, entries[i].item);
+  }
+
+  // 중앙값 거리로 안쪽/바깥쪽 분할
+  int median = (lo + 1 + hi) / 2;
+  select_nth(entries, lo + 1, hi, median);
+  node->threshold = entries[median].distance;
+
+  int inside = build_node(index, entries, lo + 1, median, next_node, rng);
+  int outside = build_node(index, entries, median, hi, next_node, rng);
+
+  // 재귀 중 nodes 배열 위치는 변하지 않으므로 다시 접근해도 안전
+  index->nodes[node_id].inside = inside;
+  index->nodes[node_id].outside = outside;
+
+  return node_id;
+}
+
+// 임베딩 배열(float32 또는 float16 중 하나)을 소유하는 인덱스를 만들고
+// 트리를 구성
+static int build_index(float *embeddings, uint16_t *half_embeddings,
+                       int count, PoseIndex **out_index) {
+
+  PoseIndex *index =
+      segment_mem_alloc(SEGMENT_MEMORY_INDEX, sizeof(PoseIndex));
+  if (!index) {
+    segment_mem_free(embeddings);
+    segment_mem_free(half_embeddings);
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  index->count = count;
+  index->root = -1;
+  index->embeddings = embeddings;
+  index->half_embeddings = half_embeddings;
+  index->error_bound = compute_error_bound(index);
+  index->nodes =
+      segment_mem_alloc(SEGMENT_MEMORY_INDEX, (size_t)count * sizeof(VPNode));
+  BuildEntry *entries = segment_mem_alloc(SEGMENT_MEMORY_INDEX,
+                                          (size_t)count * sizeof(BuildEntry));
+
+  if (!index->nodes || !entries) {
+    segment_mem_free(entries);
+    pose_index_destroy(index);
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  for (int i = 0; i < count; i++) {
+    entries[i].item = i;
+    entries[i].distance = 0.0f;
+  }
+
+  int next_node = 0;
+  uint32_t rng = 0x9E3779B9u;
+  index->root = build_node(index, entries, 0, count, &next_node, &rng);
+
+  segment_mem_free(entries);
+
+  *out_index = index;
+  return SEGMENT_OK;
+}
+
+// 임베딩 배열을 요청한 정밀도로 복사해 인덱스 생성
+static int build_with_precision(const float *embeddings, int count,
+                                PoseIndexPrecision precision,
+                                PoseIndex **out_index) {
+  size_t embedding_count = (size_t)count * POSE_INDEX_DIMENSION;
+
+  if (precision == POSE_INDEX_FLOAT16) {
+    uint16_t *half = segment_mem_alloc(SEGMENT_MEMORY_INDEX,
+                                       embedding_count * sizeof(uint16_t));
+    if (!half) {
+      return SEGMENT_ERROR_MEMORY_ALLOCATION;
+    }
+    pose_embedding_to_half(embeddings, half, (int)embedding_count);
+    return build_index(NULL, half, count, out_index);
+  }
+
+  float *copy =
+      segment_mem_alloc(SEGMENT_MEMORY_INDEX, embedding_count * sizeof(float));
+  if (!copy) {
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+  memcpy(copy, embeddings, embedding_count * sizeof(float));
+  return build_index(copy, NULL, count, out_index);
+}
+
+static bool is_valid_precision(PoseIndexPrecision precision) {
+  return precision == POSE_INDEX_FLOAT32 || precision == POSE_INDEX_FLOAT16;
+}
+
+int pose_index_build(const PoseData *poses, int count, PoseIndex **out_index) {
+  return pose_index_build_ex(poses, count, POSE_INDEX_FLOAT32, out_index);
+}
+
+int pose_index_build_ex(const PoseData *poses, int count,
+                        PoseIndexPrecision precision, PoseIndex **out_index) {
+  if (!poses || count <= 0 || !is_valid_precision(precision) || !out_index) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  float *embeddings =
+      segment_mem_alloc(SEGMENT_MEMORY_INDEX,
+                        (size_t)count * POSE_INDEX_DIMENSION * sizeof(float));
+  if (!embeddings) {
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  pose_embedding_compute_batch(poses, count, embeddings);
+  if (precision == POSE_INDEX_FLOAT32) {
+    return build_index(embeddings, NULL, count, out_index);
+  }
+
+  int result = build_with_precision(embeddings, count, precision, out_index);
+  segment_mem_free(embeddings);
+  return result;
+}
+
+int pose_index_build_from_embeddings(const float *embeddings, int count,
+                                     PoseIndex **out_index) {
+  return pose_index_build_from_embeddings_ex(embeddings, count,
+                                             POSE_INDEX_FLOAT32, out_index);
+}
+
+int pose_index_build_from_embeddings_ex(const float *embeddings, int count,
+                                        PoseIndexPrecision precision,
+                                        PoseIndex **out_index) {
+  if (!embeddings || count <= 0 || !is_valid_precision(precision) ||
+      !out_index) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  return build_with_precision(embeddings, count, precision, out_index);
+}
+
+void pose_index_destroy(PoseIndex *index) {
+  if (!index) {
+    return;
+  }
+
+  segment_mem_free(index->embeddings);
+  segment_mem_free(index->half_embeddings);
+  segment_mem_free(index->nodes);
+  segment_mem_free(index);
+}
+
+int pose_index_count(const PoseIndex *index) {
+  return index ? index->count : 0;
+}
+
+PoseIndexPrecision pose_index_precision(const PoseIndex *index) {
+  return (index && index->half_embeddings) ? POSE_INDEX_FLOAT16
+                                           : POSE_INDEX_FLOAT32;
+}
+
+float pose_index_distance_error_bound(const PoseIndex *index) {
+  return index ? index->error_bound : 0.0f;
+}
+
+// MARK: - 검색
+
+static float heap_bound(const MatchHeap *heap) {
+  if (heap->count < heap->capacity) {
+    return heap->radius;
+  }
+  return fminf(heap->radius, heap->matches[0].distance);
+}
+
+static void heap_push(MatchHeap *heap, int item, float distance) {
+  if (distance > heap_bound(heap)) {
+    return;
+  }
+
+  PoseIndexMatch *m = heap->matches;
+  int i;
+
+  if (heap->count < heap->capacity) {
+    // 위로 올리기
+    i = heap->count++;
+    while (i > 0) {
+      int parent = (i - 1) / 2;
+      if (m[parent].distance >= distance)
+        break;
+      m[i] = m[parent];
+      i = parent;
+    }
+  } else {
+    // 루트(가장 먼 결과)를 교체하고 아래로 내리기
+    i = 0;
+    for (;;) {
+      int child = 2 * i + 1;
+      if (child >= heap->count)
+        break;
+      if (child + 1 < heap->count && m[child + 1].distance > m[child].distance)
+        child++;
+      if (m[child].distance <= distance)
+        break;
+      m[i] = m[child];
+      i = child;
+    }
+  }
+
+  m[i].pose_id = item;
+  m[i].distance = distance;
+}
+
+static void search_node(const PoseIndex *index, int node_id,
+                        const float *query, MatchHeap *heap) {
+  while (node_id >= 0) {
+    const VPNode *node = &index->nodes[node_id];
+    float d = index_distance(index, query, node->item);
+    heap_push(heap, node->item, d);
+
+    if (node->inside < 0 && node->outside < 0) {
+      return;
+    }
+
+    // 가까운 쪽을 먼저 탐색하고, 먼 쪽은 경계 조건을 만족할 때만 탐색
+    if (d <= node->threshold) {
+      if (d - heap_bound(heap) <= node->threshold) {
+        search_node(index, node->inside, query, heap);
+      }
+      if (d + heap_bound(heap) >= node->threshold) {
+        node_id = node->outside;
+        continue;
+      }
+    } else {
+      if (d + heap_bound(heap) >= node->threshold) {
+        search_node(index, node->outside, query, heap);
+      }
+      if (d - heap_bound(heap) <= node->threshold) {
+        node_id = node->inside;
+        continue;
+      }
+    }
+    return;
+  }
+}
+
+static int compare_matches(const void *a, const void *b) {
+  float da = ((const PoseIndexMatch *)a)->distance;
+  float db = ((const PoseIndexMatch *)b)->distance;
+  return (da > db) - (da < db);
+}
+
+static int run_search(const PoseIndex *index, const PoseData *query,
+                      int capacity, float radius, PoseIndexMatch *out_matches,
+                      int *out_count) {
+  float embedding[POSE_INDEX_DIMENSION];
+  pose_embedding_compute(query, embedding, NULL);
+
+  MatchHeap heap = {out_matches, 0, capacity, radius};
+  search_node(index, index->root, embedding, &heap);
+
+  qsort(out_matches, heap.count, sizeof(PoseIndexMatch), compare_matches);
+  *out_count = heap.count;
+  return SEGMENT_OK;
+}
+
+int pose_index_knn(const PoseIndex *index, const PoseData *query, int k,
+                   PoseIndexMatch *out_matches, int *out_count) {
+  if (!index || !query || k <= 0 || !out_matches || !out_count) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  return run_search(index, query, k, FLT_MAX, out_matches, out_count);
+}
+
+int pose_index_radius(const PoseIndex *index, const PoseData *query,
+                      float radius, PoseIndexMatch *out_matches,
+                      int max_matches, int *out_count) {
+  if (!index || !query || radius < 0.0f || !out_matches || max_matches <= 0 ||
+      !out_count) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  return run_search(index, query, max_matches, radius, out_matches,
+                    out_count);
+}
+
+// MARK: - 직렬화
+
+int pose_index_save(const PoseIndex *index, const char *file_path) {
+  if (!index || !file_path) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  FILE *file = fopen(file_path, "wb");
+  if (!file) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // float32 인덱스는 기존 버전 1 형식 그대로 저장
+  bool is_half = index->half_embeddings != NULL;
+  uint32_t header[4] = {is_half ? POSE_INDEX_VERSION_HALF : POSE_INDEX_VERSION,
+                        (uint32_t)index->count, (uint32_t)POSE_INDEX_DIMENSION,
+                        (uint32_t)index->root};
+  size_t embedding_count = (size_t)index->count * POSE_INDEX_DIMENSION;
+  const void *embeddings =
+      is_half ? (const void *)index->half_embeddings : index->embeddings;
+  size_t element_size = is_half ? sizeof(uint16_t) : sizeof(float);
+
+  bool ok = fwrite(POSE_INDEX_MAGIC, 1, 4, file) == 4 &&
+            fwrite(header, sizeof(uint32_t), 4, file) == 4 &&
+            fwrite(embeddings, element_size, embedding_count, file) ==
+                embedding_count &&
+            fwrite(index->nodes, sizeof(VPNode), index->count, file) ==
+                (size_t)index->count;
+
+  if (fclose(file) != 0) {
+    ok = false;
+  }
+
+  return ok ? SEGMENT_OK : SEGMENT_ERROR_INVALID_PARAMETER;
+}
+
+int pose_index_load(const char *file_path, PoseIndex **out_index) {
+  if (!file_path || !out_index) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  FILE *file = fopen(file_path, "rb");
+  if (!file) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  char magic[4];
+  uint32_t header[4];
+  if (fread(magic, 1, 4, file) != 4 ||
+      memcmp(magic, POSE_INDEX_MAGIC, 4) != 0 ||
+      fread(header, sizeof(uint32_t), 4, file) != 4 ||
+      (header[0] != POSE_INDEX_VERSION &&
+       header[0] != POSE_INDEX_VERSION_HALF) ||
+      header[1] == 0 ||
+      header[1] > INT32_MAX / POSE_INDEX_DIMENSION ||
+      header[2] != POSE_INDEX_DIMENSION || header[3] >= header[1]) {
+    fclose(file);
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  PoseIndex *index =
+      segment_mem_alloc(SEGMENT_MEMORY_INDEX, sizeof(PoseIndex));
+  if (!index) {
+    fclose(file);
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  bool is_half = header[0] == POSE_INDEX_VERSION_HALF;
+  size_t element_size = is_half ? sizeof(uint16_t) : sizeof(float);
+  index->count = (int)header[1];
+  index->root = (int)header[3];
+  size_t embedding_count = (size_t)index->count * POSE_INDEX_DIMENSION;
+  void *embeddings =
+      segment_mem_alloc(SEGMENT_MEMORY_INDEX, embedding_count * element_size);
+  index->embeddings = is_half ? NULL : embeddings;
+  index->half_embeddings = is_half ? embeddings : NULL;
+  index->error_bound = 0.0f;
+  index->nodes = segment_mem_alloc(SEGMENT_MEMORY_INDEX,
+                                   (size_t)index->count * sizeof(VPNode));
+
+  if (!embeddings || !index->nodes) {
+    fclose(file);
+    pose_index_destroy(index);
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  bool ok = fread(embeddings, element_size, embedding_count, file) ==
+                embedding_count &&
+            fread(index->nodes, sizeof(VPNode), index->count, file) ==
+                (size_t)index->count;
+  fclose(file);
+
+  // 손상된 파일로 인한 범위 밖 접근 방지
+  for (int i = 0; ok && i < index->count; i++) {
+    const VPNode *node = &index->nodes[i];
+    ok = node->item >= 0 && node->item < index->count &&
+         node->inside < index->count && node->outside < index->count &&
+         (node->inside < 0 || node->inside > i) &&
+         (node->outside < 0 || node->outside > i);
+  }
+
+  if (!ok) {
+    pose_index_destroy(index);
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  index->error_bound = compute_error_bound(index);
+  *out_index = index;
+  return SEGMENT_OK;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file pose_quant.c
+ * @brief 키포즈 양자화 저장 형식 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/pose_quant.h"
+#include <math.h>
+#include <string.h>
+
+// 신뢰도 양자화 단계 수
+#define POSE_QUANT_CONFIDENCE_STEPS 255.0f
+
+// 범위 [min, max]를 코드 [-MAX, MAX]에 맞추는 축 하나의 계수
+static void axis_params(float min_value, float max_value, float *out_offset,
+                        float *out_scale) {
+  *out_offset = 0.5f * (min_value + max_value);
+  float half_range = 0.5f * (max_value - min_value);
+  // 범위가 0이면 모든 값이 offset이므로 scale은 아무 값이나 됨
+  *out_scale = (half_range > 0.0f) ? half_range / POSE_QUANT_MAX_CODE : 1.0f;
+}
+
+void pose_quant_params_from_bounds(const Point3D *min_value,
+                                   const Point3D *max_value,
+                                   PoseQuantParams *out_params) {
+  axis_params(min_value->x, max_value->x, &out_params->offset.x,
+              &out_params->scale.x);
+  axis_params(min_value->y, max_value->y, &out_params->offset.y,
+              &out_params->scale.y);
+  axis_params(min_value->z, max_value->z, &out_params->offset.z,
+              &out_params->scale.z);
+}
+
+int pose_quant_params_compute(const PoseData *poses, int count,
+                              PoseQuantParams *out_params) {
+  if (!poses || count <= 0 || !out_params) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  Point3D min_value = poses[0].landmarks[0].position;
+  Point3D max_value = min_value;
+  for (int p = 0; p < count; p++) {
+    for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+      const Point3D *v = &poses[p].landmarks[i].position;
+      min_value.x = fminf(min_value.x, v->x);
+      min_value.y = fminf(min_value.y, v->y);
+      min_value.z = fminf(min_value.z, v->z);
+      max_value.x = fmaxf(max_value.x, v->x);
+      max_value.y = fmaxf(max_value.y, v->y);
+      max_value.z = fmaxf(max_value.z, v->z);
+    }
+  }
+
+  pose_quant_params_from_bounds(&min_value, &max_value, out_params);
+  return SEGMENT_OK;
+}
+
+int16_t pose_quant_encode(float value, float offset, float scale) {
+  float code = roundf((value - offset) / scale);
+  if (!(code > -POSE_QUANT_MAX_CODE)) {
+    return -POSE_QUANT_MAX_CODE; // NaN 포함
+  }
+  if (code > POSE_QUANT_MAX_CODE) {
+    return POSE_QUANT_MAX_CODE;
+  }
+  return (int16_t)code;
+}
+
+void pose_quantize(const PoseData *pose, const PoseQuantParams *params,
+                   QuantizedPose *out_pose) {
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    const PoseLandmark *in = &pose->landmarks[i];
+    QuantizedLandmark *out = &out_pose->landmarks[i];
+
+    out->x = pose_quant_encode(in->position.x, params->offset.x,
+                               params->scale.x);
+    out->y = pose_quant_encode(in->position.y, params->offset.y,
+                               params->scale.y);
+    out->z = pose_quant_encode(in->position.z, params->offset.z,
+                               params->scale.z);
+
+    float confidence = fminf(fmaxf(in->inFrameLikelihood, 0.0f), 1.0f);
+    out->confidence =
+        (uint8_t)lroundf(confidence * POSE_QUANT_CONFIDENCE_STEPS);
+    out->reserved = 0;
+  }
+  out_pose->timestamp = pose->timestamp;
+}
+
+void pose_dequantize(const QuantizedPose *pose, const PoseQuantParams *params,
+                     PoseData *out_pose) {
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    const QuantizedLandmark *in = &pose->landmarks[i];
+    PoseLandmark *out = &out_pose->landmarks[i];
+
+    out->position.x = params->offset.x + in->x * params->scale.x;
+    out->position.y = params->offset.y + in->y * params->scale.y;
+    out->position.z = params->offset.z + in->z * params->scale.z;
+    out->inFrameLikelihood = in->confidence / POSE_QUANT_CONFIDENCE_STEPS;
+  }
+  out_pose->timestamp = pose->timestamp;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file retarget.c
+ * @brief 뼈대 계층 기반 관절 길이 리타게팅 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/retarget.h"
+#include "../include/math_utils.h"
+#include <string.h>
+
+// 위상 순서 뼈 계층 (connection_index는 calibration.c의 g_joint_connections)
+static const RetargetBone g_retarget_bones[RETARGET_BONE_COUNT] = {
+    // 골반 (골반너비)
+    {RETARGET_ROOT, POSE_LANDMARK_LEFT_HIP, 11},
+    {RETARGET_ROOT, POSE_LANDMARK_RIGHT_HIP, 11},
+    // 상체 (좌/우 상체)
+    {POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_LEFT_SHOULDER, 8},
+    {POSE_LANDMARK_RIGHT_HIP, POSE_LANDMARK_RIGHT_SHOULDER, 9},
+    // 팔 (상완, 전완)
+    {POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_LEFT_ELBOW, 0},
+    {POSE_LANDMARK_LEFT_ELBOW, POSE_LANDMARK_LEFT_WRIST, 1},
+    {POSE_LANDMARK_RIGHT_SHOULDER, POSE_LANDMARK_RIGHT_ELBOW, 2},
+    {POSE_LANDMARK_RIGHT_ELBOW, POSE_LANDMARK_RIGHT_WRIST, 3},
+    // 손 (손길이)
+    {POSE_LANDMARK_LEFT_WRIST, POSE_LANDMARK_LEFT_INDEX, 16},
+    {POSE_LANDMARK_LEFT_WRIST, POSE_LANDMARK_LEFT_PINKY, 16},
+    {POSE_LANDMARK_LEFT_WRIST, POSE_LANDMARK_LEFT_THUMB, 16},
+    {POSE_LANDMARK_RIGHT_WRIST, POSE_LANDMARK_RIGHT_INDEX, 17},
+    {POSE_LANDMARK_RIGHT_WRIST, POSE_LANDMARK_RIGHT_PINKY, 17},
+    {POSE_LANDMARK_RIGHT_WRIST, POSE_LANDMARK_RIGHT_THUMB, 17},
+    // 다리 (대퇴, 정강)
+    {POSE_LANDMARK_LEFT_HIP, POSE_LANDMARK_LEFT_KNEE, 4},
+    {POSE_LANDMARK_LEFT_KNEE, POSE_LANDMARK_LEFT_ANKLE, 5},
+    {POSE_LANDMARK_RIGHT_HIP, POSE_LANDMARK_RIGHT_KNEE, 6},
+    {POSE_LANDMARK_RIGHT_KNEE, POSE_LANDMARK_RIGHT_ANKLE, 7},
+    // 발 (발길이, 발가락)
+    {POSE_LANDMARK_LEFT_ANKLE, POSE_LANDMARK_LEFT_HEEL, 14},
+    {POSE_LANDMARK_LEFT_ANKLE, POSE_LANDMARK_LEFT_FOOT_INDEX, 18},
+    {POSE_LANDMARK_RIGHT_ANKLE, POSE_LANDMARK_RIGHT_HEEL, 15},
+    {POSE_LANDMARK_RIGHT_ANKLE, POSE_LANDMARK_RIGHT_FOOT_INDEX, 19},
+    // 머리 (목-좌어깨), 얼굴은 코 스케일 상속
+    {POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_NOSE, 12},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_LEFT_EYE_INNER, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_LEFT_EYE, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_LEFT_EYE_OUTER, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_RIGHT_EYE_INNER, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_RIGHT_EYE, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_RIGHT_EYE_OUTER, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_LEFT_EAR, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_RIGHT_EAR, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_MOUTH_LEFT, -1},
+    {POSE_LANDMARK_NOSE, POSE_LANDMARK_MOUTH_RIGHT, -1}};
+
+// 모든 뼈가 루트 위치와 같은 스케일이면 계층 순회 없이 아핀 변환과 같음
+static bool skeleton_is_uniform(const RetargetSkeleton *skeleton) {
+  for (int b = 0; b < RETARGET_BONE_COUNT; b++) {
+    if (skeleton->scales[b] != skeleton->root_position_scale) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int retarget_skeleton_init(RetargetSkeleton *skeleton,
+                           const CalibrationData *calibration) {
+  return retarget_skeleton_init_scaled(skeleton, calibration, 1.0f);
+}
+
+int retarget_skeleton_init_scaled(RetargetSkeleton *skeleton,
+                                  const CalibrationData *calibration,
+                                  float root_scale) {
+  if (!skeleton || root_scale <= 0.0f) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 연결 인덱스별 스케일 (측정되지 않은 연결은 0)
+  float connection_scales[JOINT_CONNECTION_COUNT] = {0};
+  if (calibration) {
+    int count = calibration->joint_lengths.count;
+    if (count < 0 || count > JOINT_CONNECTION_COUNT) {
+      return SEGMENT_ERROR_INVALID_PARAMETER;
+    }
+    for (int i = 0; i < count; i++) {
+      const JointLength *joint_length = &calibration->joint_lengths.lengths[i];
+      int index = joint_length->connection_index;
+      if (joint_length->is_valid && index >= 0 &&
+          index < JOINT_CONNECTION_COUNT &&
+          joint_length->scale_factor > 0.0f) {
+        connection_scales[index] = joint_length->scale_factor;
+      }
+    }
+  }
+
+  // 자식 관절 기준 뼈 스케일 (상속 계산용)
+  float landmark_scales[POSE_LANDMARK_COUNT];
+
+  memcpy(skeleton->bones, g_retarget_bones, sizeof(g_retarget_bones));
+  for (int b = 0; b < RETARGET_BONE_COUNT; b++) {
+    const RetargetBone *bone = &skeleton->bones[b];
+    float inherited =
+        (bone->parent == RETARGET_ROOT) ? root_scale
+                                        : landmark_scales[bone->parent];
+    float scale = (bone->connection_index >= 0 &&
+                   connection_scales[bone->connection_index] > 0.0f)
+                      ? connection_scales[bone->connection_index]
+                      : inherited;
+
+    skeleton->scales[b] = scale;
+    landmark_scales[bone->child] = scale;
+  }
+
+  skeleton->root_position_scale = 1.0f;
+  skeleton->root_offset = (Point3D){0.0f, 0.0f, 0.0f};
+  skeleton->uniform = skeleton_is_uniform(skeleton);
+  return SEGMENT_OK;
+}
+
+int retarget_skeleton_init_uniform(RetargetSkeleton *skeleton, float scale,
+                                   const Point3D *offset) {
+  if (!offset) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 측정값이 없으면 모든 뼈가 루트 스케일을 상속
+  int result = retarget_skeleton_init_scaled(skeleton, NULL, scale);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  skeleton->root_position_scale = scale;
+  skeleton->root_offset = *offset;
+  skeleton->uniform = true;
+  return SEGMENT_OK;
+}
+
+// 균일 뼈대: 부모 체인 없이 랜드마크마다 position * scale + offset
+// (계층 순회와 수학적으로 같고, 뼈 체인을 따라 반올림 오차가 쌓이지 않음)
+static void retarget_one_uniform(const RetargetSkeleton *skeleton,
+                                 const PoseData *input, PoseData *output) {
+  const float scale = skeleton->root_position_scale;
+  const Point3D offset = skeleton->root_offset;
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    const PoseLandmark *in = &input->landmarks[i];
+    PoseLandmark *out = &output->landmarks[i];
+    out->position.x = in->position.x * scale + offset.x;
+    out->position.y = in->position.y * scale + offset.y;
+    out->position.z = in->position.z * scale + offset.z;
+    out->inFrameLikelihood = in->inFrameLikelihood;
+  }
+}
+
+// 포즈 하나를 뼈 위상 순서로 리타게팅 (부모 위치는 output에서 읽음)
+static void retarget_one(const RetargetSkeleton *skeleton,
+                         const PoseData *input, PoseData *output) {
+  const PoseLandmark *in = input->landmarks;
+  PoseLandmark *out = output->landmarks;
+
+  // 루트(골반 중심)와 옮겨진 루트 위치 (기본 뼈대는 제자리)
+  Point3D root = calculate_hip_center(input);
+  const float root_scale = skeleton->root_position_scale;
+  Point3D moved_root = {root.x * root_scale + skeleton->root_offset.x,
+                        root.y * root_scale + skeleton->root_offset.y,
+                        root.z * root_scale + skeleton->root_offset.z};
+
+  for (int b = 0; b < RETARGET_BONE_COUNT; b++) {
+    const int parent = skeleton->bones[b].parent;
+    const int child = skeleton->bones[b].child;
+    const float scale = skeleton->scales[b];
+
+    // 부모의 결과 위치 + 원래 뼈 방향 x 스케일
+    const Point3D *from_in =
+        (parent == RETARGET_ROOT) ? &root : &in[parent].position;
+    const Point3D *from_out =
+        (parent == RETARGET_ROOT) ? &moved_root : &out[parent].position;
+
+    out[child].position.x =
+        from_out->x + (in[child].position.x - from_in->x) * scale;
+    out[child].position.y =
+        from_out->y + (in[child].position.y - from_in->y) * scale;
+    out[child].position.z =
+        from_out->z + (in[child].position.z - from_in->z) * scale;
+    out[child].inFrameLikelihood = in[child].inFrameLikelihood;
+  }
+}
+
+int retarget_poses(const RetargetSkeleton *skeleton, const PoseData *inputs,
+                   PoseData *outputs, int count) {
+  if (!skeleton || !inputs || !outputs || count < 0) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 부모 위치를 결과에서 읽으므로 입력과 출력이 겹치면 안 됨
+  if (inputs < outputs + count && outputs < inputs + count) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 포즈 바깥, 뼈 안쪽 순회: 포즈 하나(536바이트)가 캐시에 있는 동안 33개
+  // 뼈를 모두 처리하고, 뼈대(스케일/인덱스)는 작아서 계속 캐시에 남음
+  if (skeleton->uniform) {
+    for (int p = 0; p < count; p++) {
+      outputs[p].timestamp = inputs[p].timestamp;
+      retarget_one_uniform(skeleton, &inputs[p], &outputs[p]);
+    }
+    return SEGMENT_OK;
+  }
+
+  for (int p = 0; p < count; p++) {
+    outputs[p].timestamp = inputs[p].timestamp;
+    retarget_one(skeleton, &inputs[p], &outputs[p]);
+  }
+
+  return SEGMENT_OK;
+}
+
+int retarget_pose(const RetargetSkeleton *skeleton, const PoseData *input,
+                  PoseData *output) {
+  if (!skeleton || !input || !output) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  if (input == output) {
+    PoseData original = *input;
+    return retarget_poses(skeleton, &original, output, 1);
+  }
+
+  return retarget_poses(skeleton, input, output, 1);
+}
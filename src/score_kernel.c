@@ -0,0 +1,438 @@
+/**
+ * @file score_kernel.c
+ * @brief 블록 SoA 키포즈 점수 커널 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/score_kernel.h"
+#include "../include/math_utils.h"
+#include "../include/segment_memory.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SCORE_KERNEL_SSE 1
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SCORE_KERNEL_SSE2 1
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SCORE_KERNEL_NEON 1
+#endif
+
+// segment_calculate_similarity()와 같은 관절과 순서
+static const JointType g_score_joints[SCORE_JOINT_COUNT] = {
+    POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+    POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+    POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
+    POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
+    POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
+
+// 유사도 변환 기준 거리 (segment_calculate_similarity()와 동일한 500px)
+#define SCORE_DISTANCE_SCALE 500.0f
+
+// 골반 기준 상대 좌표를 [joint * 3 + axis] 순서로 추출
+static void extract_relative(const PoseData *pose,
+                             float out[SCORE_JOINT_COUNT * 3]) {
+  Point3D hip_center = calculate_hip_center(pose);
+  for (int j = 0; j < SCORE_JOINT_COUNT; j++) {
+    const Point3D *p = &pose->landmarks[g_score_joints[j]].position;
+    out[j * 3 + 0] = p->x - hip_center.x;
+    out[j * 3 + 1] = p->y - hip_center.y;
+    out[j * 3 + 2] = p->z - hip_center.z;
+  }
+}
+
+size_t score_table_storage_size(int count) {
+  size_t block_count = (size_t)(count + SCORE_BLOCK_LANES - 1) /
+                       SCORE_BLOCK_LANES;
+  return block_count * SCORE_BLOCK_FLOATS * sizeof(float);
+}
+
+int score_table_build_into(const PoseData *poses, int count, float *storage,
+                           ScoreBlockTable *table) {
+  if (!poses || count <= 0 || !storage || !table) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 마지막 블록의 남는 레인은 0으로 채움
+  int block_count = (count + SCORE_BLOCK_LANES - 1) / SCORE_BLOCK_LANES;
+  memset(storage, 0, score_table_storage_size(count));
+
+  float relative[SCORE_JOINT_COUNT * 3];
+  for (int i = 0; i < count; i++) {
+    float *block =
+        &storage[(size_t)(i / SCORE_BLOCK_LANES) * SCORE_BLOCK_FLOATS];
+    int lane = i % SCORE_BLOCK_LANES;
+
+    extract_relative(&poses[i], relative);
+    for (int k = 0; k < SCORE_JOINT_COUNT * 3; k++) {
+      block[k * SCORE_BLOCK_LANES + lane] = relative[k];
+    }
+  }
+
+  table->pose_count = count;
+  table->block_count = block_count;
+  table->data = storage;
+  return SEGMENT_OK;
+}
+
+int score_table_build(const PoseData *poses, int count,
+                      ScoreBlockTable *table) {
+  if (!poses || count <= 0 || !table) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  float *data =
+      segment_mem_alloc(SEGMENT_MEMORY_INDEX, score_table_storage_size(count));
+  if (!data) {
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  return score_table_build_into(poses, count, data, table);
+}
+
+void score_table_free(ScoreBlockTable *table) {
+  if (!table) {
+    return;
+  }
+
+  segment_mem_free(table->data);
+  table->data = NULL;
+  table->pose_count = 0;
+  table->block_count = 0;
+}
+
+/**
+ * @brief 블록 하나(키포즈 8개)에 대해 관절 거리 합계 계산
+ */
+static void score_block(const float *block, const float *query,
+                        float out_sums[SCORE_BLOCK_LANES]) {
+#if defined(SCORE_KERNEL_SSE)
+  __m128 sum_lo = _mm_setzero_ps();
+  __m128 sum_hi = _mm_setzero_ps();
+  for (int j = 0; j < SCORE_JOINT_COUNT; j++) {
+    const float *jb = block + j * 3 * SCORE_BLOCK_LANES;
+    __m128 qx = _mm_set1_ps(query[j * 3 + 0]);
+    __m128 qy = _mm_set1_ps(query[j * 3 + 1]);
+    __m128 qz = _mm_set1_ps(query[j * 3 + 2]);
+
+    __m128 dx_lo = _mm_sub_ps(_mm_loadu_ps(jb + 0), qx);
+    __m128 dx_hi = _mm_sub_ps(_mm_loadu_ps(jb + 4), qx);
+    __m128 dy_lo = _mm_sub_ps(_mm_loadu_ps(jb + 8), qy);
+    __m128 dy_hi = _mm_sub_ps(_mm_loadu_ps(jb + 12), qy);
+    __m128 dz_lo = _mm_sub_ps(_mm_loadu_ps(jb + 16), qz);
+    __m128 dz_hi = _mm_sub_ps(_mm_loadu_ps(jb + 20), qz);
+
+    __m128 sq_lo = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(dx_lo, dx_lo), _mm_mul_ps(dy_lo, dy_lo)),
+        _mm_mul_ps(dz_lo, dz_lo));
+    __m128 sq_hi = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(dx_hi, dx_hi), _mm_mul_ps(dy_hi, dy_hi)),
+        _mm_mul_ps(dz_hi, dz_hi));
+
+    sum_lo = _mm_add_ps(sum_lo, _mm_sqrt_ps(sq_lo));
+    sum_hi = _mm_add_ps(sum_hi, _mm_sqrt_ps(sq_hi));
+  }
+  _mm_storeu_ps(out_sums, sum_lo);
+  _mm_storeu_ps(out_sums + 4, sum_hi);
+#elif defined(SCORE_KERNEL_NEON)
+  float32x4_t sum_lo = vdupq_n_f32(0.0f);
+  float32x4_t sum_hi = vdupq_n_f32(0.0f);
+  for (int j = 0; j < SCORE_JOINT_COUNT; j++) {
+    const float *jb = block + j * 3 * SCORE_BLOCK_LANES;
+    float32x4_t qx = vdupq_n_f32(query[j * 3 + 0]);
+    float32x4_t qy = vdupq_n_f32(query[j * 3 + 1]);
+    float32x4_t qz = vdupq_n_f32(query[j * 3 + 2]);
+
+    float32x4_t dx_lo = vsubq_f32(vld1q_f32(jb + 0), qx);
+    float32x4_t dx_hi = vsubq_f32(vld1q_f32(jb + 4), qx);
+    float32x4_t dy_lo = vsubq_f32(vld1q_f32(jb + 8), qy);
+    float32x4_t dy_hi = vsubq_f32(vld1q_f32(jb + 12), qy);
+    float32x4_t dz_lo = vsubq_f32(vld1q_f32(jb + 16), qz);
+    float32x4_t dz_hi = vsubq_f32(vld1q_f32(jb + 20), qz);
+
+    float32x4_t sq_lo = vmulq_f32(dx_lo, dx_lo);
+    sq_lo = vaddq_f32(sq_lo, vmulq_f32(dy_lo, dy_lo));
+    sq_lo = vaddq_f32(sq_lo, vmulq_f32(dz_lo, dz_lo));
+    float32x4_t sq_hi = vmulq_f32(dx_hi, dx_hi);
+    sq_hi = vaddq_f32(sq_hi, vmulq_f32(dy_hi, dy_hi));
+    sq_hi = vaddq_f32(sq_hi, vmulq_f32(dz_hi, dz_hi));
+
+    sum_lo = vaddq_f32(sum_lo, vsqrtq_f32(sq_lo));
+    sum_hi = vaddq_f32(sum_hi, vsqrtq_f32(sq_hi));
+  }
+  vst1q_f32(out_sums, sum_lo);
+  vst1q_f32(out_sums + 4, sum_hi);
+#else
+  for (int lane = 0; lane < SCORE_BLOCK_LANES; lane++) {
+    out_sums[lane] = 0.0f;
+  }
+  for (int j = 0; j < SCORE_JOINT_COUNT; j++) {
+    const float *jb = block + j * 3 * SCORE_BLOCK_LANES;
+    for (int lane = 0; lane < SCORE_BLOCK_LANES; lane++) {
+      float dx = jb[lane] - query[j * 3 + 0];
+      float dy = jb[SCORE_BLOCK_LANES + lane] - query[j * 3 + 1];
+      float dz = jb[2 * SCORE_BLOCK_LANES + lane] - query[j * 3 + 2];
+      out_sums[lane] += sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+  }
+#endif
+}
+
+// 블록 하나의 레인별 거리 합계를 점수로 바꾸고 최고 점수 갱신
+static void collect_block_scores(const float sums[SCORE_BLOCK_LANES],
+                                 int block, int pose_count, float *out_scores,
+                                 int *best_index, float *best_score) {
+  int base = block * SCORE_BLOCK_LANES;
+  int lanes = pose_count - base;
+  if (lanes > SCORE_BLOCK_LANES) {
+    lanes = SCORE_BLOCK_LANES;
+  }
+
+  for (int lane = 0; lane < lanes; lane++) {
+    float avg_distance = sums[lane] / SCORE_JOINT_COUNT;
+    float score = fmaxf(0.0f, 1.0f - (avg_distance / SCORE_DISTANCE_SCALE));
+    if (out_scores) {
+      out_scores[base + lane] = score;
+    }
+    if (score > *best_score) {
+      *best_score = score;
+      *best_index = base + lane;
+    }
+  }
+}
+
+int score_table_score(const ScoreBlockTable *table, const PoseData *frame,
+                      float *out_scores) {
+  if (!table || !table->data || !frame) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  float query[SCORE_JOINT_COUNT * 3];
+  extract_relative(frame, query);
+
+  int best_index = 0;
+  float best_score = -1.0f;
+  float sums[SCORE_BLOCK_LANES];
+
+  for (int b = 0; b < table->block_count; b++) {
+    score_block(&table->data[(size_t)b * SCORE_BLOCK_FLOATS], query, sums);
+    collect_block_scores(sums, b, table->pose_count, out_scores, &best_index,
+                         &best_score);
+  }
+
+  return best_index;
+}
+
+// MARK: - int16 양자화 테이블
+
+size_t score_table_quantized_storage_size(int count) {
+  size_t block_count = (size_t)(count + SCORE_BLOCK_LANES - 1) /
+                       SCORE_BLOCK_LANES;
+  return block_count * SCORE_BLOCK_FLOATS * sizeof(int16_t);
+}
+
+int score_table_quantize_into(const ScoreBlockTable *source, int16_t *storage,
+                              QuantizedScoreTable *table) {
+  if (!source || !source->data || source->pose_count <= 0 || !storage ||
+      !table) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 축별 범위는 실제 키포즈 레인만으로 계산 (남는 레인의 0은 제외)
+  float min_value[3] = {INFINITY, INFINITY, INFINITY};
+  float max_value[3] = {-INFINITY, -INFINITY, -INFINITY};
+  for (int i = 0; i < source->pose_count; i++) {
+    const float *block =
+        &source->data[(size_t)(i / SCORE_BLOCK_LANES) * SCORE_BLOCK_FLOATS];
+    int lane = i % SCORE_BLOCK_LANES;
+    for (int k = 0; k < SCORE_JOINT_COUNT * 3; k++) {
+      float v = block[k * SCORE_BLOCK_LANES + lane];
+      min_value[k % 3] = fminf(min_value[k % 3], v);
+      max_value[k % 3] = fmaxf(max_value[k % 3], v);
+    }
+  }
+
+  Point3D min_point = {min_value[0], min_value[1], min_value[2]};
+  Point3D max_point = {max_value[0], max_value[1], max_value[2]};
+  pose_quant_params_from_bounds(&min_point, &max_point, &table->params);
+
+  // 세 축이 같은 scale을 쓰면 거리를 코드 단위로 계산한 뒤 한 번만 곱하면 됨
+  // (가장 넓은 축 기준, 범위가 0인 축은 제외)
+  float half_range = 0.0f;
+  for (int axis = 0; axis < 3; axis++) {
+    half_range = fmaxf(half_range, 0.5f * (max_value[axis] - min_value[axis]));
+  }
+  float scale = (half_range > 0.0f) ? half_range / POSE_QUANT_MAX_CODE : 1.0f;
+  table->params.scale.x = scale;
+  table->params.scale.y = scale;
+  table->params.scale.z = scale;
+
+  const float offset[3] = {table->params.offset.x, table->params.offset.y,
+                           table->params.offset.z};
+  size_t value_count = (size_t)source->block_count * SCORE_BLOCK_FLOATS;
+  for (size_t v = 0; v < value_count; v++) {
+    int axis = (int)((v / SCORE_BLOCK_LANES) % 3);
+    storage[v] = pose_quant_encode(source->data[v], offset[axis], scale);
+  }
+
+  table->pose_count = source->pose_count;
+  table->block_count = source->block_count;
+  table->data = storage;
+  return SEGMENT_OK;
+}
+
+// 레인 8개의 int16 코드를 부호 확장해 앞/뒤 4개씩 float 벡터로 읽기
+#if defined(SCORE_KERNEL_SSE2) && defined(__SSE4_1__)
+static inline void load_codes(const int16_t *codes, __m128 *lo, __m128 *hi) {
+  *lo = _mm_cvtepi32_ps(
+      _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)codes)));
+  *hi = _mm_cvtepi32_ps(
+      _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)(codes + 4))));
+}
+#elif defined(SCORE_KERNEL_SSE2)
+static inline void load_codes(const int16_t *codes, __m128 *lo, __m128 *hi) {
+  __m128i v = _mm_loadu_si128((const __m128i *)codes);
+  *lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+  *hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+}
+#elif defined(SCORE_KERNEL_NEON)
+static inline void load_codes(const int16_t *codes, float32x4_t *lo,
+                              float32x4_t *hi) {
+  int16x8_t v = vld1q_s16(codes);
+  *lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+  *hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+}
+#endif
+
+/**
+ * @brief 양자화 블록 하나의 관절 거리 합계 (코드 단위, 역양자화를 거리 계산에
+ * 합침)
+ *
+ * 좌표 = offset + code * scale 이고 scale이 세 축 공통이므로, 질의를
+ * (query - offset) / scale 코드 단위로 바꿔 두면 레인마다 int16 → float
+ * 변환과 뺄셈만 하면 됩니다. 합계에 scale을 곱하면 px 단위입니다.
+ */
+static void score_block_quantized(const int16_t *block, const float *code_query,
+                                  float out_sums[SCORE_BLOCK_LANES]) {
+#if defined(SCORE_KERNEL_SSE2)
+  __m128 sum_lo = _mm_setzero_ps();
+  __m128 sum_hi = _mm_setzero_ps();
+  for (int j = 0; j < SCORE_JOINT_COUNT; j++) {
+    const int16_t *jb = block + j * 3 * SCORE_BLOCK_LANES;
+    __m128 x_lo, x_hi, y_lo, y_hi, z_lo, z_hi;
+    load_codes(jb + 0, &x_lo, &x_hi);
+    load_codes(jb + 8, &y_lo, &y_hi);
+    load_codes(jb + 16, &z_lo, &z_hi);
+    __m128 qx = _mm_set1_ps(code_query[j * 3 + 0]);
+    __m128 qy = _mm_set1_ps(code_query[j * 3 + 1]);
+    __m128 qz = _mm_set1_ps(code_query[j * 3 + 2]);
+
+    __m128 dx_lo = _mm_sub_ps(x_lo, qx);
+    __m128 dx_hi = _mm_sub_ps(x_hi, qx);
+    __m128 dy_lo = _mm_sub_ps(y_lo, qy);
+    __m128 dy_hi = _mm_sub_ps(y_hi, qy);
+    __m128 dz_lo = _mm_sub_ps(z_lo, qz);
+    __m128 dz_hi = _mm_sub_ps(z_hi, qz);
+
+    __m128 sq_lo = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(dx_lo, dx_lo), _mm_mul_ps(dy_lo, dy_lo)),
+        _mm_mul_ps(dz_lo, dz_lo));
+    __m128 sq_hi = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(dx_hi, dx_hi), _mm_mul_ps(dy_hi, dy_hi)),
+        _mm_mul_ps(dz_hi, dz_hi));
+
+    sum_lo = _mm_add_ps(sum_lo, _mm_sqrt_ps(sq_lo));
+    sum_hi = _mm_add_ps(sum_hi, _mm_sqrt_ps(sq_hi));
+  }
+  _mm_storeu_ps(out_sums, sum_lo);
+  _mm_storeu_ps(out_sums + 4, sum_hi);
+#elif defined(SCORE_KERNEL_NEON)
+  float32x4_t sum_lo = vdupq_n_f32(0.0f);
+  float32x4_t sum_hi = vdupq_n_f32(0.0f);
+  for (int j = 0; j < SCORE_JOINT_COUNT; j++) {
+    const int16_t *jb = block + j * 3 * SCORE_BLOCK_LANES;
+    float32x4_t x_lo, x_hi, y_lo, y_hi, z_lo, z_hi;
+    load_codes(jb + 0, &x_lo, &x_hi);
+    load_codes(jb + 8, &y_lo, &y_hi);
+    load_codes(jb + 16, &z_lo, &z_hi);
+    float32x4_t qx = vdupq_n_f32(code_query[j * 3 + 0]);
+    float32x4_t qy = vdupq_n_f32(code_query[j * 3 + 1]);
+    float32x4_t qz = vdupq_n_f32(code_query[j * 3 + 2]);
+
+    float32x4_t dx_lo = vsubq_f32(x_lo, qx);
+    float32x4_t dx_hi = vsubq_f32(x_hi, qx);
+    float32x4_t dy_lo = vsubq_f32(y_lo, qy);
+    float32x4_t dy_hi = vsubq_f32(y_hi, qy);
+    float32x4_t dz_lo = vsubq_f32(z_lo, qz);
+    float32x4_t dz_hi = vsubq_f32(z_hi, qz);
+
+    float32x4_t sq_lo = vmulq_f32(dx_lo, dx_lo);
+    sq_lo = vaddq_f32(sq_lo, vmulq_f32(dy_lo, dy_lo));
+    sq_lo = vaddq_f32(sq_lo, vmulq_f32(dz_lo, dz_lo));
+    float32x4_t sq_hi = vmulq_f32(dx_hi, dx_hi);
+    sq_hi = vaddq_f32(sq_hi, vmulq_f32(dy_hi, dy_hi));
+    sq_hi = vaddq_f32(sq_hi, vmulq_f32(dz_hi, dz_hi));
+
+    sum_lo = vaddq_f32(sum_lo, vsqrtq_f32(sq_lo));
+    sum_hi = vaddq_f32(sum_hi, vsqrtq_f32(sq_hi));
+  }
+  vst1q_f32(out_sums, sum_lo);
+  vst1q_f32(out_sums + 4, sum_hi);
+#else
+  for (int lane = 0; lane < SCORE_BLOCK_LANES; lane++) {
+    out_sums[lane] = 0.0f;
+  }
+  for (int j = 0; j < SCORE_JOINT_COUNT; j++) {
+    const int16_t *jb = block + j * 3 * SCORE_BLOCK_LANES;
+    for (int lane = 0; lane < SCORE_BLOCK_LANES; lane++) {
+      float dx = jb[lane] - code_query[j * 3 + 0];
+      float dy = jb[SCORE_BLOCK_LANES + lane] - code_query[j * 3 + 1];
+      float dz = jb[2 * SCORE_BLOCK_LANES + lane] - code_query[j * 3 + 2];
+      out_sums[lane] += sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+  }
+#endif
+}
+
+int score_table_score_quantized(const QuantizedScoreTable *table,
+                                const PoseData *frame, float *out_scores) {
+  if (!table || !table->data || !frame) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  const float offset[3] = {table->params.offset.x, table->params.offset.y,
+                           table->params.offset.z};
+  const float scale = table->params.scale.x;
+  const float inverse_scale = 1.0f / scale;
+
+  float query[SCORE_JOINT_COUNT * 3];
+  extract_relative(frame, query);
+  for (int k = 0; k < SCORE_JOINT_COUNT * 3; k++) {
+    query[k] = (query[k] - offset[k % 3]) * inverse_scale;
+  }
+
+  int best_index = 0;
+  float best_score = -1.0f;
+  float sums[SCORE_BLOCK_LANES];
+
+  for (int b = 0; b < table->block_count; b++) {
+    score_block_quantized(&table->data[(size_t)b * SCORE_BLOCK_FLOATS], query,
+                          sums);
+    for (int lane = 0; lane < SCORE_BLOCK_LANES; lane++) {
+      sums[lane] *= scale;
+    }
+    collect_block_scores(sums, b, table->pose_count, out_scores, &best_index,
+                         &best_score);
+  }
+
+  return best_index;
+}
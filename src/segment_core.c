@@ -5,11 +5,19 @@
  * @version 1.0.0
  */
 
+#include "../include/alignment.h"
 #include "../include/calibration.h"
 #include "../include/math_utils.h"
 #include "../include/pose_analysis.h"
+#include "../include/pose_embedding.h"
+#include "../include/pose_index.h"
+#include "../include/pose_quant.h"
+#include "../include/retarget.h"
+#include "../include/score_kernel.h"
 #include "../include/segment_api.h"
+#include "../include/segment_memory.h"
 #include "../include/segment_types.h"
+#include "../include/trajectory.h"
 #include <float.h>
 #include <math.h>
 #include <stdio.h>
@@ -17,6 +25,11 @@
 #include <string.h>
 #include <time.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 // 전역 상태 변수들
 static bool g_initialized = false;
 static bool g_segment_loaded = false;
@@ -42,11 +55,205 @@ static int g_total_segment_count = 0;      // 로드된 총 세그먼트 개수
 static bool g_all_segments_loaded = false; // 전체 세그먼트 로드 여부
 static int g_current_start_index = -1; // 현재 사용 중인 시작 인덱스
 static int g_current_end_index = -1;   // 현재 사용 중인 종료 인덱스
+static PoseData *g_canonical_segments = NULL; // 변환 전 이상적 포즈 (재캘리브레이션용)
+static float *g_segment_embeddings = NULL; // 키포즈별 정규화 임베딩 (로드 시 계산)
+static ScoreBlockTable g_segment_score_table = {0, 0, NULL}; // 전체 키포즈 점수용 블록 SoA
+static SegmentArena g_workout_arena = {0}; // 위 키포즈/파생 테이블이 놓인 워크아웃 블록
+
+// 양자화 저장 모드의 세그먼트 캐시 (사용 중이면 g_user_segments 등은 NULL)
+static KeyposeStorage g_keypose_storage = KEYPOSE_STORAGE_FLOAT32;
+static QuantizedPose *g_quantized_segments = NULL;  // 변환 포즈 (int16)
+static QuantizedPose *g_quantized_canonical = NULL; // 원본 포즈 (없으면 NULL)
+static PoseQuantParams g_segment_quant_params;   // 변환 포즈 역양자화 계수
+static PoseQuantParams g_canonical_quant_params; // 원본 포즈 역양자화 계수
+static QuantizedScoreTable g_quantized_score_table = {0}; // int16 점수 테이블
+
+// 워크아웃 하나의 키포즈와 파생 테이블 (64바이트 정렬 블록 하나에 연속 배치)
+typedef struct {
+  SegmentArena arena;  // 블록 전체 (설치 후 g_workout_arena가 소유)
+  ScoreBlockTable score_table; // 점수 테이블 블록 SoA (data는 블록 안)
+  float *embeddings;   // 키포즈별 정규화 임베딩
+  PoseData *segments;  // 사용자 체형 변환 포즈
+  PoseData *canonical; // 원본 포즈 (없으면 NULL)
+  int count;           // 키포즈 수
+} WorkoutBlock;
 
 // 관절 분석을 위한 전역 변수들
 static JointAnalysis g_current_joint_analysis[12]; // 현재 세그먼트의 관절 분석 결과
 static bool g_joint_analysis_ready = false; // 관절 분석 완료 여부
 
+// 모션 게이팅을 위한 전역 변수들 (정지 구간 프레임 분석 생략)
+typedef struct {
+  bool enabled;          // 게이팅 사용 여부
+  float threshold;       // 관절 평균 이동량 임계값 (px)
+  uint64_t max_stale_ms; // 캐시 결과를 재사용할 수 있는 최대 경과 시간 (ms)
+  int max_stale_frames;  // 연속 재사용 최대 프레임 (0이면 제한 없음)
+  bool cache_valid;      // 캐시된 분석 결과 유효 여부
+  unsigned int outputs;  // 캐시에 담긴 출력 (SegmentOutputFlags)
+  int stale_frames;      // 현재 캐시를 연속으로 재사용한 프레임 수
+  uint64_t skipped_frames;     // 누적 생략 프레임 수
+  PoseData reference_pose;     // 마지막으로 전체 분석한 프레임
+  ScaleMode scale_mode;        // 캐시 생성 시 스케일 모드
+  float screen_width;          // 캐시 생성 시 화면 너비
+  float screen_height;         // 캐시 생성 시 화면 높이
+  float progress;              // 캐시된 진행도
+  float similarity;            // 캐시된 유사도
+  bool is_complete;            // 캐시된 완료 여부
+  Point3D corrections[POSE_LANDMARK_COUNT]; // 캐시된 교정 벡터
+  PoseData target_pose;        // 캐시된 스마트 목표 포즈
+} MotionGateState;
+
+static MotionGateState g_motion_gate = {.enabled = false,
+                                        .threshold = 2.0f,
+                                        .max_stale_ms = 300,
+                                        .max_stale_frames = 10};
+
+// 스마트 목표 포즈 계산에 쓰는 키포즈 상수 (세그먼트 선택 시 계산)
+typedef struct {
+  const AnchorLadder *ladder;  // 기준점 후보 순서
+  bool target_shoulders_valid; // 종료 포즈 양 어깨 신뢰도 0.5 이상
+  float scale_reference;       // 스케일 기준 길이 (0이면 스케일 1.0)
+  bool target_center_valid;    // 종료 포즈 중심점 유효 여부
+  Point3D target_center;       // 종료 포즈 중심점
+  Point3D start_center;        // 시작 포즈 중심점
+  float target_mean_offset_x;  // 종료 포즈 랜드마크의 중심 대비 x 평균
+} SmartAnchorConstants;
+
+static SmartAnchorConstants g_smart_anchor[2]; // ScaleMode별
+static AnchorType g_anchor_type = ANCHOR_TYPE_AUTO;
+
+// 스마트 시작/종료 포즈 캐시 (사용자 중심/스케일 변화가 작으면 재사용)
+typedef struct {
+  bool valid;             // 캐시 유효 여부
+  ScaleMode scale_mode;   // 캐시 생성 시 스케일 모드
+  float screen_width;     // 캐시 생성 시 화면 너비
+  bool absolute;          // 위치 이동까지 적용했는지 (아니면 스케일만)
+  bool has_start;         // 시작 포즈 포함 여부
+  Point3D current_center; // 캐시 생성 시 사용자 중심점
+  float scale;            // 캐시 생성 시 스케일
+  float center_epsilon;   // 재사용 허용 중심점 이동량 (px)
+  float scale_epsilon;    // 재사용 허용 스케일 변화 (비율)
+  uint64_t hits;          // 누적 재사용 횟수
+  uint64_t misses;        // 누적 재계산 횟수
+  PoseData start_pose;    // 스마트 시작 포즈
+  PoseData target_pose;   // 스마트 종료 포즈
+} SmartPoseCache;
+
+static SmartPoseCache g_smart_pose_cache = {0};
+
+static void prepare_smart_anchor(void);
+
+// 가이드 애니메이션 궤적 (세그먼트가 바뀔 때 생성)
+static PoseTrajectory g_guide_trajectory;
+
+static void read_cached_segment(int index, PoseData *out_pose);
+static void read_canonical_segment(int index, PoseData *out_pose);
+static int analyze_smart_gated(const PoseData *current_pose,
+                               bool pose_validated, ScaleMode scale_mode,
+                               float screen_width, float screen_height,
+                               unsigned int outputs, float *out_progress,
+                               float *out_similarity, bool *out_is_complete,
+                               Point3D *out_corrections,
+                               PoseData *out_smart_target_pose,
+                               const PoseData **out_target_ref);
+
+// 현재 세그먼트의 가이드 궤적 생성 (전체 세그먼트가 로드되었으면 이웃
+// 키포즈까지 곡선에 사용, 아니면 시작/종료 포즈만 사용)
+static void prepare_guide_trajectory(bool use_keypose_sequence) {
+  if (use_keypose_sequence && g_user_segments) {
+    trajectory_build(&g_guide_trajectory, g_user_segments,
+                     g_total_segment_count, g_current_start_index,
+                     g_current_end_index);
+    return;
+  }
+
+  if (use_keypose_sequence && g_quantized_segments) {
+    // 양자화 캐시: 곡선에 쓰는 구간과 양쪽 이웃 키포즈만 복원
+    int first = g_current_start_index > 0 ? g_current_start_index - 1 : 0;
+    int last = g_current_end_index + 1 < g_total_segment_count
+                   ? g_current_end_index + 1
+                   : g_current_end_index;
+    int count = last - first + 1;
+    PoseData *window = segment_mem_alloc(SEGMENT_MEMORY_SEGMENTS,
+                                         (size_t)count * sizeof(PoseData));
+    if (window) {
+      for (int i = 0; i < count; i++) {
+        read_cached_segment(first + i, &window[i]);
+      }
+      trajectory_build(&g_guide_trajectory, window, count,
+                       g_current_start_index - first,
+                       g_current_end_index - first);
+      segment_mem_free(window);
+      return;
+    }
+    // 할당 실패 시 시작/종료 포즈만으로 생성
+  }
+
+  const PoseData keyposes[2] = {g_user_segment_start, g_user_segment_end};
+  trajectory_build(&g_guide_trajectory, keyposes, 2, 0, 1);
+}
+
+// 세션 유사도 척도
+static SimilarityMetric g_similarity_metric = SIMILARITY_METRIC_DISTANCE;
+
+// 종료 포즈의 관절 각도 (prepare_smart_anchor()에서 선택 시 한 번 계산)
+// 상사 변환에 불변이므로 스마트 목표 포즈에도 그대로 사용
+static float g_target_joint_angles[JOINT_ANGLE_COUNT];
+
+// 스마트 분석의 목표 포즈 정렬 방식
+static AlignmentMode g_alignment_mode = ALIGNMENT_MODE_ANCHOR;
+
+// 좌우 반전 매칭 (반대쪽으로 하는 단측 운동 인식)
+static bool g_mirror_matching = false;
+static bool g_last_match_mirrored = false; // 마지막 분석이 반전 목표와 매칭됨
+
+// 관심 관절 집합 (segment_set_care_joints()에서 한 번 컴파일)
+static bool g_care_joints_enabled = false;
+static JointSet g_care_joint_set;          // 원래 방향 관절 집합
+static JointSet g_care_joint_set_mirrored; // 좌우 반전 매칭용 관절 집합
+
+// 세션 척도로 유사도 계산 (반전 매칭 시 out_mirrored에 매칭 방향 기록)
+// 각도 척도는 target_pose 대신 선택 시 계산한 종료 포즈 각도와 비교
+static float calculate_session_similarity(const PoseData *current_pose,
+                                          const PoseData *target_pose,
+                                          bool *out_mirrored) {
+  if (out_mirrored) {
+    *out_mirrored = false;
+  }
+
+  if (g_mirror_matching) {
+    if (g_similarity_metric == SIMILARITY_METRIC_ANGLE) {
+      return segment_calculate_angle_similarity_mirrored_cached(
+          current_pose, g_target_joint_angles, out_mirrored);
+    }
+    return segment_calculate_similarity_mirrored(current_pose, target_pose,
+                                                 out_mirrored);
+  }
+
+  if (g_similarity_metric == SIMILARITY_METRIC_ANGLE) {
+    return segment_calculate_angle_similarity_cached(current_pose,
+                                                     g_target_joint_angles);
+  }
+  return segment_calculate_similarity(current_pose, target_pose);
+}
+
+// 관절 분석 결과의 관절을 반대쪽으로 바꿈
+static void mirror_joint_analysis(const JointAnalysis *input,
+                                  JointAnalysis *output) {
+  for (int i = 0; i < 12; i++) {
+    output[i] = input[i];
+    output[i].joint = g_mirror_landmarks[input[i].joint];
+  }
+}
+
+// 현재 매칭 방향의 관심 관절 집합 (설정되지 않았으면 NULL)
+static const JointSet *care_joint_set_for(bool mirrored) {
+  if (!g_care_joints_enabled) {
+    return NULL;
+  }
+  return mirrored ? &g_care_joint_set_mirrored : &g_care_joint_set;
+}
+
 // 에러 메시지 배열
 static const char *error_messages[] = {"Success",
                                        "System not initialized",
@@ -144,8 +351,20 @@ static int finalize_json_workout(const char *workout_name,
 static int load_poses_from_json(const char *json_file_path, int start_index,
                                 int end_index, PoseData *start_pose,
                                 PoseData *end_pose);
+static char *open_parse_arena(SegmentArena *parse_arena, long file_size);
 static int parse_pose_from_json_string(const char *json_str, size_t json_len,
-                                       PoseData *pose);
+                                       SegmentArena *scratch, PoseData *pose);
+
+// 로드된 키포즈 파생 테이블 관리
+static void release_segment_cache(void);
+static void reset_segment_selection(void);
+static int compact_workout_block(const PoseData *segments,
+                                 const PoseData *canonical,
+                                 const float *embeddings,
+                                 const ScoreBlockTable *score_table,
+                                 int count);
+static int expand_segment_cache(void);
+static int apply_keypose_storage(void);
 
 // JSON 파일 처리 구현
 static int save_pose_to_json(const PoseData *pose, const char *pose_name,
@@ -221,7 +440,8 @@ static int finalize_json_workout(const char *workout_name,
   long file_size = ftell(temp_file);
   fseek(temp_file, 0, SEEK_SET);
 
-  char *temp_content = malloc(file_size + 1);
+  char *temp_content =
+      segment_mem_alloc(SEGMENT_MEMORY_PARSE, file_size + 1);
   if (!temp_content) {
     fclose(temp_file);
     fclose(final_file);
@@ -240,7 +460,7 @@ static int finalize_json_workout(const char *workout_name,
   }
 
   fprintf(final_file, "%s", temp_content);
-  free(temp_content);
+  segment_mem_free(temp_content);
 
   // JSON 푸터 작성
   fprintf(final_file, "  ]\n");
@@ -284,8 +504,11 @@ static int load_poses_from_json(const char *json_file_path, int start_index,
   long file_size = ftell(file);
   fseek(file, 0, SEEK_SET);
 
-  char *buffer = malloc(file_size + 1);
+  // 파일 버퍼와 포즈별 파싱 스크래치를 한 임시 아레나에 (끝나면 한 번에 해제)
+  SegmentArena parse_arena;
+  char *buffer = open_parse_arena(&parse_arena, file_size);
   if (!buffer) {
+    segment_arena_release(&parse_arena);
     fclose(file);
     printf("❌ JSON 파일용 메모리 할당 실패\n");
     return SEGMENT_ERROR_MEMORY_ALLOCATION;
@@ -297,7 +520,7 @@ static int load_poses_from_json(const char *json_file_path, int start_index,
 
   if (bytes_read == 0) {
     printf("❌ JSON 파일이 비어있음: %s\n", json_file_path);
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
@@ -307,7 +530,7 @@ static int load_poses_from_json(const char *json_file_path, int start_index,
   char *poses_start = strstr(buffer, "\"poses\"");
   if (!poses_start) {
     printf("❌ JSON에서 'poses' 배열을 찾을 수 없음\n");
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
@@ -315,7 +538,7 @@ static int load_poses_from_json(const char *json_file_path, int start_index,
   char *array_start = strchr(poses_start, '[');
   if (!array_start) {
     printf("❌ JSON에서 'poses' 배열 시작점 '[' 를 찾을 수 없음\n");
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
@@ -352,7 +575,7 @@ static int load_poses_from_json(const char *json_file_path, int start_index,
       // 시작 포즈 파싱
       memset(start_pose, 0, sizeof(PoseData));
       if (parse_pose_from_json_string(pose_start, pose_end - pose_start,
-                                      start_pose) == SEGMENT_OK) {
+                                      &parse_arena, start_pose) == SEGMENT_OK) {
         found_start = true;
       }
     }
@@ -361,7 +584,7 @@ static int load_poses_from_json(const char *json_file_path, int start_index,
       // 종료 포즈 파싱
       memset(end_pose, 0, sizeof(PoseData));
       if (parse_pose_from_json_string(pose_start, pose_end - pose_start,
-                                      end_pose) == SEGMENT_OK) {
+                                      &parse_arena, end_pose) == SEGMENT_OK) {
         found_end = true;
       }
     }
@@ -381,24 +604,42 @@ static int load_poses_from_json(const char *json_file_path, int start_index,
            "포즈 수: %d)\n",
            found_start ? "예" : "아니오", found_end ? "예" : "아니오",
            current_pose_index);
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
   printf("✅ JSON 파싱 성공: 시작 포즈(%d), 종료 포즈(%d) 로드 완료\n",
          start_index, end_index);
-  free(buffer);
+  segment_arena_release(&parse_arena);
   return SEGMENT_OK;
 }
 
+// JSON 파일 버퍼와 포즈 문자열 복사본(최대 파일 크기)을 담을 임시 아레나 생성
+static char *open_parse_arena(SegmentArena *parse_arena, long file_size) {
+  memset(parse_arena, 0, sizeof(SegmentArena));
+  if (file_size < 0) {
+    return NULL;
+  }
+
+  size_t buffer_size = (size_t)file_size + 1;
+  if (segment_arena_init(parse_arena, SEGMENT_MEMORY_PARSE,
+                         2 * segment_arena_footprint(buffer_size)) !=
+      SEGMENT_OK) {
+    return NULL;
+  }
+  return segment_arena_alloc(parse_arena, buffer_size);
+}
+
 static int parse_pose_from_json_string(const char *json_str, size_t json_len,
-                                       PoseData *pose) {
-  if (!json_str || !pose || json_len == 0) {
+                                       SegmentArena *scratch, PoseData *pose) {
+  if (!json_str || !scratch || !pose || json_len == 0) {
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // JSON 문자열을 복사하여 null 종료 문자열로 만들기
-  char *json_copy = malloc(json_len + 1);
+  // JSON 문자열을 스크래치에 복사하여 null 종료 문자열로 만들기
+  // (반환 전에 스크래치 위치를 되돌려 다음 포즈가 같은 공간 재사용)
+  size_t scratch_mark = scratch->used;
+  char *json_copy = segment_arena_alloc(scratch, json_len + 1);
   if (!json_copy) {
     return SEGMENT_ERROR_MEMORY_ALLOCATION;
   }
@@ -421,13 +662,13 @@ static int parse_pose_from_json_string(const char *json_str, size_t json_len,
   // landmarks 배열 파싱
   char *landmarks_start = strstr(json_copy, "\"landmarks\"");
   if (!landmarks_start) {
-    free(json_copy);
+    scratch->used = scratch_mark;
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
   char *array_start = strchr(landmarks_start, '[');
   if (!array_start) {
-    free(json_copy);
+    scratch->used = scratch_mark;
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
@@ -501,7 +742,7 @@ static int parse_pose_from_json_string(const char *json_str, size_t json_len,
     }
   }
 
-  free(json_copy);
+  scratch->used = scratch_mark;
 
   // 파싱된 랜드마크 수가 충분한지 확인
   if (landmark_index < POSE_LANDMARK_COUNT / 2) {
@@ -617,10 +858,6 @@ int segment_calibrate_recorder(const PoseData *base_pose) {
   g_recorder_calibration.center_offset.y = ideal_center_3d.y - user_center_3d.y;
   g_recorder_calibration.center_offset.z = 0.0f; // z는 0으로 설정
 
-  // 캘리브레이션 완료 플래그 설정
-  g_recorder_calibration.is_calibrated = true;
-  g_recorder_calibration.calibration_quality = 0.95f; // 높은 품질 점수
-
   // 관절별 길이 켈리브레이션 수행
   printf("\n🔧 관절별 길이 켈리브레이션 시작...\n");
   int joint_result =
@@ -629,6 +866,11 @@ int segment_calibrate_recorder(const PoseData *base_pose) {
     printf("⚠️  관절별 길이 켈리브레이션 실패, 기본 켈리브레이션만 적용\n");
   }
 
+  // 캘리브레이션 완료 플래그 설정 (품질은 관절 길이 측정 결과 기반)
+  g_recorder_calibration.is_calibrated = true;
+  g_recorder_calibration.calibration_quality =
+      calculate_calibration_quality(base_pose, &g_recorder_calibration);
+
   printf("✅ 캘리브레이션 성공! 품질: %.2f\n",
          g_recorder_calibration.calibration_quality);
   printf("   - 어깨 너비: %.2f\n", user_shoulder_width);
@@ -741,6 +983,8 @@ int segment_load_segment(const char *json_file_path, int start_index,
     return result;
   }
 
+  prepare_smart_anchor();
+  prepare_guide_trajectory(false);
   g_segment_loaded = true;
   return SEGMENT_OK;
 }
@@ -763,7 +1007,7 @@ SegmentOutput segment_analyze(const PoseData *current_pose) {
       0); // 모든 관절 사용
 
   float similarity =
-      segment_calculate_similarity(current_pose, &g_user_segment_end);
+      calculate_session_similarity(current_pose, &g_user_segment_end, NULL);
 
   // 완료 판단: 유사도 기반 (앱에서 최종 판단 권장)
   bool completed = (similarity >= 0.8f);
@@ -789,6 +1033,77 @@ int segment_get_transformed_end_pose(PoseData *out_pose) {
   return SEGMENT_OK;
 }
 
+// 요청한 출력만 계산하는 단순 분석 (원본 목표 포즈 기준)
+// current_pose는 호출하는 공개 함수에서 이미 검증한 포즈
+static int analyze_simple_masked(const PoseData *current_pose,
+                                 unsigned int outputs, float *out_progress,
+                                 bool *out_is_complete, float *out_similarity,
+                                 Point3D *out_corrections) {
+  // 반전 매칭 방향은 유사도로 정해지므로 반전 매칭 중에는 항상 계산
+  bool mirrored = false;
+  float similarity = 0.0f;
+  if ((outputs & (SEGMENT_OUTPUT_SIMILARITY | SEGMENT_OUTPUT_COMPLETION)) ||
+      g_mirror_matching) {
+    similarity = calculate_session_similarity(current_pose,
+                                              &g_user_segment_end, &mirrored);
+  }
+  g_last_match_mirrored = mirrored;
+
+  // 반전 목표와 매칭되면 시작/종료 포즈와 관절 분석도 반전하여 사용
+  const PoseData *start_pose = &g_user_segment_start;
+  const PoseData *end_pose = &g_user_segment_end;
+  const JointAnalysis *joint_analysis = g_current_joint_analysis;
+  PoseData mirrored_start, mirrored_end;
+  JointAnalysis mirrored_analysis[12];
+  if (mirrored) {
+    if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+      mirror_pose(&g_user_segment_start, &mirrored_start);
+      mirror_joint_analysis(g_current_joint_analysis, mirrored_analysis);
+      start_pose = &mirrored_start;
+      joint_analysis = mirrored_analysis;
+    }
+    mirror_pose(&g_user_segment_end, &mirrored_end);
+    end_pose = &mirrored_end;
+  }
+
+  // 관심 관절이 설정되었으면 해당 관절만 사용하고, 아니면 관절 분석 정보나
+  // 기본 방식 사용
+  const JointSet *care_set = care_joint_set_for(mirrored);
+  if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+    if (care_set) {
+      *out_progress = calculate_segment_progress_set(current_pose, start_pose,
+                                                     end_pose, care_set);
+    } else if (g_joint_analysis_ready) {
+      *out_progress = calculate_progress_with_analysis(
+          current_pose, start_pose, end_pose, joint_analysis);
+    } else {
+      *out_progress = calculate_segment_progress(current_pose, start_pose,
+                                                 end_pose, NULL, 0);
+    }
+  }
+
+  // 교정 벡터 계산
+  if (outputs & SEGMENT_OUTPUT_CORRECTIONS) {
+    if (care_set) {
+      calculate_correction_vectors_set(current_pose, end_pose, care_set,
+                                       out_corrections);
+    } else {
+      calculate_correction_vectors(current_pose, end_pose, NULL, 0,
+                                   out_corrections);
+    }
+  }
+
+  // 완료 판단: 유사도 기반 (앱에서 최종 판단 권장)
+  if (outputs & SEGMENT_OUTPUT_COMPLETION) {
+    *out_is_complete = (similarity >= 0.8f);
+  }
+  if (outputs & SEGMENT_OUTPUT_SIMILARITY) {
+    *out_similarity = similarity;
+  }
+
+  return SEGMENT_OK;
+}
+
 // Swift 친화적인 분석 함수
 int segment_analyze_simple(const PoseData *current_pose, float *out_progress,
                            bool *out_is_complete, float *out_similarity,
@@ -807,33 +1122,167 @@ int segment_analyze_simple(const PoseData *current_pose, float *out_progress,
     return SEGMENT_ERROR_INVALID_POSE;
   }
 
-  // 관절 분석이 완료되었으면 분석된 정보를 사용, 아니면 기본 방식 사용
-  float progress;
-  if (g_joint_analysis_ready) {
-    progress = calculate_progress_with_analysis(current_pose, &g_user_segment_start, 
-                                               &g_user_segment_end, g_current_joint_analysis);
-  } else {
-    progress = calculate_segment_progress(current_pose, &g_user_segment_start, 
-                                        &g_user_segment_end, NULL, 0);
+  return analyze_simple_masked(current_pose, SEGMENT_OUTPUT_ALL, out_progress,
+                               out_is_complete, out_similarity,
+                               out_corrections);
+}
+
+// 랜드마크 하나의 유효성 검사 (segment_validate_pose, stride 뷰 입력 공용)
+static inline bool landmark_in_range(const PoseLandmark *landmark) {
+  // 좌표값 범위 검사 (MLKit 좌표 범위에 맞게 확장)
+  if (landmark->position.x < -10000.0f || landmark->position.x > 10000.0f ||
+      landmark->position.y < -10000.0f || landmark->position.y > 10000.0f ||
+      landmark->position.z < -10000.0f || landmark->position.z > 10000.0f) {
+    return false;
   }
 
-  float similarity =
-      segment_calculate_similarity(current_pose, &g_user_segment_end);
+  // 신뢰도 범위 검사
+  if (landmark->inFrameLikelihood < 0.0f ||
+      landmark->inFrameLikelihood > 1.0f) {
+    return false;
+  }
 
-  // 완료 판단: 유사도 기반 (앱에서 최종 판단 권장)
-  bool completed = (similarity >= 0.8f);
+  return true;
+}
 
-  // 교정 벡터 계산
-  calculate_correction_vectors(current_pose, &g_user_segment_end, NULL, 0,
-                               out_corrections);
+// 뷰의 필드 하나를 float로 읽기 (정렬되지 않은 버퍼 허용)
+static inline float read_view_field(const unsigned char *landmark,
+                                    size_t offset, float missing_value) {
+  if (offset == LANDMARK_VIEW_NO_FIELD) {
+    return missing_value;
+  }
+  float value;
+  memcpy(&value, landmark + offset, sizeof(value));
+  return value;
+}
 
-  *out_progress = progress;
-  *out_is_complete = completed;
-  *out_similarity = similarity;
+// stride 뷰에서 포즈를 읽으면서 유효성 검사 (버퍼를 한 번만 순회)
+static int gather_pose_from_view(const LandmarkView *view,
+                                 PoseData *out_pose) {
+  if (!view || !view->base || view->offset_x == LANDMARK_VIEW_NO_FIELD ||
+      view->offset_y == LANDMARK_VIEW_NO_FIELD) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  const unsigned char *landmark = (const unsigned char *)view->base;
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++, landmark += view->stride) {
+    PoseLandmark *out = &out_pose->landmarks[i];
+    out->position.x = read_view_field(landmark, view->offset_x, 0.0f);
+    out->position.y = read_view_field(landmark, view->offset_y, 0.0f);
+    out->position.z = read_view_field(landmark, view->offset_z, 0.0f);
+    out->inFrameLikelihood =
+        read_view_field(landmark, view->offset_visibility, 1.0f);
+    if (!landmark_in_range(out)) {
+      return SEGMENT_ERROR_INVALID_POSE;
+    }
+  }
+  out_pose->timestamp = 0;
+
+  return SEGMENT_OK;
+}
+
+int segment_analyze_smart_overlay(const PoseData *current_pose,
+                                  ScaleMode scale_mode, float screen_width,
+                                  float screen_height, unsigned int outputs,
+                                  float *out_progress, float *out_similarity,
+                                  bool *out_is_complete,
+                                  Point3D *out_corrections,
+                                  float *out_vertices) {
+  if (!out_vertices || (outputs & SEGMENT_OUTPUT_TARGET_POSE)) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 목표 포즈는 복사하지 않고 캐시된 스마트 목표 포즈에서 바로 정점 기록
+  // (Procrustes 정렬/반전 결과만 target_buffer에 만들어짐)
+  PoseData target_buffer;
+  const PoseData *target_pose = NULL;
+  int result = analyze_smart_gated(
+      current_pose, false, scale_mode, screen_width, screen_height,
+      outputs | SEGMENT_OUTPUT_TARGET_POSE, out_progress, out_similarity,
+      out_is_complete, out_corrections, &target_buffer, &target_pose);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  // 랜드마크마다 {x, y, 표시 여부} 기록
+  float *vertex = out_vertices;
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    const PoseLandmark *landmark = &target_pose->landmarks[i];
+    vertex[0] = landmark->position.x;
+    vertex[1] = landmark->position.y;
+    vertex[2] = (landmark->inFrameLikelihood >= SEGMENT_OVERLAY_MIN_VISIBILITY)
+                    ? 1.0f
+                    : 0.0f;
+    vertex += SEGMENT_OVERLAY_VERTEX_STRIDE;
+  }
 
   return SEGMENT_OK;
 }
 
+// 오버레이 뼈대 선분 (관절 연결 목록에서 컴파일 시점에 생성한 상수 테이블)
+#define OVERLAY_BONE_ENTRY(from, to, name) from, to,
+static const uint16_t g_overlay_bone_indices[JOINT_CONNECTION_COUNT * 2] = {
+    JOINT_CONNECTION_LIST(OVERLAY_BONE_ENTRY)};
+#undef OVERLAY_BONE_ENTRY
+
+const uint16_t *segment_get_overlay_bone_indices(int *out_index_count) {
+  if (out_index_count) {
+    *out_index_count = (int)(sizeof(g_overlay_bone_indices) /
+                             sizeof(g_overlay_bone_indices[0]));
+  }
+  return g_overlay_bone_indices;
+}
+
+int segment_pose_from_view(const LandmarkView *view, uint64_t timestamp,
+                           PoseData *out_pose) {
+  if (!out_pose) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  int result = gather_pose_from_view(view, out_pose);
+  out_pose->timestamp = timestamp;
+  return result;
+}
+
+int segment_analyze_simple_view(const LandmarkView *view, float *out_progress,
+                                bool *out_is_complete, float *out_similarity,
+                                Point3D *out_corrections) {
+  if (!g_initialized || !g_segment_loaded || !out_progress ||
+      !out_is_complete || !out_similarity || !out_corrections) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  PoseData current_pose;
+  int result = gather_pose_from_view(view, &current_pose);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  // 읽는 동안 검증했으므로 바로 분석
+  return analyze_simple_masked(&current_pose, SEGMENT_OUTPUT_ALL,
+                               out_progress, out_is_complete, out_similarity,
+                               out_corrections);
+}
+
+int segment_analyze_smart_view(const LandmarkView *view, ScaleMode scale_mode,
+                               float screen_width, float screen_height,
+                               unsigned int outputs, float *out_progress,
+                               float *out_similarity, bool *out_is_complete,
+                               Point3D *out_corrections,
+                               PoseData *out_target_pose) {
+  PoseData current_pose;
+  int result = gather_pose_from_view(view, &current_pose);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  // 읽는 동안 검증했으므로 다시 검사하지 않음
+  return analyze_smart_gated(&current_pose, true, scale_mode, screen_width,
+                             screen_height, outputs, out_progress,
+                             out_similarity, out_is_complete,
+                             out_corrections, out_target_pose, NULL);
+}
+
 // Swift 친화적인 포즈 데이터 생성 함수
 int segment_create_pose_data(const PoseLandmark *landmarks,
                              PoseData *out_pose) {
@@ -868,14 +1317,19 @@ void segment_api_cleanup(void) {
   segment_destroy();
 
   // 향상된 세그먼트 관리 메모리 해제 (v2.1.0)
-  if (g_user_segments) {
-    free(g_user_segments);
-    g_user_segments = NULL;
-  }
-  g_total_segment_count = 0;
+  release_segment_cache();
   g_all_segments_loaded = false;
   g_current_start_index = -1;
   g_current_end_index = -1;
+  g_similarity_metric = SIMILARITY_METRIC_DISTANCE;
+  g_alignment_mode = ALIGNMENT_MODE_ANCHOR;
+  g_mirror_matching = false;
+  g_last_match_mirrored = false;
+  g_care_joints_enabled = false;
+  memset(&g_smart_pose_cache, 0, sizeof(g_smart_pose_cache));
+  g_anchor_type = ANCHOR_TYPE_AUTO;
+  g_guide_trajectory.ready = false;
+  g_keypose_storage = KEYPOSE_STORAGE_FLOAT32;
 
   g_initialized = false;
 }
@@ -894,6 +1348,7 @@ int segment_reset(void) {
 
 void segment_destroy(void) {
   g_segment_loaded = false;
+  g_motion_gate.cache_valid = false;
 
   // 메모리 초기화
   memset(&g_user_segment_start, 0, sizeof(PoseData));
@@ -923,19 +1378,7 @@ bool segment_validate_pose(const PoseData *pose) {
 
   // 기본적인 유효성 검사
   for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-    // 좌표값 범위 검사 (MLKit 좌표 범위에 맞게 확장)
-    if (pose->landmarks[i].position.x < -10000.0f ||
-        pose->landmarks[i].position.x > 10000.0f ||
-        pose->landmarks[i].position.y < -10000.0f ||
-        pose->landmarks[i].position.y > 10000.0f ||
-        pose->landmarks[i].position.z < -10000.0f ||
-        pose->landmarks[i].position.z > 10000.0f) {
-      return false;
-    }
-
-    // 신뢰도 범위 검사
-    if (pose->landmarks[i].inFrameLikelihood < 0.0f ||
-        pose->landmarks[i].inFrameLikelihood > 1.0f) {
+    if (!landmark_in_range(&pose->landmarks[i])) {
       return false;
     }
   }
@@ -958,27 +1401,16 @@ int apply_calibration_to_pose(const PoseData *original_pose,
     return SEGMENT_OK;
   }
 
-  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-    // 스케일링 적용
-    calibrated_pose->landmarks[i].position.x =
-        original_pose->landmarks[i].position.x * calibration->scale_factor;
-    calibrated_pose->landmarks[i].position.y =
-        original_pose->landmarks[i].position.y * calibration->scale_factor;
-    calibrated_pose->landmarks[i].position.z =
-        original_pose->landmarks[i].position.z * calibration->scale_factor;
-
-    // 오프셋 적용
-    calibrated_pose->landmarks[i].position.x += calibration->center_offset.x;
-    calibrated_pose->landmarks[i].position.y += calibration->center_offset.y;
-    calibrated_pose->landmarks[i].position.z += calibration->center_offset.z;
-
-    // 신뢰도는 그대로 유지
-    calibrated_pose->landmarks[i].inFrameLikelihood =
-        original_pose->landmarks[i].inFrameLikelihood;
+  // 균일 스케일 + 이동 뼈대 (세그먼트 일괄 변환과 같은 경로, 계층 순회 없이
+  // 랜드마크마다 position * scale + offset)
+  RetargetSkeleton skeleton;
+  int result = retarget_skeleton_init_uniform(
+      &skeleton, calibration->scale_factor, &calibration->center_offset);
+  if (result != SEGMENT_OK) {
+    return result;
   }
 
-  calibrated_pose->timestamp = original_pose->timestamp;
-  return SEGMENT_OK;
+  return retarget_pose(&skeleton, original_pose, calibrated_pose);
 }
 
 // segment_calibrate 함수는 calibration.c에서 구현됨
@@ -1015,12 +1447,95 @@ PoseLandmark get_pose_landmark(PoseData *pose, int index) {
 
 // MARK: - 향상된 세그먼트 관리 API 구현 (v2.1.0)
 
+// 키포즈 count개와 파생 테이블을 담을 워크아웃 블록 할당 (할당 한 번)
+static int workout_block_create(int count, bool with_canonical,
+                                WorkoutBlock *block) {
+  memset(block, 0, sizeof(WorkoutBlock));
+  if (count <= 0) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  size_t score_size = score_table_storage_size(count);
+  size_t embedding_size =
+      (size_t)count * POSE_EMBEDDING_DIMENSION * sizeof(float);
+  size_t pose_size = (size_t)count * sizeof(PoseData);
+  size_t capacity = segment_arena_footprint(score_size) +
+                    segment_arena_footprint(embedding_size) +
+                    segment_arena_footprint(pose_size) *
+                        (with_canonical ? 2 : 1);
+
+  int result =
+      segment_arena_init(&block->arena, SEGMENT_MEMORY_SEGMENTS, capacity);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  // 프레임마다 읽는 파생 테이블과 변환 포즈를 앞쪽에, 원본 포즈는 마지막에
+  block->score_table.data = segment_arena_alloc(&block->arena, score_size);
+  block->embeddings = segment_arena_alloc(&block->arena, embedding_size);
+  block->segments = segment_arena_alloc(&block->arena, pose_size);
+  if (with_canonical) {
+    block->canonical = segment_arena_alloc(&block->arena, pose_size);
+  }
+  block->count = count;
+  return SEGMENT_OK;
+}
+
+/**
+ * @brief 블록의 변환 포즈로부터 키포즈별 파생 테이블 계산
+ *
+ * 정규화 임베딩처럼 키포즈가 바뀔 때만 달라지는 데이터를 로드 시점에 한 번
+ * 계산해 두고, 실시간 경로에서는 재계산 없이 사용합니다. 저장 공간은 워크아웃
+ * 블록에 미리 잡혀 있으므로 할당하지 않습니다.
+ */
+static int workout_block_build_tables(WorkoutBlock *block) {
+  int result = pose_embedding_compute_batch(block->segments, block->count,
+                                            block->embeddings);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  return score_table_build_into(block->segments, block->count,
+                                block->score_table.data, &block->score_table);
+}
+
+// 워크아웃 블록의 파생 테이블을 계산한 뒤 세그먼트 캐시로 교체 설치
+// 양자화 저장 방식이면 양자화 블록까지 만든 뒤 교체하므로 설치된 캐시는 항상
+// 설정된 저장 방식과 일치 (실패 시 블록은 해제되고 기존 캐시는 그대로 유지)
+static int workout_block_install(WorkoutBlock *block) {
+  int result = workout_block_build_tables(block);
+  if (result == SEGMENT_OK && g_keypose_storage == KEYPOSE_STORAGE_QUANTIZED) {
+    result = compact_workout_block(block->segments, block->canonical,
+                                   block->embeddings, &block->score_table,
+                                   block->count);
+    segment_arena_release(&block->arena);
+    return result;
+  }
+  if (result != SEGMENT_OK) {
+    segment_arena_release(&block->arena);
+    return result;
+  }
+
+  release_segment_cache();
+  g_workout_arena = block->arena;
+  g_user_segments = block->segments;
+  g_canonical_segments = block->canonical;
+  g_segment_embeddings = block->embeddings;
+  g_segment_score_table = block->score_table;
+  g_total_segment_count = block->count;
+  memset(block, 0, sizeof(WorkoutBlock));
+  return SEGMENT_OK;
+}
+
 /**
  * @brief JSON 파일에서 모든 포즈를 한 번에 로드하는 내부 함수
+ *
+ * 원본 포즈를 새 워크아웃 블록에 바로 파싱합니다 (out_block->count가 파싱된
+ * 포즈 수). 파일 버퍼와 파싱 스크래치는 임시 아레나에서 한 번에 해제됩니다.
  */
 static int load_all_poses_from_json(const char *json_file_path,
-                                    PoseData **out_poses, int *out_pose_count) {
-  if (!json_file_path || !out_poses || !out_pose_count) {
+                                    WorkoutBlock *out_block) {
+  if (!json_file_path || !out_block) {
     printf("❌ 전체 JSON 로드 실패: NULL 포인터\n");
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
@@ -1038,8 +1553,11 @@ static int load_all_poses_from_json(const char *json_file_path,
   long file_size = ftell(file);
   fseek(file, 0, SEEK_SET);
 
-  char *buffer = malloc(file_size + 1);
+  // 파일 버퍼와 포즈별 파싱 스크래치를 한 임시 아레나에 (끝나면 한 번에 해제)
+  SegmentArena parse_arena;
+  char *buffer = open_parse_arena(&parse_arena, file_size);
   if (!buffer) {
+    segment_arena_release(&parse_arena);
     fclose(file);
     printf("❌ JSON 파일용 메모리 할당 실패\n");
     return SEGMENT_ERROR_MEMORY_ALLOCATION;
@@ -1051,7 +1569,7 @@ static int load_all_poses_from_json(const char *json_file_path,
 
   if (bytes_read == 0) {
     printf("❌ JSON 파일이 비어있음: %s\n", json_file_path);
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
@@ -1061,14 +1579,14 @@ static int load_all_poses_from_json(const char *json_file_path,
   char *poses_start = strstr(buffer, "\"poses\"");
   if (!poses_start) {
     printf("❌ JSON에서 'poses' 배열을 찾을 수 없음\n");
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
   char *array_start = strchr(poses_start, '[');
   if (!array_start) {
     printf("❌ JSON에서 'poses' 배열 시작점 '[' 를 찾을 수 없음\n");
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
@@ -1108,19 +1626,20 @@ static int load_all_poses_from_json(const char *json_file_path,
 
   if (pose_count == 0) {
     printf("❌ JSON에서 유효한 포즈를 찾을 수 없음\n");
-    free(buffer);
+    segment_arena_release(&parse_arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
   printf("✅ 총 %d개의 포즈 발견, 메모리 할당 중...\n", pose_count);
 
-  // 포즈 배열 메모리 할당
-  PoseData *poses = malloc(pose_count * sizeof(PoseData));
-  if (!poses) {
+  // 키포즈와 파생 테이블을 담을 워크아웃 블록 할당 (원본 포즈는 바로 파싱)
+  int result = workout_block_create(pose_count, true, out_block);
+  if (result != SEGMENT_OK) {
     printf("❌ 포즈 배열 메모리 할당 실패\n");
-    free(buffer);
-    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+    segment_arena_release(&parse_arena);
+    return result;
   }
+  PoseData *poses = out_block->canonical;
 
   // 실제 포즈 파싱
   char *current_pos = array_start + 1;
@@ -1147,6 +1666,7 @@ static int load_all_poses_from_json(const char *json_file_path,
     // 포즈 파싱
     memset(&poses[parsed_count], 0, sizeof(PoseData));
     if (parse_pose_from_json_string(pose_start, pose_end - pose_start,
+                                    &parse_arena,
                                     &poses[parsed_count]) == SEGMENT_OK) {
       parsed_count++;
     } else {
@@ -1160,127 +1680,779 @@ static int load_all_poses_from_json(const char *json_file_path,
     }
   }
 
-  free(buffer);
+  segment_arena_release(&parse_arena);
 
   if (parsed_count == 0) {
     printf("❌ 파싱된 포즈가 없음\n");
-    free(poses);
+    segment_arena_release(&out_block->arena);
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
   printf("✅ 전체 JSON 파싱 완료: %d개 포즈 로드 성공\n", parsed_count);
 
-  *out_poses = poses;
-  *out_pose_count = parsed_count;
+  out_block->count = parsed_count;
   return SEGMENT_OK;
 }
 
-int segment_load_all_segments(const char *json_file_path) {
-  if (!g_initialized) {
-    printf("❌ API 초기화 안됨\n");
-    return SEGMENT_ERROR_NOT_INITIALIZED;
+// MARK: - 세그먼트 변환 (병렬)
+
+// 스레드 하나가 맡을 최소 포즈 수와 최대 스레드 수
+#define TRANSFORM_MIN_POSES_PER_THREAD 256
+#define TRANSFORM_MAX_THREADS 8
+
+typedef struct {
+  const PoseData *source;
+  PoseData *target;
+  const RetargetSkeleton *skeleton;
+  int begin;
+  int end;
+  int result;
+} TransformJob;
+
+static void *run_transform_job(void *arg) {
+  TransformJob *job = (TransformJob *)arg;
+  job->result = retarget_poses(job->skeleton, job->source + job->begin,
+                               job->target + job->begin,
+                               job->end - job->begin);
+  return NULL;
+}
+
+/**
+ * @brief 원본 포즈 배열을 캘리브레이션으로 변환 (포즈 단위 병렬)
+ *
+ * apply_calibration_to_pose()와 같은 균일 스케일 뼈대를 한 번 만들고,
+ * 구간을 나눠 스레드별로 retarget_poses()를 호출합니다. 포즈 수가 적거나
+ * pthread를 쓸 수 없는 플랫폼(_WIN32)에서는 호출 스레드에서 순차 처리합니다.
+ */
+static int transform_segments(const PoseData *source, PoseData *target,
+                              int count, const CalibrationData *calibration) {
+  if (!calibration || !calibration->is_calibrated) {
+    memcpy(target, source, (size_t)count * sizeof(PoseData));
+    return SEGMENT_OK;
   }
 
-  if (!g_user_calibrated) {
-    printf("❌ 사용자 캘리브레이션 안됨\n");
-    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  RetargetSkeleton skeleton;
+  int result = retarget_skeleton_init_uniform(
+      &skeleton, calibration->scale_factor, &calibration->center_offset);
+  if (result != SEGMENT_OK) {
+    return result;
   }
 
-  if (!json_file_path) {
-    printf("❌ JSON 파일 경로가 NULL\n");
-    return SEGMENT_ERROR_INVALID_PARAMETER;
+  int thread_count = count / TRANSFORM_MIN_POSES_PER_THREAD;
+#ifndef _WIN32
+  long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpu_count > 0 && thread_count > cpu_count) {
+    thread_count = (int)cpu_count;
+  }
+#else
+  thread_count = 1;
+#endif
+  if (thread_count > TRANSFORM_MAX_THREADS) {
+    thread_count = TRANSFORM_MAX_THREADS;
+  }
+  if (thread_count < 1) {
+    thread_count = 1;
+  }
+
+  TransformJob jobs[TRANSFORM_MAX_THREADS];
+  for (int t = 0; t < thread_count; t++) {
+    jobs[t].source = source;
+    jobs[t].target = target;
+    jobs[t].skeleton = &skeleton;
+    jobs[t].begin = (int)((long long)count * t / thread_count);
+    jobs[t].end = (int)((long long)count * (t + 1) / thread_count);
+    jobs[t].result = SEGMENT_OK;
+  }
+
+#ifndef _WIN32
+  pthread_t threads[TRANSFORM_MAX_THREADS];
+  bool started[TRANSFORM_MAX_THREADS] = {false};
+  for (int t = 1; t < thread_count; t++) {
+    started[t] =
+        pthread_create(&threads[t], NULL, run_transform_job, &jobs[t]) == 0;
+    if (!started[t]) {
+      run_transform_job(&jobs[t]); // 스레드 생성 실패 시 직접 처리
+    }
+  }
+  run_transform_job(&jobs[0]);
+  for (int t = 1; t < thread_count; t++) {
+    if (started[t]) {
+      pthread_join(threads[t], NULL);
+    }
   }
+#else
+  run_transform_job(&jobs[0]);
+#endif
 
-  printf("🚀 전체 세그먼트 로드 시작: %s\n", json_file_path);
+  for (int t = 0; t < thread_count; t++) {
+    if (jobs[t].result != SEGMENT_OK) {
+      return jobs[t].result;
+    }
+  }
+  return SEGMENT_OK;
+}
 
-  // 기존에 로드된 세그먼트가 있다면 해제
-  if (g_user_segments) {
-    free(g_user_segments);
-    g_user_segments = NULL;
+int segment_retransform_cached_segments(void) {
+  if (!g_initialized || !g_all_segments_loaded ||
+      (!g_user_segments && !g_quantized_segments)) {
+    return SEGMENT_OK; // 캐시된 세그먼트 없음
   }
-  g_total_segment_count = 0;
-  g_all_segments_loaded = false;
 
-  // JSON에서 모든 포즈 로드
-  PoseData *ideal_poses = NULL;
-  int pose_count = 0;
-  int result =
-      load_all_poses_from_json(json_file_path, &ideal_poses, &pose_count);
+  // 원본 포즈 없이는 새 캘리브레이션에 맞출 수 없으므로 실패를 알려
+  // 호출자가 이전 캘리브레이션으로 되돌리게 함 (캐시와 어긋나지 않도록)
+  if (!g_canonical_segments && !g_quantized_canonical) {
+    printf("⚠️  원본 포즈가 없어 세그먼트를 재변환할 수 없습니다. "
+           "segment_load_all_segments()를 다시 호출하세요\n");
+    return SEGMENT_ERROR_SEGMENT_NOT_CREATED;
+  }
+
+  // 원본 포즈를 새 블록으로 변환하고 모두 성공해야 기존 캐시와 교체
+  // (양자화 저장 방식이면 양자화까지 끝난 뒤 교체, 실패하면 기존 캐시와
+  // 선택된 세그먼트는 그대로 유지)
+  WorkoutBlock block;
+  int result = workout_block_create(g_total_segment_count, true, &block);
   if (result != SEGMENT_OK) {
-    printf("❌ JSON에서 포즈 로드 실패: 에러 코드 %d\n", result);
     return result;
   }
+  for (int i = 0; i < block.count; i++) {
+    read_canonical_segment(i, &block.canonical[i]);
+  }
 
-  // 사용자 체형에 맞게 변환된 포즈 배열 생성
-  g_user_segments = malloc(pose_count * sizeof(PoseData));
-  if (!g_user_segments) {
-    printf("❌ 사용자 세그먼트 배열 메모리 할당 실패\n");
-    free(ideal_poses);
-    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  result = transform_segments(block.canonical, block.segments, block.count,
+                              &g_user_calibration);
+  if (result != SEGMENT_OK) {
+    segment_arena_release(&block.arena);
+    return result;
   }
 
-  // 각 포즈를 사용자 체형에 맞게 변환
-  printf("🔄 %d개 포즈를 사용자 체형에 맞게 변환 중...\n", pose_count);
-  for (int i = 0; i < pose_count; i++) {
-    result = apply_calibration_to_pose(&ideal_poses[i], &g_user_calibration,
-                                       &g_user_segments[i]);
-    if (result != SEGMENT_OK) {
-      printf("❌ 포즈 %d 변환 실패: 에러 코드 %d\n", i, result);
-      free(ideal_poses);
-      free(g_user_segments);
-      g_user_segments = NULL;
-      return result;
-    }
+  result = workout_block_install(&block);
+  if (result != SEGMENT_OK) {
+    return result;
   }
 
-  free(ideal_poses);
+  // 선택된 세그먼트와 관절 분석은 새 결과를 모두 계산한 뒤 한 번에 교체
+  if (g_segment_loaded && g_current_start_index >= 0 &&
+      g_current_end_index >= 0) {
+    PoseData start_pose, end_pose;
+    read_cached_segment(g_current_start_index, &start_pose);
+    read_cached_segment(g_current_end_index, &end_pose);
+    JointAnalysis analysis[12];
+    int analysis_result =
+        analyze_exercise_joints(&start_pose, &end_pose, analysis);
 
-  g_total_segment_count = pose_count;
-  g_all_segments_loaded = true;
+    g_user_segment_start = start_pose;
+    g_user_segment_end = end_pose;
+    memcpy(g_current_joint_analysis, analysis, sizeof(analysis));
+    g_joint_analysis_ready = (analysis_result == SEGMENT_OK);
+    prepare_smart_anchor();
+    prepare_guide_trajectory(true);
+    g_motion_gate.cache_valid = false;
+  }
+
+  return SEGMENT_OK;
+}
+
+// 선택된 세그먼트와 그로부터 계산한 캐시 무효화 (세그먼트 캐시 교체 시)
+static void reset_segment_selection(void) {
+  g_segment_loaded = false;
   g_current_start_index = -1;
   g_current_end_index = -1;
+  g_joint_analysis_ready = false;
+  g_guide_trajectory.ready = false;
+  g_smart_pose_cache.valid = false;
+  g_motion_gate.cache_valid = false;
+}
 
-  printf("✅ 전체 세그먼트 로드 완료: %d개 포즈가 사용자 체형에 맞게 변환됨\n",
-         pose_count);
-  return SEGMENT_OK;
+// 세그먼트 캐시(워크아웃 블록) 해제
+static void release_segment_cache(void) {
+  segment_arena_release(&g_workout_arena);
+  g_user_segments = NULL;
+  g_canonical_segments = NULL;
+  g_segment_embeddings = NULL;
+  memset(&g_segment_score_table, 0, sizeof(g_segment_score_table));
+  g_quantized_segments = NULL;
+  g_quantized_canonical = NULL;
+  memset(&g_quantized_score_table, 0, sizeof(g_quantized_score_table));
+  g_total_segment_count = 0;
 }
 
-int segment_set_current_segment(int start_index, int end_index) {
-  if (!g_initialized) {
-    printf("❌ API 초기화 안됨\n");
-    return SEGMENT_ERROR_NOT_INITIALIZED;
+// 캐시된 키포즈 읽기 (양자화 캐시면 역양자화)
+static void read_cached_segment(int index, PoseData *out_pose) {
+  if (g_quantized_segments) {
+    pose_dequantize(&g_quantized_segments[index], &g_segment_quant_params,
+                    out_pose);
+  } else {
+    *out_pose = g_user_segments[index];
   }
+}
 
-  if (!g_all_segments_loaded) {
-    printf("❌ 전체 세그먼트가 로드되지 않음. segment_load_all_segments() 먼저 "
-           "호출하세요\n");
-    return SEGMENT_ERROR_SEGMENT_NOT_CREATED;
+// 캐시된 원본 포즈 읽기 (양자화 캐시면 역양자화)
+static void read_canonical_segment(int index, PoseData *out_pose) {
+  if (g_quantized_canonical) {
+    pose_dequantize(&g_quantized_canonical[index], &g_canonical_quant_params,
+                    out_pose);
+  } else {
+    *out_pose = g_canonical_segments[index];
   }
+}
 
-  if (start_index < 0 || end_index < 0 ||
-      start_index >= g_total_segment_count ||
-      end_index >= g_total_segment_count ||
-      start_index > end_index) { // 같은 인덱스 허용
-    printf("❌ 잘못된 세그먼트 인덱스: start=%d, end=%d (총 %d개 포즈)\n",
-           start_index, end_index, g_total_segment_count);
-    return SEGMENT_ERROR_INVALID_PARAMETER;
+/**
+ * @brief float 키포즈와 파생 테이블로 양자화 블록을 만들어 캐시로 교체
+ *
+ * 키포즈는 int16 좌표 + uint8 신뢰도, 점수 테이블은 int16으로 줄이고
+ * 임베딩은 그대로 복사합니다. 원본은 설치된 캐시나 설치 전 워크아웃 블록
+ * 모두 가능하며, 실패하면 기존 캐시를 그대로 유지합니다.
+ */
+static int compact_workout_block(const PoseData *segments,
+                                 const PoseData *canonical,
+                                 const float *embeddings,
+                                 const ScoreBlockTable *score_table,
+                                 int count) {
+  bool with_canonical = canonical != NULL;
+
+  size_t score_size = score_table_quantized_storage_size(count);
+  size_t embedding_size =
+      (size_t)count * POSE_EMBEDDING_DIMENSION * sizeof(float);
+  size_t pose_size = (size_t)count * sizeof(QuantizedPose);
+  size_t capacity = segment_arena_footprint(score_size) +
+                    segment_arena_footprint(embedding_size) +
+                    segment_arena_footprint(pose_size) *
+                        (with_canonical ? 2 : 1);
+
+  SegmentArena arena;
+  int result = segment_arena_init(&arena, SEGMENT_MEMORY_SEGMENTS, capacity);
+  if (result != SEGMENT_OK) {
+    return result;
   }
 
-  // 현재 세그먼트 설정
-  g_user_segment_start = g_user_segments[start_index];
-  g_user_segment_end = g_user_segments[end_index];
-  g_current_start_index = start_index;
-  g_current_end_index = end_index;
-  g_segment_loaded = true;
+  int16_t *quantized_scores = segment_arena_alloc(&arena, score_size);
+  float *quantized_embeddings = segment_arena_alloc(&arena, embedding_size);
+  QuantizedPose *quantized_segments = segment_arena_alloc(&arena, pose_size);
+  QuantizedPose *quantized_canonical =
+      with_canonical ? segment_arena_alloc(&arena, pose_size) : NULL;
 
-  printf("✅ 세그먼트 선택 완료: %d → %d\n", start_index, end_index);
+  QuantizedScoreTable quantized_table;
+  result = score_table_quantize_into(score_table, quantized_scores,
+                                     &quantized_table);
+  if (result != SEGMENT_OK) {
+    segment_arena_release(&arena);
+    return result;
+  }
+  memcpy(quantized_embeddings, embeddings, embedding_size);
 
-  // 관절 분석 수행
-  printf("\n🔬 세그먼트 관절 분석 시작...\n");
-  int analysis_result = analyze_exercise_joints(&g_user_segment_start, 
-                                                &g_user_segment_end,
-                                                g_current_joint_analysis);
-  
+  PoseQuantParams segment_params;
+  PoseQuantParams canonical_params = {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}};
+  pose_quant_params_compute(segments, count, &segment_params);
+  for (int i = 0; i < count; i++) {
+    pose_quantize(&segments[i], &segment_params, &quantized_segments[i]);
+  }
+  if (with_canonical) {
+    pose_quant_params_compute(canonical, count, &canonical_params);
+    for (int i = 0; i < count; i++) {
+      pose_quantize(&canonical[i], &canonical_params,
+                    &quantized_canonical[i]);
+    }
+  }
+
+  release_segment_cache();
+  g_workout_arena = arena;
+  g_quantized_segments = quantized_segments;
+  g_quantized_canonical = quantized_canonical;
+  g_segment_quant_params = segment_params;
+  g_canonical_quant_params = canonical_params;
+  g_segment_embeddings = quantized_embeddings;
+  g_quantized_score_table = quantized_table;
+  g_total_segment_count = count;
+  return SEGMENT_OK;
+}
+
+// 설치된 float 워크아웃 블록을 양자화 블록으로 교체
+static int compact_segment_cache(void) {
+  return compact_workout_block(g_user_segments, g_canonical_segments,
+                               g_segment_embeddings, &g_segment_score_table,
+                               g_total_segment_count);
+}
+
+// 양자화 캐시를 float 워크아웃 블록으로 복원해 설치 (파생 테이블 재계산)
+static int expand_segment_cache(void) {
+  WorkoutBlock block;
+  int result = workout_block_create(g_total_segment_count,
+                                    g_quantized_canonical != NULL, &block);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  for (int i = 0; i < block.count; i++) {
+    read_cached_segment(i, &block.segments[i]);
+  }
+  for (int i = 0; block.canonical && i < block.count; i++) {
+    read_canonical_segment(i, &block.canonical[i]);
+  }
+  return workout_block_install(&block);
+}
+
+// 설정된 저장 방식에 맞게 세그먼트 캐시 변환 (이미 맞으면 아무것도 안 함)
+static int apply_keypose_storage(void) {
+  if (g_keypose_storage == KEYPOSE_STORAGE_QUANTIZED && g_user_segments) {
+    return compact_segment_cache();
+  }
+  if (g_keypose_storage == KEYPOSE_STORAGE_FLOAT32 && g_quantized_segments) {
+    return expand_segment_cache();
+  }
+  return SEGMENT_OK;
+}
+
+int segment_load_all_segments(const char *json_file_path) {
+  if (!g_initialized) {
+    printf("❌ API 초기화 안됨\n");
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (!g_user_calibrated) {
+    printf("❌ 사용자 캘리브레이션 안됨\n");
+    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  }
+
+  if (!json_file_path) {
+    printf("❌ JSON 파일 경로가 NULL\n");
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  printf("🚀 전체 세그먼트 로드 시작: %s\n", json_file_path);
+
+  // 기존에 로드된 세그먼트가 있다면 해제
+  release_segment_cache();
+  g_all_segments_loaded = false;
+  reset_segment_selection();
+
+  // JSON에서 모든 포즈를 새 워크아웃 블록으로 로드
+  WorkoutBlock block;
+  int result = load_all_poses_from_json(json_file_path, &block);
+  if (result != SEGMENT_OK) {
+    printf("❌ JSON에서 포즈 로드 실패: 에러 코드 %d\n", result);
+    return result;
+  }
+  int pose_count = block.count;
+
+  // 각 포즈를 사용자 체형에 맞게 변환 (원본 포즈는 재캘리브레이션용으로 유지)
+  printf("🔄 %d개 포즈를 사용자 체형에 맞게 변환 중...\n", pose_count);
+  result = transform_segments(block.canonical, block.segments, pose_count,
+                              &g_user_calibration);
+  if (result != SEGMENT_OK) {
+    printf("❌ 포즈 변환 실패: 에러 코드 %d\n", result);
+    segment_arena_release(&block.arena);
+    return result;
+  }
+
+  // 키포즈별 파생 데이터(임베딩 등)를 한 번만 계산
+  result = workout_block_install(&block);
+  if (result != SEGMENT_OK) {
+    printf("❌ 세그먼트 파생 데이터 생성 실패: 에러 코드 %d\n", result);
+    release_segment_cache();
+    return result;
+  }
+
+  g_all_segments_loaded = true;
+
+  printf("✅ 전체 세그먼트 로드 완료: %d개 포즈가 사용자 체형에 맞게 변환됨\n",
+         pose_count);
+  return SEGMENT_OK;
+}
+
+// MARK: - 사용자 캘리브레이션 프로필 (저장/복원)
+
+// 프로필 파일 포맷 식별자와 버전
+#define PROFILE_MAGIC "ESUP"
+#define PROFILE_VERSION 2u
+#define PROFILE_FLAG_SEGMENTS 0x1u
+#define PROFILE_FLAG_CANONICAL 0x2u
+#define PROFILE_MAX_USER_ID 64
+
+// 직렬화 크기 (필드 단위로 기록하므로 구조체 패딩과 무관)
+#define PROFILE_HEADER_SIZE (4 + 3 * sizeof(uint32_t))
+#define PROFILE_JOINT_SIZE (sizeof(int32_t) + 3 * sizeof(float) + 1)
+#define PROFILE_CALIBRATION_SIZE                                               \
+  (5 * sizeof(float) + sizeof(uint32_t) +                                      \
+   JOINT_CONNECTION_COUNT * PROFILE_JOINT_SIZE)
+#define PROFILE_POSE_SIZE                                                      \
+  (sizeof(uint64_t) + POSE_LANDMARK_COUNT * 4 * sizeof(float))
+
+typedef struct {
+  uint8_t *data;
+  size_t size;
+  size_t capacity;
+} ProfileWriter;
+
+typedef struct {
+  const uint8_t *data;
+  size_t size;
+  size_t offset;
+  bool ok;
+} ProfileReader;
+
+static void profile_write(ProfileWriter *writer, const void *src, size_t n) {
+  memcpy(writer->data + writer->size, src, n);
+  writer->size += n;
+}
+
+static void profile_read(ProfileReader *reader, void *dst, size_t n) {
+  if (!reader->ok || reader->size - reader->offset < n) {
+    reader->ok = false;
+    memset(dst, 0, n);
+    return;
+  }
+  memcpy(dst, reader->data + reader->offset, n);
+  reader->offset += n;
+}
+
+// FNV-1a 32비트 체크섬 (파일 손상 감지용)
+static uint32_t profile_checksum(const uint8_t *data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// 사용자 ID를 파일 경로로 변환 (영문/숫자/'-'/'_'만 허용)
+static int build_profile_path(const char *profile_dir, const char *user_id,
+                              char *out_path, size_t path_size) {
+  if (!profile_dir || !user_id) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  size_t length = strlen(user_id);
+  if (length == 0 || length > PROFILE_MAX_USER_ID) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+  for (size_t i = 0; i < length; i++) {
+    char c = user_id[i];
+    bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                   (c >= '0' && c <= '9') || c == '-' || c == '_';
+    if (!allowed) {
+      return SEGMENT_ERROR_INVALID_PARAMETER;
+    }
+  }
+
+  int written =
+      snprintf(out_path, path_size, "%s/%s.profile", profile_dir, user_id);
+  if (written < 0 || (size_t)written >= path_size) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  return SEGMENT_OK;
+}
+
+static void write_calibration(ProfileWriter *writer,
+                              const CalibrationData *calibration) {
+  uint32_t joint_count = (uint32_t)calibration->joint_lengths.count;
+
+  profile_write(writer, &calibration->scale_factor, sizeof(float));
+  profile_write(writer, &calibration->center_offset.x, sizeof(float));
+  profile_write(writer, &calibration->center_offset.y, sizeof(float));
+  profile_write(writer, &calibration->center_offset.z, sizeof(float));
+  profile_write(writer, &calibration->calibration_quality, sizeof(float));
+  profile_write(writer, &joint_count, sizeof(uint32_t));
+
+  // 미사용 슬롯도 고정 크기로 기록하여 레코드 크기를 일정하게 유지
+  for (int i = 0; i < JOINT_CONNECTION_COUNT; i++) {
+    const JointLength *joint_length = &calibration->joint_lengths.lengths[i];
+    int32_t connection_index = joint_length->connection_index;
+    uint8_t is_valid = joint_length->is_valid ? 1 : 0;
+
+    profile_write(writer, &connection_index, sizeof(int32_t));
+    profile_write(writer, &joint_length->ideal_length, sizeof(float));
+    profile_write(writer, &joint_length->user_length, sizeof(float));
+    profile_write(writer, &joint_length->scale_factor, sizeof(float));
+    profile_write(writer, &is_valid, 1);
+  }
+}
+
+static bool read_calibration(ProfileReader *reader,
+                             CalibrationData *calibration) {
+  uint32_t joint_count = 0;
+
+  memset(calibration, 0, sizeof(CalibrationData));
+  profile_read(reader, &calibration->scale_factor, sizeof(float));
+  profile_read(reader, &calibration->center_offset.x, sizeof(float));
+  profile_read(reader, &calibration->center_offset.y, sizeof(float));
+  profile_read(reader, &calibration->center_offset.z, sizeof(float));
+  profile_read(reader, &calibration->calibration_quality, sizeof(float));
+  profile_read(reader, &joint_count, sizeof(uint32_t));
+
+  for (int i = 0; i < JOINT_CONNECTION_COUNT; i++) {
+    JointLength *joint_length = &calibration->joint_lengths.lengths[i];
+    int32_t connection_index = 0;
+    uint8_t is_valid = 0;
+
+    profile_read(reader, &connection_index, sizeof(int32_t));
+    profile_read(reader, &joint_length->ideal_length, sizeof(float));
+    profile_read(reader, &joint_length->user_length, sizeof(float));
+    profile_read(reader, &joint_length->scale_factor, sizeof(float));
+    profile_read(reader, &is_valid, 1);
+
+    joint_length->connection_index = connection_index;
+    joint_length->is_valid = is_valid != 0;
+    if ((uint32_t)i < joint_count &&
+        (connection_index < 0 ||
+         connection_index >= JOINT_CONNECTION_COUNT)) {
+      return false;
+    }
+  }
+
+  if (!reader->ok || joint_count > JOINT_CONNECTION_COUNT ||
+      !isfinite(calibration->scale_factor) ||
+      calibration->scale_factor < 0.01f ||
+      calibration->scale_factor > 100.0f) {
+    return false;
+  }
+
+  calibration->joint_lengths.count = (int)joint_count;
+  calibration->is_calibrated = true;
+  return true;
+}
+
+static void write_pose(ProfileWriter *writer, const PoseData *pose) {
+  profile_write(writer, &pose->timestamp, sizeof(uint64_t));
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    const PoseLandmark *landmark = &pose->landmarks[i];
+    profile_write(writer, &landmark->position.x, sizeof(float));
+    profile_write(writer, &landmark->position.y, sizeof(float));
+    profile_write(writer, &landmark->position.z, sizeof(float));
+    profile_write(writer, &landmark->inFrameLikelihood, sizeof(float));
+  }
+}
+
+static void read_pose(ProfileReader *reader, PoseData *pose) {
+  profile_read(reader, &pose->timestamp, sizeof(uint64_t));
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    PoseLandmark *landmark = &pose->landmarks[i];
+    profile_read(reader, &landmark->position.x, sizeof(float));
+    profile_read(reader, &landmark->position.y, sizeof(float));
+    profile_read(reader, &landmark->position.z, sizeof(float));
+    profile_read(reader, &landmark->inFrameLikelihood, sizeof(float));
+  }
+}
+
+int segment_save_user_profile(const char *profile_dir, const char *user_id) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  char path[1024];
+  int result = build_profile_path(profile_dir, user_id, path, sizeof(path));
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  if (!g_user_calibrated) {
+    return SEGMENT_ERROR_CALIBRATION_FAILED;
+  }
+
+  // 변환된 세그먼트 캐시가 있으면 함께 저장
+  bool has_segments = g_all_segments_loaded && g_total_segment_count > 0;
+  bool has_canonical =
+      has_segments && (g_canonical_segments || g_quantized_canonical);
+  uint32_t segment_count = has_segments ? (uint32_t)g_total_segment_count : 0;
+  uint32_t flags = (has_segments ? PROFILE_FLAG_SEGMENTS : 0) |
+                   (has_canonical ? PROFILE_FLAG_CANONICAL : 0);
+  uint32_t version = PROFILE_VERSION;
+
+  // 원본 포즈도 저장해 두면 복원 후 재캘리브레이션 시 재변환 가능
+  size_t pose_records = (size_t)segment_count * (has_canonical ? 2 : 1);
+
+  ProfileWriter writer;
+  writer.capacity = PROFILE_HEADER_SIZE + PROFILE_CALIBRATION_SIZE +
+                    pose_records * PROFILE_POSE_SIZE + sizeof(uint32_t);
+  writer.size = 0;
+  writer.data = segment_mem_alloc(SEGMENT_MEMORY_PARSE, writer.capacity);
+  if (!writer.data) {
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  profile_write(&writer, PROFILE_MAGIC, 4);
+  profile_write(&writer, &version, sizeof(uint32_t));
+  profile_write(&writer, &flags, sizeof(uint32_t));
+  profile_write(&writer, &segment_count, sizeof(uint32_t));
+  write_calibration(&writer, &g_user_calibration);
+  // 양자화 캐시도 float 포즈로 저장 (프로필 형식은 저장 방식과 무관)
+  PoseData pose;
+  for (uint32_t i = 0; i < segment_count; i++) {
+    read_cached_segment((int)i, &pose);
+    write_pose(&writer, &pose);
+  }
+  for (uint32_t i = 0; has_canonical && i < segment_count; i++) {
+    read_canonical_segment((int)i, &pose);
+    write_pose(&writer, &pose);
+  }
+
+  uint32_t checksum = profile_checksum(writer.data, writer.size);
+  profile_write(&writer, &checksum, sizeof(uint32_t));
+
+  FILE *file = fopen(path, "wb");
+  if (!file) {
+    segment_mem_free(writer.data);
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  bool ok = fwrite(writer.data, 1, writer.size, file) == writer.size;
+  if (fclose(file) != 0) {
+    ok = false;
+  }
+  segment_mem_free(writer.data);
+
+  return ok ? SEGMENT_OK : SEGMENT_ERROR_INVALID_PARAMETER;
+}
+
+int segment_load_user_profile(const char *profile_dir, const char *user_id) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  char path[1024];
+  int result = build_profile_path(profile_dir, user_id, path, sizeof(path));
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  long file_size = -1;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    file_size = ftell(file);
+  }
+  if (file_size < (long)(PROFILE_HEADER_SIZE + PROFILE_CALIBRATION_SIZE +
+                         sizeof(uint32_t)) ||
+      fseek(file, 0, SEEK_SET) != 0) {
+    fclose(file);
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  uint8_t *data = segment_mem_alloc(SEGMENT_MEMORY_PARSE, (size_t)file_size);
+  if (!data) {
+    fclose(file);
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  bool ok = fread(data, 1, (size_t)file_size, file) == (size_t)file_size;
+  fclose(file);
+
+  // 체크섬 검증 (마지막 4바이트)
+  size_t payload_size = (size_t)file_size - sizeof(uint32_t);
+  uint32_t stored_checksum = 0;
+  if (ok) {
+    memcpy(&stored_checksum, data + payload_size, sizeof(uint32_t));
+    ok = stored_checksum == profile_checksum(data, payload_size);
+  }
+
+  ProfileReader reader = {data, payload_size, 0, ok};
+  char magic[4];
+  uint32_t version = 0;
+  uint32_t flags = 0;
+  uint32_t segment_count = 0;
+  profile_read(&reader, magic, 4);
+  profile_read(&reader, &version, sizeof(uint32_t));
+  profile_read(&reader, &flags, sizeof(uint32_t));
+  profile_read(&reader, &segment_count, sizeof(uint32_t));
+
+  bool has_canonical = (flags & PROFILE_FLAG_CANONICAL) != 0;
+  size_t pose_records = (size_t)segment_count * (has_canonical ? 2 : 1);
+
+  CalibrationData calibration;
+  ok = reader.ok && memcmp(magic, PROFILE_MAGIC, 4) == 0 &&
+       version == PROFILE_VERSION &&
+       ((flags & PROFILE_FLAG_SEGMENTS) != 0) == (segment_count > 0) &&
+       has_canonical == (segment_count > 0) && // 재캘리브레이션에 필요
+       read_calibration(&reader, &calibration) &&
+       pose_records * PROFILE_POSE_SIZE == reader.size - reader.offset;
+
+  WorkoutBlock block = {0};
+  if (ok && segment_count > 0) {
+    if (segment_count > INT32_MAX ||
+        workout_block_create((int)segment_count, has_canonical, &block) !=
+            SEGMENT_OK) {
+      segment_mem_free(data);
+      return SEGMENT_ERROR_MEMORY_ALLOCATION;
+    }
+    for (uint32_t i = 0; i < segment_count; i++) {
+      read_pose(&reader, &block.segments[i]);
+    }
+    for (uint32_t i = 0; has_canonical && i < segment_count; i++) {
+      read_pose(&reader, &block.canonical[i]);
+    }
+    ok = reader.ok;
+  }
+  segment_mem_free(data);
+
+  if (!ok) {
+    segment_arena_release(&block.arena);
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 캘리브레이션 복원
+  g_user_calibration = calibration;
+  g_user_calibrated = true;
+
+  // 세그먼트 캐시 복원: 이미 사용자 체형으로 변환된 포즈이므로 재변환 없음
+  if (block.count > 0) {
+    g_all_segments_loaded = false;
+    reset_segment_selection();
+
+    result = workout_block_install(&block);
+    if (result != SEGMENT_OK) {
+      release_segment_cache();
+      return result;
+    }
+    g_all_segments_loaded = true;
+  }
+
+  return SEGMENT_OK;
+}
+
+int segment_set_current_segment(int start_index, int end_index) {
+  if (!g_initialized) {
+    printf("❌ API 초기화 안됨\n");
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (!g_all_segments_loaded) {
+    printf("❌ 전체 세그먼트가 로드되지 않음. segment_load_all_segments() 먼저 "
+           "호출하세요\n");
+    return SEGMENT_ERROR_SEGMENT_NOT_CREATED;
+  }
+
+  if (start_index < 0 || end_index < 0 ||
+      start_index >= g_total_segment_count ||
+      end_index >= g_total_segment_count ||
+      start_index > end_index) { // 같은 인덱스 허용
+    printf("❌ 잘못된 세그먼트 인덱스: start=%d, end=%d (총 %d개 포즈)\n",
+           start_index, end_index, g_total_segment_count);
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 현재 세그먼트 설정
+  // 양자화 캐시는 선택 시 두 포즈만 복원 (프레임 커널은 float 포즈 사용)
+  read_cached_segment(start_index, &g_user_segment_start);
+  read_cached_segment(end_index, &g_user_segment_end);
+  g_current_start_index = start_index;
+  g_current_end_index = end_index;
+  g_segment_loaded = true;
+  prepare_smart_anchor();            // 키포즈 상수는 선택 시 한 번 계산
+  prepare_guide_trajectory(true);    // 가이드 궤적도 선택 시 한 번 샘플링
+  g_motion_gate.cache_valid = false; // 세그먼트가 바뀌면 캐시 무효화
+
+  printf("✅ 세그먼트 선택 완료: %d → %d\n", start_index, end_index);
+
+  // 관절 분석 수행
+  printf("\n🔬 세그먼트 관절 분석 시작...\n");
+  int analysis_result = analyze_exercise_joints(&g_user_segment_start, 
+                                                &g_user_segment_end,
+                                                g_current_joint_analysis);
+  
   if (analysis_result == SEGMENT_OK) {
     g_joint_analysis_ready = true;
     print_important_joints(g_current_joint_analysis);
@@ -1293,46 +2465,678 @@ int segment_set_current_segment(int start_index, int end_index) {
   return SEGMENT_OK;
 }
 
-int segment_analyze_with_target_pose(const PoseData *current_pose,
-                                     float *out_progress, float *out_similarity,
-                                     bool *out_is_complete,
-                                     Point3D *out_corrections,
-                                     PoseData *out_target_pose) {
-  // 기본 분석 수행
-  int result =
-      segment_analyze_simple(current_pose, out_progress, out_is_complete,
-                             out_similarity, out_corrections);
+int segment_analyze_with_target_pose(const PoseData *current_pose,
+                                     float *out_progress, float *out_similarity,
+                                     bool *out_is_complete,
+                                     Point3D *out_corrections,
+                                     PoseData *out_target_pose) {
+  // 기본 분석 수행
+  int result =
+      segment_analyze_simple(current_pose, out_progress, out_is_complete,
+                             out_similarity, out_corrections);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  // 목표 포즈 반환
+  if (out_target_pose) {
+    result = segment_get_transformed_end_pose(out_target_pose);
+    if (result != SEGMENT_OK) {
+      printf("❌ 목표 포즈 가져오기 실패: 에러 코드 %d\n", result);
+      return result;
+    }
+  }
+
+  return SEGMENT_OK;
+}
+
+/**
+ * @brief 마지막 전체 분석 프레임 대비 움직임 에너지 계산
+ *
+ * analyze_exercise_joints()가 찾은 중요 관절(없으면 주요 관절 전체)의
+ * 평균 제곱 이동량을 반환합니다. 비교 가능한 관절이 없으면 FLT_MAX를
+ * 반환하여 항상 전체 분석이 수행되도록 합니다.
+ */
+static float calculate_motion_energy(const PoseData *current_pose,
+                                     const PoseData *reference_pose) {
+  static const JointType main_joints[] = {
+      POSE_LANDMARK_LEFT_SHOULDER, POSE_LANDMARK_RIGHT_SHOULDER,
+      POSE_LANDMARK_LEFT_ELBOW,    POSE_LANDMARK_RIGHT_ELBOW,
+      POSE_LANDMARK_LEFT_WRIST,    POSE_LANDMARK_RIGHT_WRIST,
+      POSE_LANDMARK_LEFT_HIP,      POSE_LANDMARK_RIGHT_HIP,
+      POSE_LANDMARK_LEFT_KNEE,     POSE_LANDMARK_RIGHT_KNEE,
+      POSE_LANDMARK_LEFT_ANKLE,    POSE_LANDMARK_RIGHT_ANKLE};
+
+  bool use_important = false;
+  if (g_joint_analysis_ready) {
+    for (int i = 0; i < 12; i++) {
+      if (g_current_joint_analysis[i].is_important) {
+        use_important = true;
+        break;
+      }
+    }
+  }
+
+  float energy = 0.0f;
+  int joint_count = 0;
+
+  for (int i = 0; i < 12; i++) {
+    if (use_important && !g_current_joint_analysis[i].is_important) {
+      continue;
+    }
+
+    JointType joint = use_important ? g_current_joint_analysis[i].joint
+                                    : main_joints[i];
+    const PoseLandmark *current = &current_pose->landmarks[joint];
+    const PoseLandmark *reference = &reference_pose->landmarks[joint];
+
+    // 신뢰도 경계를 넘나드는 관절은 움직임으로 간주
+    if ((current->inFrameLikelihood >= 0.5f) !=
+        (reference->inFrameLikelihood >= 0.5f)) {
+      return FLT_MAX;
+    }
+    if (current->inFrameLikelihood < 0.5f) {
+      continue;
+    }
+
+    float dx = current->position.x - reference->position.x;
+    float dy = current->position.y - reference->position.y;
+    float dz = current->position.z - reference->position.z;
+    energy += dx * dx + dy * dy + dz * dz;
+    joint_count++;
+  }
+
+  if (joint_count == 0) {
+    return FLT_MAX;
+  }
+
+  return energy / joint_count;
+}
+
+static int analyze_smart_full(const PoseData *current_pose,
+                              ScaleMode scale_mode, float screen_width,
+                              float screen_height, unsigned int outputs,
+                              float *out_progress, float *out_similarity,
+                              bool *out_is_complete, Point3D *out_corrections,
+                              PoseData *target_buffer,
+                              const PoseData **out_target_pose);
+
+int segment_analyze_smart(const PoseData *current_pose, ScaleMode scale_mode,
+                          float screen_width, float screen_height,
+                          float *out_progress, float *out_similarity,
+                          bool *out_is_complete, Point3D *out_corrections,
+                          PoseData *out_smart_target_pose) {
+
+  if (!current_pose || !out_progress || !out_similarity || !out_is_complete ||
+      !out_corrections || !out_smart_target_pose) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  return segment_analyze_smart_ex(current_pose, scale_mode, screen_width,
+                                  screen_height, SEGMENT_OUTPUT_ALL,
+                                  out_progress, out_similarity, out_is_complete,
+                                  out_corrections, out_smart_target_pose);
+}
+
+// segment_analyze_smart_ex() 본체 (pose_validated면 포즈 검증 생략)
+// out_target_ref가 있으면 목표 포즈를 복사하지 않고 최종 목표 포즈(캐시 또는
+// out_smart_target_pose에 만든 정렬/반전 결과)의 주소만 돌려줌
+static int analyze_smart_gated(const PoseData *current_pose,
+                               bool pose_validated, ScaleMode scale_mode,
+                               float screen_width, float screen_height,
+                               unsigned int outputs, float *out_progress,
+                               float *out_similarity, bool *out_is_complete,
+                               Point3D *out_corrections,
+                               PoseData *out_smart_target_pose,
+                               const PoseData **out_target_ref) {
+  if (!current_pose || outputs == 0 || (outputs & ~SEGMENT_OUTPUT_ALL) ||
+      ((outputs & SEGMENT_OUTPUT_PROGRESS) && !out_progress) ||
+      ((outputs & SEGMENT_OUTPUT_SIMILARITY) && !out_similarity) ||
+      ((outputs & SEGMENT_OUTPUT_COMPLETION) && !out_is_complete) ||
+      ((outputs & SEGMENT_OUTPUT_CORRECTIONS) && !out_corrections) ||
+      ((outputs & SEGMENT_OUTPUT_TARGET_POSE) && !out_smart_target_pose)) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  if (!g_initialized || !g_segment_loaded) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  // 모션 게이팅: 정지 상태면 마지막 전체 분석 결과 재사용
+  // (캐시에 요청한 출력이 모두 있고, 기준 프레임 이후 max_stale_ms가
+  // 지나지 않았을 때만. 타임스탬프가 거꾸로 가면 전체 분석)
+  if (g_motion_gate.enabled && g_motion_gate.cache_valid &&
+      (outputs & ~g_motion_gate.outputs) == 0 &&
+      g_motion_gate.scale_mode == scale_mode &&
+      g_motion_gate.screen_width == screen_width &&
+      g_motion_gate.screen_height == screen_height &&
+      current_pose->timestamp >= g_motion_gate.reference_pose.timestamp &&
+      current_pose->timestamp - g_motion_gate.reference_pose.timestamp <
+          g_motion_gate.max_stale_ms &&
+      (g_motion_gate.max_stale_frames == 0 ||
+       g_motion_gate.stale_frames < g_motion_gate.max_stale_frames)) {
+    float energy =
+        calculate_motion_energy(current_pose, &g_motion_gate.reference_pose);
+    if (energy < g_motion_gate.threshold * g_motion_gate.threshold) {
+      if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+        *out_progress = g_motion_gate.progress;
+      }
+      if (outputs & SEGMENT_OUTPUT_SIMILARITY) {
+        *out_similarity = g_motion_gate.similarity;
+      }
+      if (outputs & SEGMENT_OUTPUT_COMPLETION) {
+        *out_is_complete = g_motion_gate.is_complete;
+      }
+      if (outputs & SEGMENT_OUTPUT_CORRECTIONS) {
+        memcpy(out_corrections, g_motion_gate.corrections,
+               sizeof(g_motion_gate.corrections));
+      }
+      if (out_target_ref) {
+        *out_target_ref = &g_motion_gate.target_pose;
+      } else if (outputs & SEGMENT_OUTPUT_TARGET_POSE) {
+        *out_smart_target_pose = g_motion_gate.target_pose;
+      }
+      g_motion_gate.stale_frames++;
+      g_motion_gate.skipped_frames++;
+      return SEGMENT_OK;
+    }
+  }
+
+  // 요청하지 않은 출력은 내부 작업 공간에 받음 (해당 계산은 생략됨)
+  float progress = 0.0f;
+  float similarity = 0.0f;
+  bool is_complete = false;
+  Point3D corrections_scratch[POSE_LANDMARK_COUNT];
+  PoseData target_scratch;
+  Point3D *corrections = (outputs & SEGMENT_OUTPUT_CORRECTIONS)
+                             ? out_corrections
+                             : corrections_scratch;
+  PoseData *target_buffer = (outputs & SEGMENT_OUTPUT_TARGET_POSE)
+                                ? out_smart_target_pose
+                                : &target_scratch;
+  const PoseData *target_pose = NULL;
+
+  int result = SEGMENT_ERROR_INVALID_POSE;
+  if (pose_validated || segment_validate_pose(current_pose)) {
+    result = analyze_smart_full(current_pose, scale_mode, screen_width,
+                                screen_height, outputs, &progress, &similarity,
+                                &is_complete, corrections, target_buffer,
+                                &target_pose);
+  }
+
+  if (result == SEGMENT_OK) {
+    if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+      *out_progress = progress;
+    }
+    if (outputs & SEGMENT_OUTPUT_SIMILARITY) {
+      *out_similarity = similarity;
+    }
+    if (outputs & SEGMENT_OUTPUT_COMPLETION) {
+      *out_is_complete = is_complete;
+    }
+    if (out_target_ref) {
+      *out_target_ref = target_pose;
+    } else if ((outputs & SEGMENT_OUTPUT_TARGET_POSE) &&
+               target_pose != out_smart_target_pose) {
+      *out_smart_target_pose = *target_pose;
+    }
+  }
+
+  if (g_motion_gate.enabled) {
+    g_motion_gate.cache_valid = (result == SEGMENT_OK);
+    if (result == SEGMENT_OK) {
+      g_motion_gate.outputs = outputs;
+      g_motion_gate.reference_pose = *current_pose;
+      g_motion_gate.scale_mode = scale_mode;
+      g_motion_gate.screen_width = screen_width;
+      g_motion_gate.screen_height = screen_height;
+      g_motion_gate.progress = progress;
+      g_motion_gate.similarity = similarity;
+      g_motion_gate.is_complete = is_complete;
+      if (outputs & SEGMENT_OUTPUT_CORRECTIONS) {
+        memcpy(g_motion_gate.corrections, corrections,
+               sizeof(g_motion_gate.corrections));
+      }
+      if (outputs & SEGMENT_OUTPUT_TARGET_POSE) {
+        g_motion_gate.target_pose = *target_pose;
+      }
+      g_motion_gate.stale_frames = 0;
+    }
+  }
+
+  return result;
+}
+
+int segment_analyze_smart_ex(const PoseData *current_pose,
+                             ScaleMode scale_mode, float screen_width,
+                             float screen_height, unsigned int outputs,
+                             float *out_progress, float *out_similarity,
+                             bool *out_is_complete, Point3D *out_corrections,
+                             PoseData *out_smart_target_pose) {
+  return analyze_smart_gated(current_pose, false, scale_mode, screen_width,
+                             screen_height, outputs, out_progress,
+                             out_similarity, out_is_complete,
+                             out_corrections, out_smart_target_pose, NULL);
+}
+
+int segment_set_motion_gating(bool enabled, float motion_threshold,
+                              uint64_t max_stale_ms, int max_stale_frames) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (motion_threshold < 0.0f || max_stale_ms == 0 || max_stale_frames < 0) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  g_motion_gate.enabled = enabled;
+  g_motion_gate.threshold = motion_threshold;
+  g_motion_gate.max_stale_ms = max_stale_ms;
+  g_motion_gate.max_stale_frames = max_stale_frames;
+  g_motion_gate.cache_valid = false;
+  g_motion_gate.stale_frames = 0;
+  g_motion_gate.skipped_frames = 0;
+
+  return SEGMENT_OK;
+}
+
+int segment_get_motion_gating_stats(uint64_t *out_skipped_frames) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (!out_skipped_frames) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  *out_skipped_frames = g_motion_gate.skipped_frames;
+  return SEGMENT_OK;
+}
+
+int segment_get_guide_pose(float t, PoseData *out_pose) {
+  if (!g_initialized || !g_segment_loaded) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  return trajectory_sample(&g_guide_trajectory, t, out_pose);
+}
+
+int segment_set_anchor_type(AnchorType type) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (!anchor_ladder_for(type, SCALE_MODE_EXERCISE)) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  g_anchor_type = type;
+  if (g_segment_loaded) {
+    prepare_smart_anchor(); // 키포즈 기준점도 새 후보 순서로 다시 계산
+  }
+  g_motion_gate.cache_valid = false; // 캐시된 목표 포즈는 이전 기준점 기준
+  return SEGMENT_OK;
+}
+
+int segment_set_keypose_storage(KeyposeStorage storage) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (storage != KEYPOSE_STORAGE_FLOAT32 &&
+      storage != KEYPOSE_STORAGE_QUANTIZED) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 이미 로드된 캐시도 바로 변환 (실패하면 기존 캐시와 설정 유지)
+  KeyposeStorage previous = g_keypose_storage;
+  g_keypose_storage = storage;
+  int result = apply_keypose_storage();
+  if (result != SEGMENT_OK) {
+    g_keypose_storage = previous;
+  }
+  return result;
+}
+
+int segment_set_smart_target_cache(float center_epsilon,
+                                   float scale_epsilon) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (center_epsilon < 0.0f || scale_epsilon < 0.0f) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  g_smart_pose_cache.center_epsilon = center_epsilon;
+  g_smart_pose_cache.scale_epsilon = scale_epsilon;
+  g_smart_pose_cache.valid = false;
+  g_smart_pose_cache.hits = 0;
+  g_smart_pose_cache.misses = 0;
+  g_motion_gate.cache_valid = false; // 캐시된 목표 포즈는 이전 설정 기준
+  return SEGMENT_OK;
+}
+
+int segment_get_smart_target_cache_stats(uint64_t *out_hits,
+                                         uint64_t *out_misses) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (!out_hits || !out_misses) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  *out_hits = g_smart_pose_cache.hits;
+  *out_misses = g_smart_pose_cache.misses;
+  return SEGMENT_OK;
+}
+
+int segment_set_similarity_metric(SimilarityMetric metric) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (metric != SIMILARITY_METRIC_DISTANCE &&
+      metric != SIMILARITY_METRIC_ANGLE) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  g_similarity_metric = metric;
+  g_motion_gate.cache_valid = false; // 캐시된 유사도는 이전 척도 기준
+  return SEGMENT_OK;
+}
+
+int segment_set_alignment_mode(AlignmentMode mode) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (mode != ALIGNMENT_MODE_ANCHOR && mode != ALIGNMENT_MODE_PROCRUSTES) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  g_alignment_mode = mode;
+  g_motion_gate.cache_valid = false; // 캐시된 목표 포즈는 이전 방식 기준
+  return SEGMENT_OK;
+}
+
+int segment_set_mirror_matching(bool enabled) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  g_mirror_matching = enabled;
+  g_last_match_mirrored = false;
+  g_motion_gate.cache_valid = false; // 캐시된 결과는 이전 설정 기준
+  return SEGMENT_OK;
+}
+
+int segment_get_last_match_mirrored(bool *out_mirrored) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (!out_mirrored) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  *out_mirrored = g_last_match_mirrored;
+  return SEGMENT_OK;
+}
+
+int segment_set_care_joints(const JointType *care_joints,
+                            int care_joint_count) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
+  }
+
+  if (!care_joints || care_joint_count <= 0) {
+    g_care_joints_enabled = false;
+    g_motion_gate.cache_valid = false; // 캐시된 결과는 이전 관절 집합 기준
+    return SEGMENT_OK;
+  }
+
+  JointSet joint_set;
+  int result = joint_set_compile(care_joints, care_joint_count, &joint_set);
   if (result != SEGMENT_OK) {
     return result;
   }
 
-  // 목표 포즈 반환
-  if (out_target_pose) {
-    result = segment_get_transformed_end_pose(out_target_pose);
-    if (result != SEGMENT_OK) {
-      printf("❌ 목표 포즈 가져오기 실패: 에러 코드 %d\n", result);
-      return result;
+  // 반전 매칭 시 사용할 좌우 대칭 집합도 미리 컴파일
+  JointType mirrored_joints[POSE_LANDMARK_COUNT];
+  for (int i = 0; i < joint_set.count; i++) {
+    mirrored_joints[i] = g_mirror_landmarks[joint_set.indices[i]];
+  }
+  result = joint_set_compile(mirrored_joints, joint_set.count,
+                             &g_care_joint_set_mirrored);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  g_care_joint_set = joint_set;
+  g_care_joints_enabled = true;
+  g_motion_gate.cache_valid = false; // 캐시된 결과는 이전 관절 집합 기준
+  return SEGMENT_OK;
+}
+
+// 사용자에 맞춰진 시작/종료 포즈와 현재 포즈를 비교 (검증된 포즈)
+// (반전 목표와 매칭되면 시작 포즈는 제자리에서, 목표 포즈는 mirror_buffer에
+// 반전, 시작 포즈는 진행도를 요청한 경우에만 사용)
+// out_target_pose에는 최종 목표 포즈 (smart_target_pose 또는 mirror_buffer)
+static int analyze_against_smart_poses(const PoseData *current_pose,
+                                       unsigned int outputs,
+                                       PoseData *smart_start_pose,
+                                       const PoseData *smart_target_pose,
+                                       PoseData *mirror_buffer,
+                                       const PoseData **out_target_pose,
+                                       float *out_progress,
+                                       float *out_similarity,
+                                       bool *out_is_complete,
+                                       Point3D *out_corrections) {
+  // 반전 매칭 방향은 유사도로 정해지므로 반전 매칭 중에는 항상 계산
+  bool mirrored = false;
+  float similarity = 0.0f;
+  if ((outputs & (SEGMENT_OUTPUT_SIMILARITY | SEGMENT_OUTPUT_COMPLETION)) ||
+      g_mirror_matching) {
+    similarity = calculate_session_similarity(current_pose, smart_target_pose,
+                                              &mirrored);
+  }
+  g_last_match_mirrored = mirrored;
+  if (mirrored) {
+    if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+      mirror_pose(smart_start_pose, smart_start_pose);
+    }
+    mirror_pose(smart_target_pose, mirror_buffer);
+    smart_target_pose = mirror_buffer;
+  }
+  *out_target_pose = smart_target_pose;
+
+  // 현재 포즈와 스마트 시작 포즈 → 스마트 종료 포즈 비교
+  const JointSet *care_set = care_joint_set_for(mirrored);
+  if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+    if (care_set) {
+      *out_progress = calculate_segment_progress_set(
+          current_pose, smart_start_pose, smart_target_pose, care_set);
+    } else {
+      *out_progress = calculate_segment_progress(
+          current_pose, smart_start_pose, smart_target_pose, NULL, 0);
+    }
+  }
+
+  // 교정 벡터 계산 (스마트 목표 포즈 기준)
+  if (outputs & SEGMENT_OUTPUT_CORRECTIONS) {
+    if (care_set) {
+      calculate_correction_vectors_set(current_pose, smart_target_pose,
+                                       care_set, out_corrections);
+    } else {
+      calculate_correction_vectors(current_pose, smart_target_pose, NULL, 0,
+                                   out_corrections);
     }
   }
 
+  // 완료 판단: 유사도 기반 (앱에서 최종 판단 권장)
+  *out_is_complete = (similarity >= 0.8f);
+  *out_similarity = similarity;
+
   return SEGMENT_OK;
 }
 
-int segment_analyze_smart(const PoseData *current_pose, ScaleMode scale_mode,
-                          float screen_width, float screen_height,
-                          float *out_progress, float *out_similarity,
-                          bool *out_is_complete, Point3D *out_corrections,
-                          PoseData *out_smart_target_pose) {
+// 현재 세그먼트의 스마트 목표 포즈 상수 계산 (세그먼트 포즈가 바뀔 때 호출)
+static void prepare_smart_anchor(void) {
+  const PoseData *start = &g_user_segment_start;
+  const PoseData *end = &g_user_segment_end;
+  const PoseLandmark *left_shoulder =
+      &end->landmarks[POSE_LANDMARK_LEFT_SHOULDER];
+  const PoseLandmark *right_shoulder =
+      &end->landmarks[POSE_LANDMARK_RIGHT_SHOULDER];
+  const PoseLandmark *left_ankle = &end->landmarks[POSE_LANDMARK_LEFT_ANKLE];
+
+  for (int mode = SCALE_MODE_MEASUREMENT; mode <= SCALE_MODE_EXERCISE;
+       mode++) {
+    SmartAnchorConstants *anchor = &g_smart_anchor[mode];
+    anchor->ladder = anchor_ladder_for(g_anchor_type, (ScaleMode)mode);
+
+    anchor->target_shoulders_valid =
+        left_shoulder->inFrameLikelihood >= 0.5f &&
+        right_shoulder->inFrameLikelihood >= 0.5f;
+
+    // 스케일 기준 길이 (운동 모드: 어깨 너비, 측정 모드: 왼쪽 어깨-발목)
+    anchor->scale_reference = 0.0f;
+    if (mode == SCALE_MODE_EXERCISE) {
+      if (left_shoulder->inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE &&
+          right_shoulder->inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE) {
+        float dx = left_shoulder->position.x - right_shoulder->position.x;
+        float dy = left_shoulder->position.y - right_shoulder->position.y;
+        anchor->scale_reference = sqrtf(dx * dx + dy * dy);
+      }
+    } else if (left_shoulder->inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE &&
+               left_ankle->inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE) {
+      float dx = left_shoulder->position.x - left_ankle->position.x;
+      float dy = left_shoulder->position.y - left_ankle->position.y;
+      float dz = left_shoulder->position.z - left_ankle->position.z;
+      anchor->scale_reference = sqrtf(dx * dx + dy * dy + dz * dz);
+    }
 
-  if (!current_pose || !out_progress || !out_similarity || !out_is_complete ||
-      !out_corrections || !out_smart_target_pose) {
-    return SEGMENT_ERROR_INVALID_PARAMETER;
+    anchor->target_center_valid =
+        resolve_anchor_point(end, anchor->ladder, &anchor->target_center);
+    if (!resolve_anchor_point(start, anchor->ladder, &anchor->start_center)) {
+      // 시작 포즈 중심점을 종료 포즈와 동일하게 설정
+      anchor->start_center = anchor->target_center;
+    }
+
+    // 측정 모드 좌우 중앙 고정용: 보이는 랜드마크의 중심 대비 x 평균
+    float sum_x = 0.0f;
+    int valid_landmarks = 0;
+    for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+      if (end->landmarks[i].inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE) {
+        sum_x += end->landmarks[i].position.x - anchor->target_center.x;
+        valid_landmarks++;
+      }
+    }
+    anchor->target_mean_offset_x =
+        (valid_landmarks > 0) ? sum_x / valid_landmarks : 0.0f;
   }
 
-  if (!g_initialized || !g_segment_loaded) {
-    return SEGMENT_ERROR_NOT_INITIALIZED;
+  calculate_joint_angles(end, g_target_joint_angles);
+  g_smart_pose_cache.valid = false;
+}
+
+// 포즈 위치를 (p - origin) * scale + offset 으로 변환
+static void transform_pose_positions(const PoseData *input,
+                                     const Point3D *origin, float scale,
+                                     const Point3D *offset, PoseData *output) {
+  *output = *input;
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    Point3D *p = &output->landmarks[i].position;
+    p->x = (p->x - origin->x) * scale + offset->x;
+    p->y = (p->y - origin->y) * scale + offset->y;
+    p->z = (p->z - origin->z) * scale + offset->z;
+  }
+}
+
+// 캐시된 스마트 포즈를 이번 프레임에 재사용할 수 있는지 확인
+static bool smart_pose_cache_matches(ScaleMode scale_mode, float screen_width,
+                                     const Point3D *current_center,
+                                     float scale, bool need_absolute,
+                                     bool need_start) {
+  const SmartPoseCache *cache = &g_smart_pose_cache;
+  if (!cache->valid || cache->scale_mode != scale_mode ||
+      (need_start && !cache->has_start)) {
+    return false;
+  }
+
+  if (fabsf(scale - cache->scale) > cache->scale_epsilon * cache->scale) {
+    return false;
+  }
+
+  // 골반 기준 상대 좌표만 쓰면 위치 이동은 결과에 영향 없음
+  if (!need_absolute) {
+    return true;
+  }
+
+  if (!cache->absolute || cache->screen_width != screen_width) {
+    return false;
+  }
+
+  float dx = current_center->x - cache->current_center.x;
+  float dy = current_center->y - cache->current_center.y;
+  float dz = current_center->z - cache->current_center.z;
+  return dx * dx + dy * dy + dz * dz <=
+         cache->center_epsilon * cache->center_epsilon;
+}
+
+// 스마트 시작/종료 포즈를 계산해 캐시에 저장
+static void build_smart_poses(const SmartAnchorConstants *anchor,
+                              ScaleMode scale_mode, float screen_width,
+                              const Point3D *current_center, float scale,
+                              bool absolute, bool with_start) {
+  SmartPoseCache *cache = &g_smart_pose_cache;
+  const Point3D zero = {0.0f, 0.0f, 0.0f};
+
+  if (!absolute) {
+    transform_pose_positions(&g_user_segment_end, &zero, scale, &zero,
+                             &cache->target_pose);
+    if (with_start) {
+      transform_pose_positions(&g_user_segment_start, &zero, scale, &zero,
+                               &cache->start_pose);
+    }
+  } else {
+    // 종료 포즈: 중심을 원점으로 옮기고 스케일 적용 후 사용자 위치로 이동
+    Point3D target_offset = *current_center;
+    if (scale_mode != SCALE_MODE_EXERCISE) {
+      // 측정 모드: 좌우는 화면 중앙 고정, 위아래는 사용자 따라다님
+      target_offset.x =
+          screen_width / 2.0f - anchor->target_mean_offset_x * scale;
+    }
+    transform_pose_positions(&g_user_segment_end, &anchor->target_center,
+                             scale, &target_offset, &cache->target_pose);
+
+    // 시작 포즈: 두 모드 모두 사용자 중심 위치로 이동
+    if (with_start) {
+      transform_pose_positions(&g_user_segment_start, &anchor->start_center,
+                               scale, current_center, &cache->start_pose);
+    }
   }
 
+  cache->valid = true;
+  cache->scale_mode = scale_mode;
+  cache->screen_width = screen_width;
+  cache->absolute = absolute;
+  cache->has_start = with_start;
+  cache->current_center = *current_center;
+  cache->scale = scale;
+}
+
+static int analyze_smart_full(const PoseData *current_pose,
+                              ScaleMode scale_mode, float screen_width,
+                              float screen_height, unsigned int outputs,
+                              float *out_progress, float *out_similarity,
+                              bool *out_is_complete, Point3D *out_corrections,
+                              PoseData *target_buffer,
+                              const PoseData **out_target_pose) {
+  (void)screen_height;
+
   // 0. 현재 포즈의 신뢰도 체크 (팔다리 필수 랜드마크 체크)
   int valid_landmarks = 0;
   int valid_arms = 0;
@@ -1375,106 +3179,74 @@ int segment_analyze_smart(const PoseData *current_pose, ScaleMode scale_mode,
     *out_progress = 0.0f;
     *out_similarity = 0.0f;
     *out_is_complete = false;
-    *out_smart_target_pose = g_user_segment_end; // 원본 종료 포즈 반환
+    *out_target_pose = &g_user_segment_end; // 원본 종료 포즈 반환
     return SEGMENT_OK; // 에러가 아닌 정상적인 조기 리턴
   }
 
-  // 1. 원본 시작 포즈와 종료 포즈 가져오기
-  PoseData raw_start_pose = g_user_segment_start;
-  PoseData raw_end_pose = g_user_segment_end;
+  // Procrustes 모드: 중심/스케일 규칙 대신 주요 관절의 상사 변환으로 정렬
+  if (g_alignment_mode == ALIGNMENT_MODE_PROCRUSTES) {
+    SimilarityTransform transform;
+    if (alignment_solve_poses(&g_user_segment_end, current_pose,
+                              &transform) == SEGMENT_OK) {
+      // 두 키포즈는 같은 좌표계이므로 시작 포즈에도 같은 변환 적용
+      PoseData smart_start_pose;
+      if (outputs & SEGMENT_OUTPUT_PROGRESS) {
+        alignment_apply(&transform, &g_user_segment_start, &smart_start_pose);
+      }
+      alignment_apply(&transform, &g_user_segment_end, target_buffer);
+      return analyze_against_smart_poses(
+          current_pose, outputs, &smart_start_pose, target_buffer,
+          target_buffer, out_target_pose, out_progress, out_similarity,
+          out_is_complete, out_corrections);
+    }
+    // 신뢰도 높은 관절이 부족하면 기존 방식으로 진행
+  }
+
+  // 1. 세그먼트 선택 시 계산해 둔 키포즈 상수
+  ScaleMode anchor_mode = (scale_mode == SCALE_MODE_EXERCISE)
+                              ? SCALE_MODE_EXERCISE
+                              : SCALE_MODE_MEASUREMENT;
+  const SmartAnchorConstants *anchor = &g_smart_anchor[anchor_mode];
 
-  // 3. 현재 포즈의 크기 측정 (어깨 너비 기준)
+  // 2. 어깨가 보이지 않으면 원본 목표 포즈와 비교해서 분석
   PoseLandmark current_left_shoulder =
       current_pose->landmarks[POSE_LANDMARK_LEFT_SHOULDER];
   PoseLandmark current_right_shoulder =
       current_pose->landmarks[POSE_LANDMARK_RIGHT_SHOULDER];
 
-  float current_shoulder_width = 0;
-  if (current_left_shoulder.inFrameLikelihood >= 0.5f &&
-      current_right_shoulder.inFrameLikelihood >= 0.5f) {
-    float dx =
-        current_left_shoulder.position.x - current_right_shoulder.position.x;
-    float dy =
-        current_left_shoulder.position.y - current_right_shoulder.position.y;
-    current_shoulder_width = sqrtf(dx * dx + dy * dy);
-  } else {
-    *out_smart_target_pose = raw_end_pose;
-    // 스마트 목표 포즈가 원본과 같다면 원본과 비교해서 분석
-    return segment_analyze_simple(current_pose, out_progress, out_is_complete,
-                                  out_similarity, out_corrections);
-  }
-
-  // 2. 스케일 모드에 따른 처리
-  // 두 모드 모두 스케일 조정은 함 (사용자 체형에 맞춤)
-  // 차이점: 위치 변환 여부
-
-  // 4. 종료 포즈의 크기 측정 (어깨 너비 기준)
-  PoseLandmark target_left_shoulder =
-      raw_end_pose.landmarks[POSE_LANDMARK_LEFT_SHOULDER];
-  PoseLandmark target_right_shoulder =
-      raw_end_pose.landmarks[POSE_LANDMARK_RIGHT_SHOULDER];
-
-  float target_shoulder_width = 0;
-  if (target_left_shoulder.inFrameLikelihood >= 0.5f &&
-      target_right_shoulder.inFrameLikelihood >= 0.5f) {
-    float dx =
-        target_left_shoulder.position.x - target_right_shoulder.position.x;
-    float dy =
-        target_left_shoulder.position.y - target_right_shoulder.position.y;
-    target_shoulder_width = sqrtf(dx * dx + dy * dy);
-  } else {
-    *out_smart_target_pose = raw_end_pose;
-    // 스마트 목표 포즈가 원본과 같다면 원본과 비교해서 분석
-    return segment_analyze_simple(current_pose, out_progress, out_is_complete,
-                                  out_similarity, out_corrections);
+  if (current_left_shoulder.inFrameLikelihood < 0.5f ||
+      current_right_shoulder.inFrameLikelihood < 0.5f ||
+      !anchor->target_shoulders_valid) {
+    *out_target_pose = &g_user_segment_end;
+    return analyze_simple_masked(current_pose, outputs, out_progress,
+                                 out_is_complete, out_similarity,
+                                 out_corrections);
   }
 
-  // 5. 크기 조정을 위한 스케일 계산
+  // 3. 크기 조정을 위한 스케일 계산
   float scale = 1.0f;
 
-  if (scale_mode == SCALE_MODE_EXERCISE) {
+  if (anchor_mode == SCALE_MODE_EXERCISE) {
     // 운동 모드: 어깨 사이 거리 기준
-    float current_shoulder_width = 0.0f;
-    float target_shoulder_width = 0.0f;
-
-    // 현재 포즈의 어깨 너비 계산
-    if (current_left_shoulder.inFrameLikelihood >= 0.3f &&
-        current_right_shoulder.inFrameLikelihood >= 0.3f) {
-      float dx =
-          current_left_shoulder.position.x - current_right_shoulder.position.x;
-      float dy =
-          current_left_shoulder.position.y - current_right_shoulder.position.y;
-      current_shoulder_width = sqrtf(dx * dx + dy * dy);
-    }
-
-    // 타겟 포즈의 어깨 너비 계산
-    if (target_left_shoulder.inFrameLikelihood >= 0.3f &&
-        target_right_shoulder.inFrameLikelihood >= 0.3f) {
-      float dx =
-          target_left_shoulder.position.x - target_right_shoulder.position.x;
-      float dy =
-          target_left_shoulder.position.y - target_right_shoulder.position.y;
-      target_shoulder_width = sqrtf(dx * dx + dy * dy);
-    }
+    float dx =
+        current_left_shoulder.position.x - current_right_shoulder.position.x;
+    float dy =
+        current_left_shoulder.position.y - current_right_shoulder.position.y;
+    float current_shoulder_width = sqrtf(dx * dx + dy * dy);
 
     // 스케일 계산 후 약간 작게 조정 (90%)
-    float raw_scale = (target_shoulder_width > 0)
-                          ? current_shoulder_width / target_shoulder_width
+    float raw_scale = (anchor->scale_reference > 0)
+                          ? current_shoulder_width / anchor->scale_reference
                           : 1.0f;
     scale = raw_scale * 0.90f; // 10% 작게
-
   } else {
-    // 측정 모드: 어깨-발목 거리 기준 (기존 방식)
+    // 측정 모드: 왼쪽 어깨-발목 거리 기준
     float current_shoulder_ankle_distance = 0.0f;
-    float target_shoulder_ankle_distance = 0.0f;
-
-    // 현재 포즈의 왼쪽 발목 랜드마크 가져오기
     PoseLandmark current_left_ankle =
         current_pose->landmarks[POSE_LANDMARK_LEFT_ANKLE];
 
-    // 현재 포즈의 왼쪽 어깨-발목 거리 계산
-    if (current_left_shoulder.inFrameLikelihood >= 0.3f &&
-        current_left_ankle.inFrameLikelihood >= 0.3f) {
+    if (current_left_shoulder.inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE &&
+        current_left_ankle.inFrameLikelihood >= ANCHOR_MIN_CONFIDENCE) {
       float dx =
           current_left_shoulder.position.x - current_left_ankle.position.x;
       float dy =
@@ -1484,371 +3256,124 @@ int segment_analyze_smart(const PoseData *current_pose, ScaleMode scale_mode,
       current_shoulder_ankle_distance = sqrtf(dx * dx + dy * dy + dz * dz);
     }
 
-    // 타겟 포즈의 왼쪽 발목 랜드마크 가져오기
-    PoseLandmark target_left_ankle =
-        raw_end_pose.landmarks[POSE_LANDMARK_LEFT_ANKLE];
-
-    // 타겟 포즈의 왼쪽 어깨-발목 거리 계산
-    if (target_left_shoulder.inFrameLikelihood >= 0.3f &&
-        target_left_ankle.inFrameLikelihood >= 0.3f) {
-      float dx = target_left_shoulder.position.x - target_left_ankle.position.x;
-      float dy = target_left_shoulder.position.y - target_left_ankle.position.y;
-      float dz = target_left_shoulder.position.z - target_left_ankle.position.z;
-      target_shoulder_ankle_distance = sqrtf(dx * dx + dy * dy + dz * dz);
-    }
+    scale = (anchor->scale_reference > 0)
+                ? current_shoulder_ankle_distance / anchor->scale_reference
+                : 1.0f;
+  }
 
-    scale =
-        (target_shoulder_ankle_distance > 0)
-            ? current_shoulder_ankle_distance / target_shoulder_ankle_distance
-            : 1.0f;
+  // 4. 현재 사용자의 기준점 (기본값 운동 모드: 발 중심, 측정 모드: 골반 중심)
+  Point3D current_center;
+  if (!resolve_anchor_point(current_pose, anchor->ladder, &current_center) ||
+      !anchor->target_center_valid) {
+    // 그냥 원본 목표 포즈 반환
+    *out_target_pose = &g_user_segment_end;
+    return analyze_simple_masked(current_pose, outputs, out_progress,
+                                 out_is_complete, out_similarity,
+                                 out_corrections);
   }
 
-  // 6. 현재 사용자의 중심점 계산 (운동 모드: 발 중심, 측정 모드: 골반 중심)
-  Point3D current_center = {0};
+  // 5. 스마트 시작/종료 포즈 (중심/스케일 변화가 허용 오차 이내면 재사용)
+  // 진행도/유사도는 골반 기준 상대 좌표만 쓰므로, 교정 벡터와 목표 포즈를
+  // 요청하지 않으면 위치 이동 없이 스케일만 적용
+  bool need_absolute = (outputs & (SEGMENT_OUTPUT_CORRECTIONS |
+                                   SEGMENT_OUTPUT_TARGET_POSE)) != 0;
+  bool need_start = (outputs & SEGMENT_OUTPUT_PROGRESS) != 0;
 
-  if (scale_mode == SCALE_MODE_EXERCISE) {
-    // 운동 모드: 발과 발 사이 중심점 계산
-    PoseLandmark current_left_ankle =
-        current_pose->landmarks[POSE_LANDMARK_LEFT_ANKLE];
-    PoseLandmark current_right_ankle =
-        current_pose->landmarks[POSE_LANDMARK_RIGHT_ANKLE];
-
-    if (current_left_ankle.inFrameLikelihood >= 0.3f &&
-        current_right_ankle.inFrameLikelihood >= 0.3f) {
-      current_center.x =
-          (current_left_ankle.position.x + current_right_ankle.position.x) /
-          2.0f;
-      current_center.y =
-          (current_left_ankle.position.y + current_right_ankle.position.y) /
-          2.0f;
-      current_center.z =
-          (current_left_ankle.position.z + current_right_ankle.position.z) /
-          2.0f;
-    } else if (current_left_ankle.inFrameLikelihood >= 0.3f) {
-      current_center = current_left_ankle.position;
-    } else if (current_right_ankle.inFrameLikelihood >= 0.3f) {
-      current_center = current_right_ankle.position;
-    } else {
-      // 발이 감지되지 않으면 골반 중심으로 대체
-      PoseLandmark current_left_hip =
-          current_pose->landmarks[POSE_LANDMARK_LEFT_HIP];
-      PoseLandmark current_right_hip =
-          current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP];
-
-      if (current_left_hip.inFrameLikelihood >= 0.3f &&
-          current_right_hip.inFrameLikelihood >= 0.3f) {
-        current_center.x =
-            (current_left_hip.position.x + current_right_hip.position.x) / 2.0f;
-        current_center.y =
-            (current_left_hip.position.y + current_right_hip.position.y) / 2.0f;
-        current_center.z =
-            (current_left_hip.position.z + current_right_hip.position.z) / 2.0f;
-      } else if (current_left_hip.inFrameLikelihood >= 0.3f) {
-        current_center = current_left_hip.position;
-      } else if (current_right_hip.inFrameLikelihood >= 0.3f) {
-        current_center = current_right_hip.position;
-      } else {
-        // 그냥 원본 목표 포즈 반환
-        *out_smart_target_pose = raw_end_pose;
-        return segment_analyze_simple(current_pose, out_progress,
-                                      out_is_complete, out_similarity,
-                                      out_corrections);
-      }
-    }
+  if (smart_pose_cache_matches(anchor_mode, screen_width, &current_center,
+                               scale, need_absolute, need_start)) {
+    g_smart_pose_cache.hits++;
   } else {
-    // 측정 모드: 골반 중심점 계산
-    PoseLandmark current_left_hip =
-        current_pose->landmarks[POSE_LANDMARK_LEFT_HIP];
-    PoseLandmark current_right_hip =
-        current_pose->landmarks[POSE_LANDMARK_RIGHT_HIP];
-
-    if (current_left_hip.inFrameLikelihood >= 0.3f &&
-        current_right_hip.inFrameLikelihood >= 0.3f) {
-      current_center.x =
-          (current_left_hip.position.x + current_right_hip.position.x) / 2.0f;
-      current_center.y =
-          (current_left_hip.position.y + current_right_hip.position.y) / 2.0f;
-      current_center.z =
-          (current_left_hip.position.z + current_right_hip.position.z) / 2.0f;
-    } else if (current_left_hip.inFrameLikelihood >= 0.3f) {
-      current_center = current_left_hip.position;
-    } else if (current_right_hip.inFrameLikelihood >= 0.3f) {
-      current_center = current_right_hip.position;
-    } else {
-      // 그냥 원본 목표 포즈 반환
-      *out_smart_target_pose = raw_end_pose;
-      return segment_analyze_simple(current_pose, out_progress, out_is_complete,
-                                    out_similarity, out_corrections);
-    }
+    build_smart_poses(anchor, anchor_mode, screen_width, &current_center,
+                      scale, need_absolute, need_start);
+    g_smart_pose_cache.misses++;
   }
 
-  // 목표 포즈의 중심점 계산 (운동 모드: 발목 중심, 측정 모드: 골반 중심)
-  Point3D target_center = {0};
-
-  if (scale_mode == SCALE_MODE_EXERCISE) {
-    // 운동 모드: 타겟 포즈의 발목 중심점 계산
-    PoseLandmark target_left_ankle =
-        raw_end_pose.landmarks[POSE_LANDMARK_LEFT_ANKLE];
-    PoseLandmark target_right_ankle =
-        raw_end_pose.landmarks[POSE_LANDMARK_RIGHT_ANKLE];
-
-    if (target_left_ankle.inFrameLikelihood >= 0.3f &&
-        target_right_ankle.inFrameLikelihood >= 0.3f) {
-      target_center.x =
-          (target_left_ankle.position.x + target_right_ankle.position.x) / 2.0f;
-      target_center.y =
-          (target_left_ankle.position.y + target_right_ankle.position.y) / 2.0f;
-      target_center.z =
-          (target_left_ankle.position.z + target_right_ankle.position.z) / 2.0f;
-    } else if (target_left_ankle.inFrameLikelihood >= 0.3f) {
-      target_center = target_left_ankle.position;
-    } else if (target_right_ankle.inFrameLikelihood >= 0.3f) {
-      target_center = target_right_ankle.position;
-    } else {
-      // 발목이 감지되지 않으면 골반 중심으로 대체
-      PoseLandmark target_left_hip =
-          raw_end_pose.landmarks[POSE_LANDMARK_LEFT_HIP];
-      PoseLandmark target_right_hip =
-          raw_end_pose.landmarks[POSE_LANDMARK_RIGHT_HIP];
-
-      if (target_left_hip.inFrameLikelihood >= 0.3f &&
-          target_right_hip.inFrameLikelihood >= 0.3f) {
-        target_center.x =
-            (target_left_hip.position.x + target_right_hip.position.x) / 2.0f;
-        target_center.y =
-            (target_left_hip.position.y + target_right_hip.position.y) / 2.0f;
-        target_center.z =
-            (target_left_hip.position.z + target_right_hip.position.z) / 2.0f;
-      } else if (target_left_hip.inFrameLikelihood >= 0.3f) {
-        target_center = target_left_hip.position;
-      } else if (target_right_hip.inFrameLikelihood >= 0.3f) {
-        target_center = target_right_hip.position;
-      } else {
-        *out_smart_target_pose = raw_end_pose;
-        return segment_analyze_simple(current_pose, out_progress,
-                                      out_is_complete, out_similarity,
-                                      out_corrections);
-      }
-    }
-  } else {
-    // 측정 모드: 타겟 포즈의 골반 중심점 계산
-    PoseLandmark target_left_hip =
-        raw_end_pose.landmarks[POSE_LANDMARK_LEFT_HIP];
-    PoseLandmark target_right_hip =
-        raw_end_pose.landmarks[POSE_LANDMARK_RIGHT_HIP];
-
-    if (target_left_hip.inFrameLikelihood >= 0.3f &&
-        target_right_hip.inFrameLikelihood >= 0.3f) {
-      target_center.x =
-          (target_left_hip.position.x + target_right_hip.position.x) / 2.0f;
-      target_center.y =
-          (target_left_hip.position.y + target_right_hip.position.y) / 2.0f;
-      target_center.z =
-          (target_left_hip.position.z + target_right_hip.position.z) / 2.0f;
-    } else if (target_left_hip.inFrameLikelihood >= 0.3f) {
-      target_center = target_left_hip.position;
-    } else if (target_right_hip.inFrameLikelihood >= 0.3f) {
-      target_center = target_right_hip.position;
-    } else {
-      *out_smart_target_pose = raw_end_pose;
-      return segment_analyze_simple(current_pose, out_progress, out_is_complete,
-                                    out_similarity, out_corrections);
-    }
+  // 시작 포즈는 반전 매칭 시 제자리에서 반전되므로 캐시 사본으로 분석
+  // (목표 포즈는 캐시를 그대로 읽고 반전이 필요할 때만 target_buffer에 기록)
+  PoseData smart_start_pose;
+  if (need_start) {
+    smart_start_pose = g_smart_pose_cache.start_pose;
   }
 
-  // 8. 스마트 시작 포즈와 종료 포즈 생성
-  PoseData smart_start_pose = raw_start_pose;
-  *out_smart_target_pose = raw_end_pose;
-
-  // 8-1. 스마트 종료 포즈 조정
+  // 6. 스마트 목표 포즈와 비교해서 분석 수행
+  return analyze_against_smart_poses(
+      current_pose, outputs, &smart_start_pose, &g_smart_pose_cache.target_pose,
+      target_buffer, out_target_pose, out_progress, out_similarity,
+      out_is_complete, out_corrections);
+}
 
-  // 1단계: 타겟 포즈의 중심을 원점으로 이동
-  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-    out_smart_target_pose->landmarks[i].position.x -= target_center.x;
-    out_smart_target_pose->landmarks[i].position.y -= target_center.y;
-    out_smart_target_pose->landmarks[i].position.z -= target_center.z;
+int segment_get_realtime_target_pose(const PoseData *current_pose,
+                                     PoseData *out_target_pose) {
+  if (!g_initialized || !g_segment_loaded) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
   }
 
-  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-    out_smart_target_pose->landmarks[i].position.x *= scale;
-    out_smart_target_pose->landmarks[i].position.y *= scale;
-    out_smart_target_pose->landmarks[i].position.z *= scale;
+  if (!current_pose || !out_target_pose) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // 모드에 따른 위치 변환
-  if (scale_mode == SCALE_MODE_EXERCISE) {
-    // 운동 모드: 사용자 발 중심 따라다님
-    for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-      out_smart_target_pose->landmarks[i].position.x += current_center.x;
-      out_smart_target_pose->landmarks[i].position.y += current_center.y;
-      out_smart_target_pose->landmarks[i].position.z += current_center.z;
-    }
-  } else {
-    // 측정 모드: 좌우는 화면 중앙 고정, 위아래는 사용자 따라다님
-    float screen_center_x = screen_width / 2.0f;
-
-    // 포즈의 X 중심점 계산 (좌우 중앙 고정용)
-    Point3D pose_center_x = {0.0f, 0.0f, 0.0f};
-    int valid_landmarks = 0;
-
-    for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-      if (out_smart_target_pose->landmarks[i].inFrameLikelihood >= 0.3f) {
-        pose_center_x.x += out_smart_target_pose->landmarks[i].position.x;
-        valid_landmarks++;
-      }
-    }
-
-    if (valid_landmarks > 0) {
-      pose_center_x.x /= valid_landmarks;
-    }
+  // 현재는 단순히 변환된 종료 포즈 반환
+  // 추후 사용자 위치 기반 실시간 조정 로직 추가 예정
+  *out_target_pose = g_user_segment_end;
 
-    // X축만 화면 중앙에 고정, Y축은 사용자 골반 중심점 따라다님
-    float offset_x = screen_center_x - pose_center_x.x;
+  return SEGMENT_OK;
+}
 
-    for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-      out_smart_target_pose->landmarks[i].position.x +=
-          offset_x; // X축만 화면 중앙 고정
-      out_smart_target_pose->landmarks[i].position.y +=
-          current_center.y; // Y축은 사용자 중심 따라다님
-      out_smart_target_pose->landmarks[i].position.z +=
-          current_center.z; // Z축도 사용자 중심 따라다님
-    }
+int segment_build_pose_index(PoseIndex **out_index) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
   }
 
-  // 8-2. 스마트 시작 포즈 조정
-  // 시작 포즈의 중심점 계산 (운동 모드: 발목 중심, 측정 모드: 골반 중심)
-  Point3D start_center = {0};
-
-  if (scale_mode == SCALE_MODE_EXERCISE) {
-    // 운동 모드: 시작 포즈의 발목 중심점 계산
-    PoseLandmark start_left_ankle =
-        raw_start_pose.landmarks[POSE_LANDMARK_LEFT_ANKLE];
-    PoseLandmark start_right_ankle =
-        raw_start_pose.landmarks[POSE_LANDMARK_RIGHT_ANKLE];
-
-    if (start_left_ankle.inFrameLikelihood >= 0.3f &&
-        start_right_ankle.inFrameLikelihood >= 0.3f) {
-      start_center.x =
-          (start_left_ankle.position.x + start_right_ankle.position.x) / 2.0f;
-      start_center.y =
-          (start_left_ankle.position.y + start_right_ankle.position.y) / 2.0f;
-      start_center.z =
-          (start_left_ankle.position.z + start_right_ankle.position.z) / 2.0f;
-    } else if (start_left_ankle.inFrameLikelihood >= 0.3f) {
-      start_center = start_left_ankle.position;
-    } else if (start_right_ankle.inFrameLikelihood >= 0.3f) {
-      start_center = start_right_ankle.position;
-    } else {
-      // 발목이 감지되지 않으면 골반 중심으로 대체
-      PoseLandmark start_left_hip =
-          raw_start_pose.landmarks[POSE_LANDMARK_LEFT_HIP];
-      PoseLandmark start_right_hip =
-          raw_start_pose.landmarks[POSE_LANDMARK_RIGHT_HIP];
-
-      if (start_left_hip.inFrameLikelihood >= 0.3f &&
-          start_right_hip.inFrameLikelihood >= 0.3f) {
-        start_center.x =
-            (start_left_hip.position.x + start_right_hip.position.x) / 2.0f;
-        start_center.y =
-            (start_left_hip.position.y + start_right_hip.position.y) / 2.0f;
-        start_center.z =
-            (start_left_hip.position.z + start_right_hip.position.z) / 2.0f;
-      } else if (start_left_hip.inFrameLikelihood >= 0.3f) {
-        start_center = start_left_hip.position;
-      } else if (start_right_hip.inFrameLikelihood >= 0.3f) {
-        start_center = start_right_hip.position;
-      } else {
-        // 시작 포즈 중심점을 종료 포즈와 동일하게 설정
-        start_center = target_center;
-      }
-    }
-  } else {
-    // 측정 모드: 시작 포즈의 골반 중심점 계산
-    PoseLandmark start_left_hip =
-        raw_start_pose.landmarks[POSE_LANDMARK_LEFT_HIP];
-    PoseLandmark start_right_hip =
-        raw_start_pose.landmarks[POSE_LANDMARK_RIGHT_HIP];
-
-    if (start_left_hip.inFrameLikelihood >= 0.3f &&
-        start_right_hip.inFrameLikelihood >= 0.3f) {
-      start_center.x =
-          (start_left_hip.position.x + start_right_hip.position.x) / 2.0f;
-      start_center.y =
-          (start_left_hip.position.y + start_right_hip.position.y) / 2.0f;
-      start_center.z =
-          (start_left_hip.position.z + start_right_hip.position.z) / 2.0f;
-    } else if (start_left_hip.inFrameLikelihood >= 0.3f) {
-      start_center = start_left_hip.position;
-    } else if (start_right_hip.inFrameLikelihood >= 0.3f) {
-      start_center = start_right_hip.position;
-    } else {
-      // 시작 포즈 중심점을 종료 포즈와 동일하게 설정
-      start_center = target_center;
-    }
+  if (!out_index) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // 1단계: 시작 포즈의 중심을 원점으로 이동
-  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-    smart_start_pose.landmarks[i].position.x -= start_center.x;
-    smart_start_pose.landmarks[i].position.y -= start_center.y;
-    smart_start_pose.landmarks[i].position.z -= start_center.z;
+  if (!g_all_segments_loaded || !g_segment_embeddings) {
+    return SEGMENT_ERROR_SEGMENT_NOT_CREATED;
   }
 
-  // 2단계: 현재 키에 맞춰 전체 스케일 적용
-  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-    smart_start_pose.landmarks[i].position.x *= scale;
-    smart_start_pose.landmarks[i].position.y *= scale;
-    smart_start_pose.landmarks[i].position.z *= scale;
-  }
+  return pose_index_build_from_embeddings(g_segment_embeddings,
+                                          g_total_segment_count, out_index);
+}
 
-  // 3단계: 현재 사용자의 중심 위치로 이동
-  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
-    smart_start_pose.landmarks[i].position.x += current_center.x;
-    smart_start_pose.landmarks[i].position.y += current_center.y;
-    smart_start_pose.landmarks[i].position.z += current_center.z;
+int segment_score_against_all(const PoseData *frame, float *out_scores) {
+  if (!g_initialized) {
+    return SEGMENT_ERROR_NOT_INITIALIZED;
   }
 
-  // 3. 스마트 목표 포즈와 비교해서 분석 수행
-  // 포즈 데이터 유효성 검사
-  if (!segment_validate_pose(current_pose)) {
-    return SEGMENT_ERROR_INVALID_POSE;
+  if (!frame) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // 현재 포즈와 스마트 시작 포즈 → 스마트 종료 포즈 비교
-  float progress = calculate_segment_progress(current_pose, &smart_start_pose,
-                                              out_smart_target_pose, NULL, 0);
-
-  float similarity =
-      segment_calculate_similarity(current_pose, out_smart_target_pose);
-
-  // 완료 판단: 유사도 기반 (앱에서 최종 판단 권장)
-  bool completed = (similarity >= 0.8f);
-
-  // 교정 벡터 계산 (스마트 목표 포즈 기준)
-  calculate_correction_vectors(current_pose, out_smart_target_pose, NULL, 0,
-                               out_corrections);
-
-  *out_progress = progress;
-  *out_is_complete = completed;
-  *out_similarity = similarity;
+  if (!g_all_segments_loaded) {
+    return SEGMENT_ERROR_SEGMENT_NOT_CREATED;
+  }
 
-  return SEGMENT_OK;
+  if (g_quantized_score_table.data) {
+    return score_table_score_quantized(&g_quantized_score_table, frame,
+                                       out_scores);
+  }
+  if (!g_segment_score_table.data) {
+    return SEGMENT_ERROR_SEGMENT_NOT_CREATED;
+  }
+  return score_table_score(&g_segment_score_table, frame, out_scores);
 }
 
-int segment_get_realtime_target_pose(const PoseData *current_pose,
-                                     PoseData *out_target_pose) {
-  if (!g_initialized || !g_segment_loaded) {
+int segment_get_pose_embeddings(const float **out_embeddings, int *out_count) {
+  if (!g_initialized) {
     return SEGMENT_ERROR_NOT_INITIALIZED;
   }
 
-  if (!current_pose || !out_target_pose) {
+  if (!out_embeddings || !out_count) {
     return SEGMENT_ERROR_INVALID_PARAMETER;
   }
 
-  // 현재는 단순히 변환된 종료 포즈 반환
-  // 추후 사용자 위치 기반 실시간 조정 로직 추가 예정
-  *out_target_pose = g_user_segment_end;
+  if (!g_all_segments_loaded || !g_segment_embeddings) {
+    return SEGMENT_ERROR_SEGMENT_NOT_CREATED;
+  }
 
+  *out_embeddings = g_segment_embeddings;
+  *out_count = g_total_segment_count;
   return SEGMENT_OK;
 }
 
@@ -0,0 +1,210 @@
+/**
+ * @file segment_memory.c
+ * @brief 교체 가능한 메모리 할당자와 용도별 사용량 집계 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/segment_memory.h"
+#include <stdlib.h>
+#include <string.h>
+
+// 각 블록 앞에 붙는 헤더 (해제 시 크기와 용도 확인용)
+// long double과 겹쳐 반환 주소 정렬을 할당자 반환 주소와 같게 유지
+typedef union {
+  struct {
+    size_t size;
+    SegmentMemoryCategory category;
+  } info;
+  long double align;
+} MemoryBlockHeader;
+
+static void *default_allocate(size_t size, void *user_data) {
+  (void)user_data;
+  return malloc(size);
+}
+
+static void *default_reallocate(void *ptr, size_t size, void *user_data) {
+  (void)user_data;
+  return realloc(ptr, size);
+}
+
+static void default_release(void *ptr, void *user_data) {
+  (void)user_data;
+  free(ptr);
+}
+
+static const SegmentAllocator g_default_allocator = {
+    default_allocate, default_reallocate, default_release, NULL};
+
+static SegmentAllocator g_allocator = {default_allocate, default_reallocate,
+                                       default_release, NULL};
+static SegmentMemoryStats g_memory_stats[SEGMENT_MEMORY_CATEGORY_COUNT];
+
+static void record_allocation(SegmentMemoryCategory category, size_t size) {
+  SegmentMemoryStats *stats = &g_memory_stats[category];
+  stats->live_bytes += size;
+  stats->allocations++;
+  if (stats->live_bytes > stats->peak_bytes) {
+    stats->peak_bytes = stats->live_bytes;
+  }
+}
+
+int segment_set_allocator(const SegmentAllocator *allocator) {
+  if (allocator && (!allocator->allocate || !allocator->reallocate ||
+                    !allocator->release)) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 이전 할당자로 받은 블록이 남아 있으면 교체 불가
+  for (int i = 0; i < SEGMENT_MEMORY_CATEGORY_COUNT; i++) {
+    if (g_memory_stats[i].live_bytes > 0) {
+      return SEGMENT_ERROR_INVALID_PARAMETER;
+    }
+  }
+
+  g_allocator = allocator ? *allocator : g_default_allocator;
+  memset(g_memory_stats, 0, sizeof(g_memory_stats));
+  return SEGMENT_OK;
+}
+
+int segment_get_memory_stats(SegmentMemoryCategory category,
+                             SegmentMemoryStats *out_stats) {
+  if ((unsigned)category >= SEGMENT_MEMORY_CATEGORY_COUNT || !out_stats) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  *out_stats = g_memory_stats[category];
+  return SEGMENT_OK;
+}
+
+void segment_reset_memory_peaks(void) {
+  for (int i = 0; i < SEGMENT_MEMORY_CATEGORY_COUNT; i++) {
+    g_memory_stats[i].peak_bytes = g_memory_stats[i].live_bytes;
+  }
+}
+
+void *segment_mem_alloc(SegmentMemoryCategory category, size_t size) {
+  if (size == 0 || size > SIZE_MAX - sizeof(MemoryBlockHeader)) {
+    return NULL;
+  }
+
+  MemoryBlockHeader *header = g_allocator.allocate(
+      sizeof(MemoryBlockHeader) + size, g_allocator.user_data);
+  if (!header) {
+    return NULL;
+  }
+
+  header->info.size = size;
+  header->info.category = category;
+  record_allocation(category, size);
+  return header + 1;
+}
+
+void *segment_mem_calloc(SegmentMemoryCategory category, size_t count,
+                         size_t size) {
+  if (size != 0 && count > SIZE_MAX / size) {
+    return NULL;
+  }
+
+  void *ptr = segment_mem_alloc(category, count * size);
+  if (ptr) {
+    memset(ptr, 0, count * size);
+  }
+  return ptr;
+}
+
+void *segment_mem_realloc(SegmentMemoryCategory category, void *ptr,
+                          size_t size) {
+  if (!ptr) {
+    return segment_mem_alloc(category, size);
+  }
+  if (size == 0 || size > SIZE_MAX - sizeof(MemoryBlockHeader)) {
+    return NULL;
+  }
+
+  MemoryBlockHeader *header = (MemoryBlockHeader *)ptr - 1;
+  size_t old_size = header->info.size;
+  SegmentMemoryCategory old_category = header->info.category;
+
+  header = g_allocator.reallocate(header, sizeof(MemoryBlockHeader) + size,
+                                  g_allocator.user_data);
+  if (!header) {
+    return NULL;
+  }
+
+  g_memory_stats[old_category].live_bytes -= old_size;
+  header->info.size = size;
+  header->info.category = category;
+  record_allocation(category, size);
+  return header + 1;
+}
+
+void segment_mem_free(void *ptr) {
+  if (!ptr) {
+    return;
+  }
+
+  MemoryBlockHeader *header = (MemoryBlockHeader *)ptr - 1;
+  g_memory_stats[header->info.category].live_bytes -= header->info.size;
+  g_allocator.release(header, g_allocator.user_data);
+}
+
+size_t segment_arena_footprint(size_t size) {
+  return (size + SEGMENT_ARENA_ALIGNMENT - 1) &
+         ~(size_t)(SEGMENT_ARENA_ALIGNMENT - 1);
+}
+
+int segment_arena_init(SegmentArena *arena, SegmentMemoryCategory category,
+                       size_t capacity) {
+  if (!arena || capacity == 0 ||
+      capacity > SIZE_MAX - SEGMENT_ARENA_ALIGNMENT) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  memset(arena, 0, sizeof(SegmentArena));
+
+  // 시작 주소를 정렬 단위에 맞추기 위한 여유 공간 포함
+  arena->block =
+      segment_mem_alloc(category, capacity + SEGMENT_ARENA_ALIGNMENT - 1);
+  if (!arena->block) {
+    return SEGMENT_ERROR_MEMORY_ALLOCATION;
+  }
+
+  uintptr_t address = (uintptr_t)arena->block;
+  address = (address + SEGMENT_ARENA_ALIGNMENT - 1) &
+            ~(uintptr_t)(SEGMENT_ARENA_ALIGNMENT - 1);
+  arena->base = (unsigned char *)address;
+  arena->capacity = capacity;
+  return SEGMENT_OK;
+}
+
+void *segment_arena_alloc(SegmentArena *arena, size_t size) {
+  if (!arena || !arena->base || size == 0) {
+    return NULL;
+  }
+
+  size_t footprint = segment_arena_footprint(size);
+  if (footprint < size || footprint > arena->capacity - arena->used) {
+    return NULL;
+  }
+
+  void *ptr = arena->base + arena->used;
+  arena->used += footprint;
+  return ptr;
+}
+
+void segment_arena_reset(SegmentArena *arena) {
+  if (arena) {
+    arena->used = 0;
+  }
+}
+
+void segment_arena_release(SegmentArena *arena) {
+  if (!arena) {
+    return;
+  }
+
+  segment_mem_free(arena->block);
+  memset(arena, 0, sizeof(SegmentArena));
+}
@@ -0,0 +1,124 @@
+/**
+ * @file skeleton.c
+ * @brief 뼈 방향 기반 포즈 표현과 순운동학 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/skeleton.h"
+#include "../include/math_utils.h"
+#include <math.h>
+#include <string.h>
+
+// 이보다 짧은 뼈는 방향을 정의하지 않음
+#define SKELETON_MIN_BONE_LENGTH 1e-6f
+
+int skeleton_from_pose(const PoseData *pose, SkeletonPose *out_skeleton) {
+  if (!pose || !out_skeleton) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  RetargetSkeleton hierarchy;
+  retarget_skeleton_init(&hierarchy, NULL);
+
+  Point3D root = calculate_hip_center(pose);
+  out_skeleton->root_position = root;
+  out_skeleton->timestamp = pose->timestamp;
+
+  for (int b = 0; b < RETARGET_BONE_COUNT; b++) {
+    const RetargetBone *bone = &hierarchy.bones[b];
+    const Point3D *parent = (bone->parent == RETARGET_ROOT)
+                                ? &root
+                                : &pose->landmarks[bone->parent].position;
+    const Point3D *child = &pose->landmarks[bone->child].position;
+
+    Point3D delta = {child->x - parent->x, child->y - parent->y,
+                     child->z - parent->z};
+    float length = sqrtf(delta.x * delta.x + delta.y * delta.y +
+                         delta.z * delta.z);
+
+    if (length > SKELETON_MIN_BONE_LENGTH) {
+      float inv_length = 1.0f / length;
+      out_skeleton->directions[b] = (Point3D){
+          delta.x * inv_length, delta.y * inv_length, delta.z * inv_length};
+      out_skeleton->lengths[b] = length;
+    } else {
+      out_skeleton->directions[b] = (Point3D){0.0f, 0.0f, 0.0f};
+      out_skeleton->lengths[b] = 0.0f;
+    }
+  }
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    out_skeleton->confidences[i] = pose->landmarks[i].inFrameLikelihood;
+  }
+
+  return SEGMENT_OK;
+}
+
+int skeleton_rig_init(SkeletonRig *rig, const CalibrationData *calibration) {
+  if (!rig) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  bool calibrated = calibration && calibration->is_calibrated;
+  float root_scale = calibrated ? calibration->scale_factor : 1.0f;
+  if (root_scale <= 0.0f) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  rig->root_scale = root_scale;
+  rig->root_offset = calibrated ? calibration->center_offset
+                                : (Point3D){0.0f, 0.0f, 0.0f};
+
+  return retarget_skeleton_init_scaled(
+      &rig->bones, calibrated ? calibration : NULL, root_scale);
+}
+
+int skeleton_forward_kinematics(const SkeletonRig *rig,
+                                const SkeletonPose *skeleton,
+                                PoseData *out_pose) {
+  if (!rig || !skeleton || !out_pose) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  Point3D root = {
+      skeleton->root_position.x * rig->root_scale + rig->root_offset.x,
+      skeleton->root_position.y * rig->root_scale + rig->root_offset.y,
+      skeleton->root_position.z * rig->root_scale + rig->root_offset.z};
+
+  for (int b = 0; b < RETARGET_BONE_COUNT; b++) {
+    const RetargetBone *bone = &rig->bones.bones[b];
+    const Point3D *parent = (bone->parent == RETARGET_ROOT)
+                                ? &root
+                                : &out_pose->landmarks[bone->parent].position;
+    const Point3D *direction = &skeleton->directions[b];
+    float length = skeleton->lengths[b] * rig->bones.scales[b];
+
+    Point3D *child = &out_pose->landmarks[bone->child].position;
+    child->x = parent->x + direction->x * length;
+    child->y = parent->y + direction->y * length;
+    child->z = parent->z + direction->z * length;
+  }
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    out_pose->landmarks[i].inFrameLikelihood = skeleton->confidences[i];
+  }
+  out_pose->timestamp = skeleton->timestamp;
+
+  return SEGMENT_OK;
+}
+
+int skeleton_to_pose(const SkeletonPose *skeleton,
+                     const CalibrationData *calibration, PoseData *out_pose) {
+  if (!skeleton || !out_pose) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  SkeletonRig rig;
+  int result = skeleton_rig_init(&rig, calibration);
+  if (result != SEGMENT_OK) {
+    return result;
+  }
+
+  return skeleton_forward_kinematics(&rig, skeleton, out_pose);
+}
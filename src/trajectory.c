@@ -0,0 +1,107 @@
+/**
+ * @file trajectory.c
+ * @brief 가이드 애니메이션 궤적 생성 및 조회 구현
+ * @author Exercise Segment API Team
+ * @version 1.0.0
+ */
+
+#include "../include/trajectory.h"
+#include "../include/math_utils.h"
+
+// 균일 Catmull-Rom 곡선의 한 좌표 (p1 → p2 구간, u는 0~1)
+static float catmull_rom(float p0, float p1, float p2, float p3, float u,
+                         float u2, float u3) {
+  return 0.5f * (2.0f * p1 + (p2 - p0) * u +
+                 (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * u2 +
+                 (3.0f * (p1 - p2) + p3 - p0) * u3);
+}
+
+// p1 → p2 구간의 u 위치 포즈 (p0, p3는 접선용 이웃 키포즈)
+static void catmull_rom_pose(const PoseData *p0, const PoseData *p1,
+                             const PoseData *p2, const PoseData *p3, float u,
+                             PoseData *out_pose) {
+  float u2 = u * u;
+  float u3 = u2 * u;
+
+  for (int i = 0; i < POSE_LANDMARK_COUNT; i++) {
+    const Point3D *a = &p0->landmarks[i].position;
+    const Point3D *b = &p1->landmarks[i].position;
+    const Point3D *c = &p2->landmarks[i].position;
+    const Point3D *d = &p3->landmarks[i].position;
+    PoseLandmark *out = &out_pose->landmarks[i];
+
+    out->position.x = catmull_rom(a->x, b->x, c->x, d->x, u, u2, u3);
+    out->position.y = catmull_rom(a->y, b->y, c->y, d->y, u, u2, u3);
+    out->position.z = catmull_rom(a->z, b->z, c->z, d->z, u, u2, u3);
+
+    // 신뢰도는 곡선으로 보간하면 범위를 넘을 수 있으므로 선형 보간
+    float from = p1->landmarks[i].inFrameLikelihood;
+    float to = p2->landmarks[i].inFrameLikelihood;
+    out->inFrameLikelihood = from + (to - from) * u;
+  }
+
+  // 순서가 뒤바뀐 타임스탬프는 부호 없는 차이가 순환하므로 0으로 제한
+  uint64_t duration = (p2->timestamp > p1->timestamp)
+                          ? p2->timestamp - p1->timestamp
+                          : 0;
+  out_pose->timestamp = p1->timestamp + (uint64_t)(u * (float)duration);
+}
+
+int trajectory_build(PoseTrajectory *trajectory, const PoseData *keyposes,
+                     int keypose_count, int first, int last) {
+  if (!trajectory || !keyposes || first < 0 || last < first ||
+      last >= keypose_count) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  int span_count = last - first;
+  if (span_count == 0) {
+    for (int s = 0; s < TRAJECTORY_SAMPLE_COUNT; s++) {
+      trajectory->samples[s] = keyposes[first];
+    }
+    trajectory->ready = true;
+    return SEGMENT_OK;
+  }
+
+  for (int s = 0; s < TRAJECTORY_SAMPLE_COUNT; s++) {
+    // 전체 구간을 키포즈 구간 수로 균등 분할
+    float position =
+        (float)s * (float)span_count / (float)(TRAJECTORY_SAMPLE_COUNT - 1);
+    int span = (int)position;
+    if (span >= span_count) {
+      span = span_count - 1;
+    }
+    float u = position - (float)span;
+
+    int k1 = first + span;
+    int k2 = k1 + 1;
+    const PoseData *p1 = &keyposes[k1];
+    const PoseData *p2 = &keyposes[k2];
+    const PoseData *p0 = (k1 > 0) ? &keyposes[k1 - 1] : p1;
+    const PoseData *p3 = (k2 + 1 < keypose_count) ? &keyposes[k2 + 1] : p2;
+
+    catmull_rom_pose(p0, p1, p2, p3, u, &trajectory->samples[s]);
+  }
+
+  trajectory->ready = true;
+  return SEGMENT_OK;
+}
+
+int trajectory_sample(const PoseTrajectory *trajectory, float t,
+                      PoseData *out_pose) {
+  if (!trajectory || !out_pose || !trajectory->ready) {
+    return SEGMENT_ERROR_INVALID_PARAMETER;
+  }
+
+  // 표 조회: t가 속한 샘플 구간과 구간 내 비율
+  float position = clamp(t, 0.0f, 1.0f) * (TRAJECTORY_SAMPLE_COUNT - 1);
+  int index = (int)position;
+  if (index >= TRAJECTORY_SAMPLE_COUNT - 1) {
+    index = TRAJECTORY_SAMPLE_COUNT - 2;
+  }
+  float w = position - (float)index;
+
+  interpolate_pose_3d(&trajectory->samples[index],
+                      &trajectory->samples[index + 1], w, out_pose);
+  return SEGMENT_OK;
+}